@@ -71,7 +71,7 @@ public:
     {
         this->get_output()->set("value", value_);
 
-        this->process();
+        this->update();
     }
 
 };
@@ -151,7 +151,7 @@ public:
     {
         this->multiplier = value_;
 
-        this->process();
+        this->update();
     }
 
 private:
@@ -169,9 +169,6 @@ class HelloSink : public sb::AbstractSink
     SB_PROPERTIES({
         "text",
         &HelloSink::get_text
-    },{
-        "notifier",
-        &HelloSink::set_notifier
     })
 
     SB_INPUTS_FORMATS(
@@ -180,19 +177,6 @@ class HelloSink : public sb::AbstractSink
 
 public:
 
-    virtual
-    void
-    process
-    (
-    )
-    SB_OVERRIDE
-    {
-        if(notifier)
-        {
-            notifier();
-        }
-    }
-
     std::string
     get_text
     (
@@ -202,20 +186,6 @@ public:
         return this->lock_input()->get<std::string>("value");
     }
 
-    void
-    set_notifier
-    (
-        const std::function<void(void)>& value_
-    )
-    {
-        this->notifier = value_;
-    }
-
-private:
-
-    std::function<void(void)>
-    notifier;
-
 };
 
 SB_MODULE(hellobloks)
@@ -150,13 +150,40 @@ public:
                 );
             };
 
-        this->sink->set(
-            "notifier",
-            label_updater
+        // observe the filter, whose output is displayed by the sink
+
+        this->filter->subscribe(
+            [label_updater]
+            (
+                const sb::Event& event_
+            )
+            {
+                if(event_.type == sb::Event::Type::OUTPUT_UPDATED)
+                {
+                    label_updater();
+                }
+            }
         );
 
         label_updater();
 
+        // deliver the events in the GUI thread, without blocking the
+        // pipeline
+
+        QTimer* timer = new QTimer(label);
+
+        QObject::connect(
+            timer, &QTimer::timeout,
+            []
+            (
+            )
+            {
+                sb::dispatch_events();
+            }
+        );
+
+        timer->start(15);
+
         layout->addWidget(label, 1, Qt::AlignLeft | Qt::AlignVCenter);
 
         // create and return container
@@ -20,11 +20,30 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractblok.h>
 
+#include <atomic>
+
 #include <sb-core/sb-abstractdata.h>
+#include <sb-core/sb-memocache-private.h>
 
 namespace sb
 {
 
+// a follower moved to the outputs of another blok by a merge
+
+struct SB_DECL_HIDDEN MovedFollower
+{
+
+    Index
+    output_index;
+
+    AbstractBlok*
+    blok;
+
+    Index
+    input_index;
+
+};
+
 class SB_DECL_HIDDEN AbstractBlok::Private
 {
 
@@ -54,6 +73,153 @@ public:
     )
     const;
 
+    SharedData
+    lock_input
+    (
+        Index index_,
+        const Piece& piece_
+    )
+    const;
+
+    // returns true if the input index_ holds the piece piece_ of an output
+    // already computed by the running propagation: pulling it would only
+    // execute its source again
+
+    bool
+    is_input_up_to_date
+    (
+        Index index_,
+        const Piece& piece_
+    )
+    const;
+
+    // pulls the inputs indexes_ on the executor, unless they were pulled
+
+    SharedDataSequence
+    lock_inputs
+    (
+        const IndexSequence& indexes_
+    );
+
+    // gives the outputs the next sequence number and the current time if this
+    // blok has no inputs, the stamp of the first input otherwise
+
+    void
+    stamp_outputs
+    (
+    );
+
+    // returns true if the outputs of this blok lead to an active sink, or if
+    // they have no followers at all: their data may then be read directly
+
+    bool
+    is_demanded
+    (
+    );
+
+    // is_demanded() without locking
+
+    bool
+    compute_demand
+    (
+        Size epoch_
+    );
+
+    // updates effective_priority and effective_deadline, i.e. the highest
+    // priority and the shortest deadline of this blok and its downstream
+    // bloks; upstream bloks are thus never less urgent than their followers
+
+    void
+    update_urgency
+    (
+    );
+
+    // schedules the stale bloks upstream of this blok, this one included
+
+    void
+    catch_up
+    (
+    );
+
+    static
+    void
+    on_graph_changed
+    (
+    );
+
+    // returns a number changing each time the graph or a blok is modified
+
+    static
+    Size
+    get_change_epoch
+    (
+    );
+
+    // returns true if this blok and other_ have the same effective priority
+    // and deadline
+
+    bool
+    is_as_urgent
+    (
+        Private* other_
+    );
+
+    // update_urgency() without locking
+
+    void
+    compute_urgency
+    (
+        Size epoch_
+    );
+
+    // serializes the properties of this blok; returns false if some can't
+    // be serialized
+
+    bool
+    write_properties
+    (
+        std::vector<char>& buffer_
+    )
+    const;
+
+    bool
+    is_identical
+    (
+        const AbstractBlok* other_
+    )
+    const;
+
+    void
+    merge_into
+    (
+        AbstractBlok* blok_
+    );
+
+    // connects back the followers moved by merge_into()
+
+    void
+    split
+    (
+    );
+
+    // splits the merged bloks whose properties differ from this blok's
+
+    void
+    split_diverging
+    (
+    );
+
+    // returns false if this blok can't be memoized; is_persistent_ tells
+    // if key_ identifies the same execution in another process
+
+    bool
+    get_memo_key
+    (
+        MemoKey& key_,
+        bool& is_persistent_
+    )
+    const;
+
     bool
     set_input
     (
@@ -92,6 +258,12 @@ public:
     std::vector<WeakData>
     inputs;
 
+    std::vector<EdgePolicy>
+    input_policies;
+
+    std::vector<EdgeStatistics>
+    input_statistics;
+
     ObjectFormatSequence
     outputs_formats;
 
@@ -101,6 +273,82 @@ public:
     UniqueExecutive
     executive;
 
+    Piece
+    requested_piece;
+
+    bool
+    memoized;
+
+    bool
+    inputs_pulled;
+
+    // a blok is inactive if it is a sink nobody reads
+
+    bool
+    active;
+
+    // a stale blok missed an update while it wasn't demanded
+
+    bool
+    stale;
+
+    // set once the blok executed, with the versions of its inputs at that
+    // time
+
+    bool
+    is_executed;
+
+    std::vector<Size>
+    executed_input_versions;
+
+    // set by an executive running this blok in another thread, once the
+    // item being processed is superseded
+
+    std::atomic<bool>
+    cancellation_requested;
+
+    // is_demanded() result, cached for the graph epoch demand_epoch under
+    // the urgency mutex
+
+    bool
+    demanded;
+
+    Size
+    demand_epoch;
+
+    int
+    priority;
+
+    Size
+    deadline;
+
+    // update_urgency() results, cached for the graph epoch urgency_epoch
+
+    int
+    effective_priority;
+
+    Size
+    effective_deadline;
+
+    Size
+    urgency_epoch;
+
+    std::string
+    scheduling_group;
+
+    // blok this blok was merged into
+
+    AbstractBlok*
+    merged_into;
+
+    // bloks merged into this blok
+
+    std::vector<AbstractBlok*>
+    merged_bloks;
+
+    std::vector<MovedFollower>
+    moved_followers;
+
 };
 
 }
@@ -20,10 +20,48 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 #include <sb-core/sb-abstractblok-private.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
 
 #include <sb-core/sb-abstractdata-private.h>
 #include <sb-core/sb-abstractexecutive-private.h>
+#include <sb-core/sb-abstractobject-private.h>
+#include <sb-core/sb-executor-private.h>
+#include <sb-core/sb-propagation-private.h>
+#include <sb-core/sb-propertytransaction-private.h>
 #include <sb-core/sb-executive.h>
+#include <sb-core/sb-serialization.h>
+#include <sb-core/sb-serialization-private.h>
+
+namespace sb
+{
+
+namespace Global
+{
+
+// incremented each time the graph changes, invalidating the cached demands
+// and urgencies
+
+std::atomic<Size>
+graph_epoch(1);
+
+// incremented each time a blok is modified
+
+std::atomic<Size>
+modification_epoch(0);
+
+// guards the cached demands and urgencies, updated by the threads pushing
+// and pulling inputs
+
+std::mutex
+urgency_mutex;
+
+}
+
+}
 
 using namespace sb;
 
@@ -44,6 +82,32 @@ AbstractBlok::~AbstractBlok
 (
 )
 {
+    PropertyTransaction::Private::on_destroyed(this);
+    Propagation::on_destroyed(this);
+
+    // the followers moved to this blok go back to the bloks merged into it
+
+    if(d_ptr->merged_into)
+    {
+        auto& merged_bloks = Private::from(d_ptr->merged_into)->merged_bloks;
+
+        merged_bloks.erase(
+            std::remove(merged_bloks.begin(), merged_bloks.end(), this),
+            merged_bloks.end()
+        );
+    }
+
+    std::vector<AbstractBlok*> merged_bloks = d_ptr->merged_bloks;
+
+    for(auto merged_blok : merged_bloks)
+    {
+        Private::from(merged_blok)->split();
+
+        merged_blok->update();
+    }
+
+    Private::on_graph_changed();
+
     for(Index i = 0; i < d_ptr->inputs.size(); ++i)
     {
         d_ptr->unlink_input(i);
@@ -56,177 +120,1204 @@ AbstractBlok::~AbstractBlok
         )->source_blok = SB_NULLPTR;
     }
 
-    // d_ptr->executive points to this blok:
-    // ensure it is destroyed first
+    // d_ptr->executive points to this blok:
+    // ensure it is destroyed first
+
+    d_ptr->executive.reset();
+
+    delete d_ptr;
+}
+
+Size
+AbstractBlok::get_input_count
+(
+)
+const
+{
+    return d_ptr->inputs.size();
+}
+
+Size
+AbstractBlok::get_output_count
+(
+)
+const
+{
+    return d_ptr->outputs.size();
+}
+
+void
+AbstractBlok::use_executive
+(
+    const std::string& name_
+)
+{
+    d_ptr->executive = create_unique_executive(name_);
+
+    if(!d_ptr->executive)
+    {
+        throw std::invalid_argument(
+            "fatal: AbstractBlok::use_executive(invalid executive name)"
+        );
+    }
+
+    AbstractExecutive::Private::from(
+        d_ptr->executive
+    )->blok = this;
+}
+
+void
+AbstractBlok::pull_input
+(
+    Index index_
+)
+{
+    this->pull_input(
+        index_,
+        d_ptr->requested_piece
+    );
+}
+
+void
+AbstractBlok::pull_input
+(
+    Index index_,
+    const Piece& piece_
+)
+{
+    // AbstractBlok::Private::lock_input calls this method:
+    // don't call it here or it will cause infinite recursion
+
+    if(d_ptr->is_input_up_to_date(index_, piece_))
+    {
+        return;
+    }
+
+    auto input = d_ptr->inputs.at(index_).lock();
+
+    auto input_d_ptr = input ? AbstractData::Private::from(input) : SB_NULLPTR;
+
+    // inputs set directly have no source to pull
+
+    if(input_d_ptr && input_d_ptr->source_blok)
+    {
+        auto source_d_ptr = AbstractBlok::Private::from(
+            input_d_ptr->source_blok
+        );
+
+        // concurrent pulls of the same blok are served one after the other
+
+        std::lock_guard<std::recursive_mutex> lock(
+            AbstractExecutive::Private::from(
+                source_d_ptr->executive
+            )->execution_mutex
+        );
+
+        source_d_ptr->requested_piece = piece_;
+
+        source_d_ptr->executive->on_output_pulled(
+            input_d_ptr->source_index
+        );
+
+        // the first input may hold a new item since the outputs were stamped
+
+        if(index_ == 0)
+        {
+            d_ptr->stamp_outputs();
+        }
+    }
+}
+
+void
+AbstractBlok::push_output
+(
+    Index index_
+)
+{
+    this->push_output(
+        index_,
+        d_ptr->requested_piece
+    );
+}
+
+void
+AbstractBlok::push_output
+(
+    Index index_,
+    const Piece& piece_
+)
+{
+    auto output_d_ptr = AbstractData::Private::from(
+        d_ptr->outputs.at(index_)
+    );
+
+    output_d_ptr->piece = piece_;
+
+    // followers already hold this content: nothing downstream is dirty.
+    // Data that never update their version are always pushed
+
+    if(
+        output_d_ptr->is_versioned &&
+        output_d_ptr->pushed_version == output_d_ptr->version &&
+        output_d_ptr->pushed_piece == piece_
+    )
+    {
+        return;
+    }
+
+    output_d_ptr->pushed_version = output_d_ptr->version;
+    output_d_ptr->pushed_piece = piece_;
+
+    for(auto follower : output_d_ptr->followers)
+    {
+        auto follower_d_ptr = AbstractBlok::Private::from(
+            Unmapper::blok(follower)
+        );
+
+        ++follower_d_ptr->input_statistics[
+            Unmapper::input_index(follower)
+        ].pushed_count;
+
+        follower_d_ptr->requested_piece = piece_;
+
+        if(!follower_d_ptr->is_demanded())
+        {
+            // the follower will catch up once a sink reads it again
+
+            follower_d_ptr->stale = true;
+        }
+        else if(piece_ == WHOLE_PIECE)
+        {
+            Propagation::schedule_pushed(
+                Unmapper::blok(follower),
+                Unmapper::input_index(follower),
+                // a chained follower is visited before the other scheduled
+                // bloks, which must not be more urgent
+
+                output_d_ptr->followers.size() == 1 &&
+                    follower_d_ptr->inputs.size() == 1 &&
+                    d_ptr->is_as_urgent(follower_d_ptr)
+            );
+        }
+        else
+        {
+            // a streamed piece is processed before the next one overwrites
+            // the output
+
+            follower_d_ptr->executive->on_input_pushed(
+                Unmapper::input_index(follower)
+            );
+        }
+    }
+
+    Propagation::run();
+}
+
+Piece
+AbstractBlok::get_requested_piece
+(
+)
+const
+{
+    return d_ptr->requested_piece;
+}
+
+bool
+AbstractBlok::is_cancellation_requested
+(
+)
+const
+{
+    return d_ptr->cancellation_requested.load(std::memory_order_relaxed);
+}
+
+Size
+AbstractBlok::get_input_extent
+(
+    Index index_
+)
+const
+{
+    Size extent = UNKNOWN_EXTENT;
+
+    auto input = d_ptr->inputs.at(index_).lock();
+
+    if(input)
+    {
+        extent = input->get_extent();
+    }
+
+    return extent;
+}
+
+void
+AbstractBlok::set_output_extent
+(
+    Index index_,
+    Size value_
+)
+{
+    AbstractData::Private::from(
+        d_ptr->outputs.at(index_)
+    )->extent = value_;
+}
+
+void
+AbstractBlok::set_output_sequence
+(
+    Index index_,
+    Size value_
+)
+{
+    AbstractData::Private::from(
+        d_ptr->outputs.at(index_)
+    )->sequence = value_;
+}
+
+void
+AbstractBlok::set_output_timestamp
+(
+    Index index_,
+    const Timestamp& value_
+)
+{
+    AbstractData::Private::from(
+        d_ptr->outputs.at(index_)
+    )->timestamp = value_;
+}
+
+void
+AbstractBlok::update
+(
+)
+{
+    ++Global::modification_epoch;
+
+    if(d_ptr->merged_into)
+    {
+        if(d_ptr->is_identical(d_ptr->merged_into))
+        {
+            // the blok this blok was merged into still executes for it
+
+            return;
+        }
+
+        d_ptr->split();
+    }
+
+    d_ptr->split_diverging();
+
+    if(!PropertyTransaction::Private::defer_update(this))
+    {
+        Propagation::schedule_modified(this);
+        Propagation::run();
+    }
+}
+
+void
+AbstractBlok::set_memoized
+(
+    bool value_
+)
+{
+    d_ptr->memoized = value_;
+}
+
+bool
+AbstractBlok::is_memoized
+(
+)
+const
+{
+    return d_ptr->memoized;
+}
+
+bool
+AbstractBlok::is_merged
+(
+)
+const
+{
+    return d_ptr->merged_into != SB_NULLPTR;
+}
+
+void
+AbstractBlok::set_priority
+(
+    int value_
+)
+{
+    if(d_ptr->priority != value_)
+    {
+        d_ptr->priority = value_;
+
+        Private::on_graph_changed();
+    }
+}
+
+int
+AbstractBlok::get_priority
+(
+)
+const
+{
+    return d_ptr->priority;
+}
+
+void
+AbstractBlok::set_deadline
+(
+    Size value_
+)
+{
+    if(d_ptr->deadline != value_)
+    {
+        d_ptr->deadline = value_;
+
+        Private::on_graph_changed();
+    }
+}
+
+Size
+AbstractBlok::get_deadline
+(
+)
+const
+{
+    return d_ptr->deadline;
+}
+
+void
+AbstractBlok::set_scheduling_group
+(
+    const std::string& value_
+)
+{
+    d_ptr->scheduling_group = value_;
+}
+
+std::string
+AbstractBlok::get_scheduling_group
+(
+)
+const
+{
+    return d_ptr->scheduling_group;
+}
+
+void
+AbstractBlok::set_input_policy
+(
+    Index index_,
+    const EdgePolicy& value_
+)
+{
+    d_ptr->input_policies.at(index_) = value_;
+}
+
+EdgePolicy
+AbstractBlok::get_input_policy
+(
+    Index index_
+)
+const
+{
+    return d_ptr->input_policies.at(index_);
+}
+
+EdgeStatistics
+AbstractBlok::get_input_statistics
+(
+    Index index_
+)
+const
+{
+    return d_ptr->input_statistics.at(index_);
+}
+
+void
+AbstractBlok::process_batch
+(
+    const DataBatch& items_
+)
+{
+    std::vector<WeakData> inputs = d_ptr->inputs;
+
+    try
+    {
+        for(const auto& item : items_)
+        {
+            for(Index i = 0; i < d_ptr->inputs.size() && i < item.size(); ++i)
+            {
+                d_ptr->inputs[i] = item[i];
+            }
+
+            d_ptr->stamp_outputs();
+
+            this->process();
+        }
+    }
+    catch(...)
+    {
+        d_ptr->inputs = inputs;
+
+        throw;
+    }
+
+    d_ptr->inputs = inputs;
+}
+
+void
+AbstractBlok::process_async
+(
+    const AsyncCompletion& completion_
+)
+{
+    this->process();
+
+    completion_(SB_NULLPTR);
+}
+
+AbstractExecutive*
+AbstractBlok::get_executive
+(
+)
+const
+{
+    return d_ptr->executive.get();
+}
+
+void
+AbstractBlok::init
+(
+    AbstractBlok* this_,
+    const ObjectFormatSequence& inputs_formats_,
+    const StringSequence& output_type_names_
+)
+{
+    auto d_ptr = AbstractBlok::Private::from(
+        this_
+    );
+
+    d_ptr->set_inputs_formats(
+        inputs_formats_
+    );
+    d_ptr->set_outputs_type_names(
+        output_type_names_
+    );
+}
+
+AbstractBlok::Private::Private
+(
+    AbstractBlok* q_ptr_
+):
+    q_ptr                  (q_ptr_),
+    requested_piece        (WHOLE_PIECE),
+    memoized               (false),
+    inputs_pulled          (false),
+    active                 (true),
+    stale                  (false),
+    is_executed            (false),
+    cancellation_requested (false),
+    demanded               (true),
+    demand_epoch           (0),
+    priority               (DEFAULT_PRIORITY),
+    deadline               (NO_DEADLINE),
+    effective_priority     (DEFAULT_PRIORITY),
+    effective_deadline     (NO_DEADLINE),
+    urgency_epoch          (0),
+    merged_into            (SB_NULLPTR)
+{
+}
+
+void
+AbstractBlok::Private::set_inputs_formats
+(
+    const ObjectFormatSequence& value_
+)
+{
+    this->inputs_formats = value_;
+
+    this->inputs.resize(
+        this->inputs_formats.size()
+    );
+    this->input_policies.resize(
+        this->inputs_formats.size(),
+        DEFAULT_EDGE_POLICY
+    );
+    this->input_statistics.resize(
+        this->inputs_formats.size(),
+        EdgeStatistics{0, 0, 0}
+    );
+}
+
+void
+AbstractBlok::Private::set_outputs_type_names
+(
+    const StringSequence& value_
+)
+{
+    this->outputs_formats.resize(
+        value_.size()
+    );
+    this->outputs.resize(
+        value_.size()
+    );
+
+    for(Index i(0); i < value_.size(); ++i)
+    {
+        this->outputs_formats[i] = get_object_format(
+            value_[i]
+        );
+
+        SharedData data = create_shared_data(
+            value_[i]
+        );
+
+        auto data_d_ptr = AbstractData::Private::from(
+            data
+        );
+
+        data_d_ptr->source_blok = q_ptr;
+        data_d_ptr->source_index = i;
+
+        this->outputs[i] = data;
+    }
+}
+
+SharedData
+AbstractBlok::Private::lock_input
+(
+    Index index_
+)
+const
+{
+    if(!this->inputs_pulled)
+    {
+        q_ptr->pull_input(index_);
+    }
+
+    return this->inputs.at(index_).lock();
+}
+
+SharedData
+AbstractBlok::Private::lock_input
+(
+    Index index_,
+    const Piece& piece_
+)
+const
+{
+    if(!this->inputs_pulled || piece_ != this->requested_piece)
+    {
+        q_ptr->pull_input(index_, piece_);
+    }
+
+    return this->inputs.at(index_).lock();
+}
+
+bool
+AbstractBlok::Private::is_input_up_to_date
+(
+    Index index_,
+    const Piece& piece_
+)
+const
+{
+    auto input = this->inputs.at(index_).lock();
+
+    if(!input)
+    {
+        return false;
+    }
+
+    auto input_d_ptr = AbstractData::Private::from(input);
+
+    AbstractBlok* source = input_d_ptr->source_blok;
+
+    return (
+        source &&
+        input_d_ptr->piece == piece_ &&
+        Propagation::is_up_to_date(source)
+    );
+}
+
+SharedDataSequence
+AbstractBlok::Private::lock_inputs
+(
+    const IndexSequence& indexes_
+)
+{
+    if(!this->inputs_pulled)
+    {
+        std::vector<std::function<void()>> pulls;
+
+        for(auto index : indexes_)
+        {
+            // report invalid indexes on the calling thread, where the
+            // running propagation is known
+
+            this->inputs.at(index);
+
+            if(this->is_input_up_to_date(index, this->requested_piece))
+            {
+                continue;
+            }
+
+            pulls.push_back(
+                [this, index]()
+                {
+                    q_ptr->pull_input(index);
+                }
+            );
+        }
+
+        // more urgent bloks get the threads of the pool first
+
+        this->update_urgency();
+
+        Executor::run_all(
+            std::move(pulls),
+            this->effective_priority,
+            this->effective_deadline,
+            this->scheduling_group
+        );
+    }
+
+    SharedDataSequence inputs;
+
+    for(auto index : indexes_)
+    {
+        inputs.push_back(this->inputs[index].lock());
+    }
+
+    return inputs;
+}
+
+void
+AbstractBlok::Private::stamp_outputs
+(
+)
+{
+    Size sequence = 0;
+    Timestamp timestamp = UNKNOWN_TIMESTAMP;
+
+    if(this->inputs.empty())
+    {
+        timestamp = std::chrono::steady_clock::now();
+    }
+    else
+    {
+        auto input = this->inputs[0].lock();
+
+        if(!input)
+        {
+            return;
+        }
+
+        sequence = input->get_sequence();
+        timestamp = input->get_timestamp();
+    }
+
+    for(auto output : this->outputs)
+    {
+        auto output_d_ptr = AbstractData::Private::from(output);
+
+        // each execution of a source publishes a new item
+
+        output_d_ptr->sequence = (
+            this->inputs.empty() ? output_d_ptr->sequence + 1 : sequence
+        );
+        output_d_ptr->timestamp = timestamp;
+    }
+}
+
+bool
+AbstractBlok::Private::is_demanded
+(
+)
+{
+    std::lock_guard<std::mutex> lock(Global::urgency_mutex);
+
+    return this->compute_demand(
+        Global::graph_epoch.load(std::memory_order_relaxed)
+    );
+}
+
+bool
+AbstractBlok::Private::compute_demand
+(
+    Size epoch_
+)
+{
+    if(this->demand_epoch != epoch_)
+    {
+        // cache a result before visiting the followers, so that a cycle ends
+
+        this->demand_epoch = epoch_;
+        this->demanded = this->active && !this->merged_into;
+
+        if(this->demanded)
+        {
+            bool has_followers = false;
+            bool is_followed_on_demand = false;
+
+            for(const auto& output : this->outputs)
+            {
+                for(
+                    const auto& follower :
+                    AbstractData::Private::from(output)->followers
+                )
+                {
+                    has_followers = true;
+
+                    is_followed_on_demand = is_followed_on_demand ||
+                        AbstractBlok::Private::from(
+                            Unmapper::blok(follower)
+                        )->compute_demand(epoch_);
+                }
+            }
+
+            this->demanded = !has_followers || is_followed_on_demand;
+        }
+    }
+
+    return this->demanded;
+}
+
+void
+AbstractBlok::Private::update_urgency
+(
+)
+{
+    std::lock_guard<std::mutex> lock(Global::urgency_mutex);
+
+    this->compute_urgency(
+        Global::graph_epoch.load(std::memory_order_relaxed)
+    );
+}
+
+bool
+AbstractBlok::Private::is_as_urgent
+(
+    Private* other_
+)
+{
+    this->update_urgency();
+    other_->update_urgency();
+
+    return (
+        this->effective_priority == other_->effective_priority &&
+        this->effective_deadline == other_->effective_deadline
+    );
+}
+
+void
+AbstractBlok::Private::compute_urgency
+(
+    Size epoch_
+)
+{
+    if(this->urgency_epoch == epoch_)
+    {
+        return;
+    }
+
+    // cache a result before visiting the followers, so that a cycle ends
+
+    this->urgency_epoch = epoch_;
+    this->effective_priority = this->priority;
+    this->effective_deadline = this->deadline;
+
+    for(const auto& output : this->outputs)
+    {
+        for(
+            const auto& follower :
+            AbstractData::Private::from(output)->followers
+        )
+        {
+            auto follower_d_ptr = AbstractBlok::Private::from(
+                Unmapper::blok(follower)
+            );
+
+            follower_d_ptr->compute_urgency(epoch_);
+
+            this->effective_priority = std::max(
+                this->effective_priority,
+                follower_d_ptr->effective_priority
+            );
+            this->effective_deadline = std::min(
+                this->effective_deadline,
+                follower_d_ptr->effective_deadline
+            );
+        }
+    }
+}
+
+void
+AbstractBlok::Private::catch_up
+(
+)
+{
+    std::set<AbstractBlok*> visited_bloks;
+
+    std::vector<AbstractBlok*> bloks_to_visit = {q_ptr};
+
+    while(!bloks_to_visit.empty())
+    {
+        AbstractBlok* blok = bloks_to_visit.back();
+
+        bloks_to_visit.pop_back();
+
+        if(!visited_bloks.insert(blok).second)
+        {
+            continue;
+        }
+
+        auto blok_d_ptr = AbstractBlok::Private::from(blok);
+
+        if(blok_d_ptr->stale)
+        {
+            blok_d_ptr->stale = false;
+
+            Propagation::schedule_modified(blok);
+        }
+
+        for(const auto& weak_input : blok_d_ptr->inputs)
+        {
+            auto input = weak_input.lock();
 
-    d_ptr->executive.reset();
+            AbstractBlok* source = input ?
+                AbstractData::Private::from(input)->source_blok :
+                SB_NULLPTR;
 
-    delete d_ptr;
+            if(source)
+            {
+                bloks_to_visit.push_back(source);
+            }
+        }
+    }
+
+    Propagation::run();
 }
 
-Size
-AbstractBlok::get_input_count
+void
+AbstractBlok::Private::on_graph_changed
 (
 )
-const
 {
-    return d_ptr->inputs.size();
+    ++Global::graph_epoch;
 }
 
 Size
-AbstractBlok::get_output_count
+AbstractBlok::Private::get_change_epoch
 (
 )
-const
 {
-    return d_ptr->outputs.size();
+    // both counters only increase: their sum changes with either of them
+
+    return Global::graph_epoch + Global::modification_epoch;
 }
 
-void
-AbstractBlok::use_executive
+bool
+AbstractBlok::Private::write_properties
 (
-    const std::string& name_
+    std::vector<char>& buffer_
 )
+const
 {
-    d_ptr->executive = create_unique_executive(name_);
+    Writer writer;
 
-    if(!d_ptr->executive)
-    {
-        throw std::invalid_argument(
-            "fatal: AbstractBlok::use_executive(invalid executive name)"
-        );
-    }
+    bool complete = serialize(*q_ptr, writer);
 
-    AbstractExecutive::Private::from(
-        d_ptr->executive
-    )->blok = this;
+    buffer_ = writer.get_buffer();
+
+    return complete;
 }
 
-void
-AbstractBlok::pull_input
+bool
+AbstractBlok::Private::is_identical
 (
-    Index index_
+    const AbstractBlok* other_
 )
+const
 {
-    // AbstractBlok::Private::lock_input calls this method:
-    // don't call it here or it will cause infinite recursion
+    auto other_d_ptr = AbstractBlok::Private::from(other_);
 
-    auto input_d_ptr = AbstractData::Private::from(
-        d_ptr->inputs.at(index_).lock()
-    );
+    if(
+        q_ptr->get_format().type_names[0] !=
+            other_->get_format().type_names[0] ||
+        this->inputs.size() != other_d_ptr->inputs.size() ||
+        this->outputs.size() != other_d_ptr->outputs.size()
+    )
+    {
+        return false;
+    }
 
-    AbstractBlok::Private::from(
-        input_d_ptr->source_blok
-    )->executive->on_output_pulled(
-        input_d_ptr->source_index
-    );
+    // identical bloks read the same data
+
+    for(Index i = 0; i < this->inputs.size(); ++i)
+    {
+        auto input = this->inputs[i].lock();
+
+        if(!input || input != other_d_ptr->inputs[i].lock())
+        {
+            return false;
+        }
+    }
+
+    std::vector<char> properties;
+    std::vector<char> other_properties;
+
+    return
+        this->write_properties(properties) &&
+        other_d_ptr->write_properties(other_properties) &&
+        properties == other_properties;
 }
 
 void
-AbstractBlok::push_output
+AbstractBlok::Private::merge_into
 (
-    Index index_
+    AbstractBlok* blok_
 )
 {
-    auto output_d_ptr = AbstractData::Private::from(
-        d_ptr->outputs.at(index_)
-    );
+    auto blok_d_ptr = AbstractBlok::Private::from(blok_);
 
-    for(auto follower : output_d_ptr->followers)
+    for(Index i = 0; i < this->outputs.size(); ++i)
     {
-        AbstractBlok::Private::from(
-            Unmapper::blok(follower)
-        )->executive->on_input_pushed(
-            Unmapper::input_index(follower)
-        );
+        // copy the followers: connecting them elsewhere alters the collection
+
+        FollowerCollection followers = AbstractData::Private::from(
+            this->outputs[i]
+        )->followers;
+
+        for(const auto& follower : followers)
+        {
+            this->moved_followers.push_back(
+                MovedFollower{
+                    i,
+                    Unmapper::blok(follower),
+                    Unmapper::input_index(follower)
+                }
+            );
+
+            AbstractBlok::Private::from(
+                Unmapper::blok(follower)
+            )->set_input(
+                Unmapper::input_index(follower),
+                blok_d_ptr->outputs[i]
+            );
+        }
     }
-}
 
-void
-AbstractBlok::init
-(
-    AbstractBlok* this_,
-    const ObjectFormatSequence& inputs_formats_,
-    const StringSequence& output_type_names_
-)
-{
-    auto d_ptr = AbstractBlok::Private::from(
-        this_
-    );
+    this->merged_into = blok_;
 
-    d_ptr->set_inputs_formats(
-        inputs_formats_
-    );
-    d_ptr->set_outputs_type_names(
-        output_type_names_
-    );
-}
+    blok_d_ptr->merged_bloks.push_back(q_ptr);
 
-AbstractBlok::Private::Private
-(
-    AbstractBlok* q_ptr_
-):
-    q_ptr(q_ptr_)
-{
+    on_graph_changed();
 }
 
 void
-AbstractBlok::Private::set_inputs_formats
+AbstractBlok::Private::split
 (
-    const ObjectFormatSequence& value_
 )
 {
-    this->inputs_formats = value_;
+    auto blok_d_ptr = AbstractBlok::Private::from(this->merged_into);
 
-    this->inputs.resize(
-        this->inputs_formats.size()
+    // this blok is no longer merged: the followers connected back to it
+    // must not be redirected to blok_d_ptr
+
+    std::vector<MovedFollower> moved_followers;
+
+    moved_followers.swap(this->moved_followers);
+
+    blok_d_ptr->merged_bloks.erase(
+        std::remove(
+            blok_d_ptr->merged_bloks.begin(),
+            blok_d_ptr->merged_bloks.end(),
+            q_ptr
+        ),
+        blok_d_ptr->merged_bloks.end()
     );
+
+    this->merged_into = SB_NULLPTR;
+
+    for(const auto& moved_follower : moved_followers)
+    {
+        // skip the followers connected elsewhere, or destroyed, since the
+        // merge
+
+        auto& followers = AbstractData::Private::from(
+            blok_d_ptr->outputs[moved_follower.output_index]
+        )->followers;
+
+        auto candidates = followers.equal_range(moved_follower.blok);
+
+        bool is_connected = false;
+
+        for(
+            auto candidate = candidates.first;
+            candidate != candidates.second;
+            ++candidate
+        )
+        {
+            is_connected = is_connected || (
+                Unmapper::input_index(*candidate) ==
+                    moved_follower.input_index
+            );
+        }
+
+        if(is_connected)
+        {
+            AbstractBlok::Private::from(
+                moved_follower.blok
+            )->set_input(
+                moved_follower.input_index,
+                this->outputs[moved_follower.output_index]
+            );
+        }
+    }
+
+    on_graph_changed();
 }
 
 void
-AbstractBlok::Private::set_outputs_type_names
+AbstractBlok::Private::split_diverging
 (
-    const StringSequence& value_
 )
 {
-    this->outputs_formats.resize(
-        value_.size()
-    );
-    this->outputs.resize(
-        value_.size()
-    );
+    // splitting alters the collection
 
-    for(Index i(0); i < value_.size(); ++i)
-    {
-        this->outputs_formats[i] = get_object_format(
-            value_[i]
-        );
+    std::vector<AbstractBlok*> merged_bloks = this->merged_bloks;
 
-        SharedData data = create_shared_data(
-            value_[i]
-        );
+    for(auto merged_blok : merged_bloks)
+    {
+        auto merged_d_ptr = AbstractBlok::Private::from(merged_blok);
 
-        auto data_d_ptr = AbstractData::Private::from(
-            data
-        );
+        if(!merged_d_ptr->is_identical(q_ptr))
+        {
+            merged_d_ptr->split();
 
-        data_d_ptr->source_blok = q_ptr;
-        data_d_ptr->source_index = i;
+            // the outputs of the merged blok weren't updated since the merge
 
-        this->outputs[i] = data;
+            merged_blok->update();
+        }
     }
 }
 
-SharedData
-AbstractBlok::Private::lock_input
+bool
+AbstractBlok::Private::get_memo_key
 (
-    Index index_
+    MemoKey& key_,
+    bool& is_persistent_
 )
 const
 {
-    q_ptr->pull_input(index_);
+    is_persistent_ = true;
 
-    return this->inputs.at(index_).lock();
+    // each value of the key material can be read back, knowing the values
+    // before it: different executions never write the same material
+
+    Writer writer;
+
+    writer.write_string(q_ptr->get_format().type_names[0]);
+
+    // write the readable properties
+
+    auto object_d_ptr = AbstractObject::Private::from(q_ptr);
+
+    for(const auto& name_property : *object_d_ptr->properties)
+    {
+        const ObjectProperty& property = name_property.second;
+
+        if(
+            bitmask(
+                property.access_rights
+            ).is_set(
+                AccessRights::READ
+            )
+        )
+        {
+            const Codec* codec = CodecRegistry::find(property.type);
+
+            if(!codec)
+            {
+                return false;
+            }
+
+            writer.write_string(name_property.first);
+
+            codec->encode(property.get(*q_ptr), writer);
+        }
+    }
+
+    // write the inputs: data produced by a memoized execution are identified
+    // by its key, others by their serialized content; versions only make
+    // sense in this process, so keys using them are not persistent
+
+    for(const auto& weak_input : this->inputs)
+    {
+        auto input = weak_input.lock();
+
+        if(!input)
+        {
+            return false;
+        }
+
+        auto input_d_ptr = AbstractData::Private::from(input);
+
+        if(input_d_ptr->content_key)
+        {
+            const std::vector<char>& content_key = *input_d_ptr->content_key;
+
+            writer.write_value(std::uint8_t(0));
+
+            writer.write_value(
+                static_cast<std::uint64_t>(content_key.size())
+            );
+            writer.write(content_key.data(), content_key.size());
+
+            writer.write_value(
+                static_cast<std::uint64_t>(input_d_ptr->content_index)
+            );
+        }
+        else
+        {
+            writer.write_value(std::uint8_t(1));
+
+            // the serialized content is hashed in place with the rest of
+            // the material
+
+            if(!serialize(*input, writer))
+            {
+                writer.write_value(
+                    static_cast<std::uint64_t>(input_d_ptr->version)
+                );
+
+                is_persistent_ = false;
+            }
+        }
+
+        writer.write_value(
+            static_cast<std::uint64_t>(input_d_ptr->piece.offset)
+        );
+        writer.write_value(
+            static_cast<std::uint64_t>(input_d_ptr->piece.size)
+        );
+    }
+
+    writer.write_value(
+        static_cast<std::uint64_t>(this->requested_piece.offset)
+    );
+    writer.write_value(
+        static_cast<std::uint64_t>(this->requested_piece.size)
+    );
+
+    key_ = MemoCache::make_key(
+        std::move(Writer::Private::from(&writer)->buffer)
+    );
+
+    return true;
 }
 
 bool
@@ -247,20 +1338,67 @@ AbstractBlok::Private::set_input
     {
         ok = true;
 
+        SharedData value = value_;
+
+        // a follower connected to a merged blok reads the blok executing for
+        // it, until they are split
+
+        if(value)
+        {
+            auto value_d_ptr = AbstractData::Private::from(value);
+
+            AbstractBlok* source = value_d_ptr->source_blok;
+
+            if(source && AbstractBlok::Private::from(source)->merged_into)
+            {
+                auto source_d_ptr = AbstractBlok::Private::from(source);
+
+                source_d_ptr->moved_followers.push_back(
+                    MovedFollower{value_d_ptr->source_index, q_ptr, index_}
+                );
+
+                value = AbstractBlok::Private::from(
+                    source_d_ptr->merged_into
+                )->outputs[value_d_ptr->source_index];
+            }
+        }
+
         this->unlink_input(index_);
 
-        this->inputs[index_] = value_;
+        on_graph_changed();
 
-        if(value_)
+        this->inputs[index_] = value;
+
+        if(value)
         {
             // register this blok as a follower
 
-            AbstractData::Private::from(
-                value_
-            )->followers.emplace(
+            auto value_d_ptr = AbstractData::Private::from(
+                value
+            );
+
+            value_d_ptr->followers.emplace(
                 q_ptr, index_
             );
+
+            // the new follower never received the content: the next push
+            // must reach it
+
+            value_d_ptr->pushed_version = 0;
+        }
+
+        // merges don't hold once identical bloks read different data
+
+        if(this->merged_into && !this->is_identical(this->merged_into))
+        {
+            this->split();
+
+            // the outputs of this blok weren't updated since the merge
+
+            q_ptr->update();
         }
+
+        this->split_diverging();
     }
 
     return ok;
@@ -341,3 +1479,59 @@ sb::connect
             ]
         );
 }
+
+Size
+sb::merge_identical_bloks
+(
+    const std::vector<AbstractBlok*>& bloks_
+)
+{
+    Size merged_count = 0;
+
+    // bloks already merged, or leading a merge, keep their role
+
+    std::vector<AbstractBlok*> leaders;
+
+    for(auto blok : bloks_)
+    {
+        if(!blok)
+        {
+            continue;
+        }
+
+        auto blok_d_ptr = AbstractBlok::Private::from(blok);
+
+        if(blok_d_ptr->merged_into)
+        {
+            continue;
+        }
+
+        auto found_leader = blok_d_ptr->merged_bloks.empty() ? std::find_if(
+            leaders.begin(),
+            leaders.end(),
+            [blok_d_ptr]
+            (
+                AbstractBlok* leader_
+            )
+            {
+                return leader_ != blok_d_ptr->q_ptr &&
+                    blok_d_ptr->is_identical(leader_);
+            }
+        ) : leaders.end();
+
+        if(found_leader != leaders.end())
+        {
+            blok_d_ptr->merge_into(*found_leader);
+
+            ++merged_count;
+        }
+        else if(
+            std::find(leaders.begin(), leaders.end(), blok) == leaders.end()
+        )
+        {
+            leaders.push_back(blok);
+        }
+    }
+
+    return merged_count;
+}
@@ -24,11 +24,74 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 #include <sb-core/sb-abstractexecutive.h>
 #include <sb-core/sb-data.h>
 
+#include <exception>
+#include <functional>
 #include <type_traits>
 
 namespace sb
 {
 
+/// Alias for the function called when an asynchronous execution completes,
+/// given the exception it raised, if any.
+///
+/// \sa AbstractBlok::process_async().
+using AsyncCompletion = std::function<void(std::exception_ptr)>;
+
+/// \brief The OverflowPolicy enum lists what an executive does with an item
+/// pushed through an edge while its queue is full.
+///
+/// \sa EdgePolicy.
+enum class OverflowPolicy
+{
+    /// The pusher waits for the queue to make room.
+    BLOCK,
+    /// The oldest queued item is discarded.
+    DROP_OLDEST,
+    /// The pushed item is discarded.
+    DROP_NEWEST,
+    /// The queued items are discarded: only the pushed item remains.
+    KEEP_LATEST
+};
+
+/// \brief The EdgePolicy structure holds how the input of a blok handles
+/// the items pushed faster than they are processed.
+///
+/// \sa AbstractBlok::set_input_policy().
+struct EdgePolicy
+{
+
+    /// What to do with a pushed item when the queue is full.
+    OverflowPolicy
+    overflow;
+
+    /// Number of items the queue holds, besides the items being processed.
+    Size
+    capacity;
+
+};
+
+/// \brief The EdgeStatistics structure holds the counters of the input of a
+/// blok.
+///
+/// \sa AbstractBlok::get_input_statistics().
+struct EdgeStatistics
+{
+
+    /// Number of items pushed through the edge.
+    Size
+    pushed_count;
+
+    /// Number of items discarded, by the overflow policy or because newer
+    /// items superseded them.
+    Size
+    dropped_count;
+
+    /// Number of pushes which waited for the queue to make room.
+    Size
+    blocked_count;
+
+};
+
 /// \brief The AbstractBlok class is the base class for dataflow objects.
 ///
 /// A dataflow object can be either a source, a filter or a sink.
@@ -72,18 +135,277 @@ public:
         const std::string& name_
     );
 
+    /// Pulls the input \a index_, requesting the piece returned by
+    /// get_requested_piece().
     void
     pull_input
     (
         Index index_ = 0
     );
 
+    /// Pulls the input \a index_, requesting \a piece_ from the upstream
+    /// blok.
+    ///
+    /// The request is carried upstream: the upstream blok processes
+    /// \a piece_ and, unless it asks for other pieces, pulls the same piece
+    /// from its own inputs.
+    ///
+    /// \sa get_input_extent().
+    void
+    pull_input
+    (
+        Index index_,
+        const Piece& piece_
+    );
+
+    /// Pushes the output \a index_, announcing the piece returned by
+    /// get_requested_piece().
     void
     push_output
     (
         Index index_ = 0
     );
 
+    /// Pushes the output \a index_, announcing it holds \a piece_.
+    ///
+    /// The followers process \a piece_ and, unless they push other pieces,
+    /// push the same piece to their own followers. A source can thus stream a
+    /// whole dataset piece by piece.
+    ///
+    /// Pushing an output whose version and piece didn't change since its last
+    /// push does nothing. Otherwise, when \a piece_ is WHOLE_PIECE, the
+    /// followers are visited after all the bloks upstream of them, each once
+    /// even if several of its inputs were pushed.
+    void
+    push_output
+    (
+        Index index_,
+        const Piece& piece_
+    );
+
+    /// Returns the piece this blok is asked to produce, i.e. the piece last
+    /// pulled from its outputs or last pushed to its inputs.
+    ///
+    /// The function returns WHOLE_PIECE if no piece was requested.
+    Piece
+    get_requested_piece
+    (
+    )
+    const;
+
+    /// Returns \b true if the item being processed was superseded by newer
+    /// inputs or properties.
+    ///
+    /// A long process() should call this function regularly and return as
+    /// soon as it returns \b true: the executive discards the outputs of a
+    /// cancelled execution. Only executives running the blok in another
+    /// thread request cancellations.
+    ///
+    /// \sa ThreadedExecutive.
+    bool
+    is_cancellation_requested
+    (
+    )
+    const;
+
+    /// Returns the extent of the dataset held by the input \a index_.
+    ///
+    /// \sa AbstractData::get_extent().
+    Size
+    get_input_extent
+    (
+        Index index_ = 0
+    )
+    const;
+
+    /// Sets the extent of the dataset held by the output \a index_ to
+    /// \a value_.
+    ///
+    /// A source should set the extent of its outputs, so that the sinks can
+    /// split the dataset in pieces; filters propagate the extent of their
+    /// first input by default.
+    void
+    set_output_extent
+    (
+        Index index_,
+        Size value_
+    );
+
+    /// Sets the sequence number of the output \a index_ to \a value_.
+    ///
+    /// Outputs are given a sequence number before process() is called and
+    /// each time the first input is pulled: a blok only needs this function,
+    /// once its inputs are pulled, to forward the sequence number of another
+    /// input than the first one.
+    ///
+    /// \sa AbstractData::get_sequence().
+    void
+    set_output_sequence
+    (
+        Index index_,
+        Size value_
+    );
+
+    /// Sets the timestamp of the output \a index_ to \a value_.
+    ///
+    /// A source may call this function to stamp its outputs with the time
+    /// its data was acquired at, instead of the time of its execution.
+    ///
+    /// \sa AbstractData::get_timestamp().
+    void
+    set_output_timestamp
+    (
+        Index index_,
+        const Timestamp& value_
+    );
+
+    /// Notifies the executive of this blok that its properties were
+    /// modified: property setters should call this function instead of
+    /// process().
+    ///
+    /// If a PropertyTransaction is open in the current thread, the update is
+    /// deferred to its commit.
+    ///
+    /// \sa AbstractExecutive::on_modified().
+    void
+    update
+    (
+    );
+
+    /// Enables or disables the memoization of this blok.
+    ///
+    /// A memoized blok is not processed again when its readable properties,
+    /// its inputs and its requested piece match a previous execution: its
+    /// outputs are restored from the memoization cache instead. Bloks whose
+    /// readable properties have no registered codec are always processed.
+    ///
+    /// \sa is_memoized(), register_codec() and set_memo_cache_byte_budget().
+    void
+    set_memoized
+    (
+        bool value_
+    );
+
+    /// Returns \b true if this blok is memoized; returns \b false otherwise.
+    ///
+    /// \sa set_memoized().
+    bool
+    is_memoized
+    (
+    )
+    const;
+
+    /// Sets the priority of this blok to \a value_.
+    ///
+    /// A blok is scheduled with the highest priority among itself and the
+    /// bloks downstream of it, so that setting the priority of a sink raises
+    /// the whole path feeding it. Bloks reached by a change are visited by
+    /// decreasing priority, then by increasing deadline, as long as their
+    /// upstream bloks are visited first; the pool pulling inputs concurrently
+    /// serves them in the same order.
+    ///
+    /// \sa get_priority() and set_deadline().
+    void
+    set_priority
+    (
+        int value_
+    );
+
+    /// Returns the priority of this blok, DEFAULT_PRIORITY if it was not set.
+    int
+    get_priority
+    (
+    )
+    const;
+
+    /// Sets the latency budget of this blok, in milliseconds, to \a value_.
+    ///
+    /// A blok is scheduled with the shortest deadline among itself and the
+    /// bloks downstream of it; among bloks of the same priority, the ones
+    /// with the shortest deadline are serviced first.
+    ///
+    /// \sa get_deadline() and set_priority().
+    void
+    set_deadline
+    (
+        Size value_
+    );
+
+    /// Returns the latency budget of this blok, NO_DEADLINE if it was not
+    /// set.
+    Size
+    get_deadline
+    (
+    )
+    const;
+
+    /// Sets the scheduling group of this blok to \a value_.
+    ///
+    /// The threads of the library running work for this blok, like the
+    /// concurrent pulls of lock_inputs() or the copies of threaded
+    /// executives, share their time fairly between scheduling groups. Giving
+    /// each graph its own group keeps a heavy graph from starving the
+    /// others. Bloks are in the unnamed group by default.
+    ///
+    /// \sa get_scheduling_group(), set_scheduling_weight() and
+    /// set_scheduling_quota().
+    void
+    set_scheduling_group
+    (
+        const std::string& value_
+    );
+
+    /// Returns the scheduling group of this blok.
+    std::string
+    get_scheduling_group
+    (
+    )
+    const;
+
+    /// Sets the policy of the input \a index_ to \a value_.
+    ///
+    /// The policy applies to the executives queueing the pushed items, like
+    /// ReplicatedExecutive: once \a value_.capacity items wait to be
+    /// processed, items pushed through this input are handled according to
+    /// \a value_.overflow. Executives which always keep the latest item only,
+    /// like ThreadedExecutive and AsyncExecutive, ignore the policy. An
+    /// input is unbounded by default.
+    ///
+    /// \sa get_input_policy() and get_input_statistics().
+    void
+    set_input_policy
+    (
+        Index index_,
+        const EdgePolicy& value_
+    );
+
+    /// Returns the policy of the input \a index_, DEFAULT_EDGE_POLICY if it
+    /// was not set.
+    EdgePolicy
+    get_input_policy
+    (
+        Index index_
+    )
+    const;
+
+    /// Returns the counters of the input \a index_.
+    ///
+    /// The counters are updated by the thread owning this blok.
+    EdgeStatistics
+    get_input_statistics
+    (
+        Index index_
+    )
+    const;
+
+    /// Returns \b true if this blok was merged into an identical blok by
+    /// merge_identical_bloks(); returns \b false otherwise.
+    bool
+    is_merged
+    (
+    )
+    const;
+
     virtual
     void
     process
@@ -92,6 +414,49 @@ public:
     {
     }
 
+    /// Processes the items of \a items_ in order, each item holding a
+    /// snapshot of the inputs of this blok.
+    ///
+    /// The default implementation binds the inputs to each item in turn and
+    /// calls process(). Bloks able to process several items at once, e.g.
+    /// using SIMD instructions, may override this function; they should then
+    /// update and push their outputs for each item.
+    ///
+    /// \sa BatchingExecutive.
+    virtual
+    void
+    process_batch
+    (
+        const DataBatch& items_
+    );
+
+    /// Starts processing the inputs of this blok, and calls \a completion_
+    /// once the outputs are updated.
+    ///
+    /// The default implementation calls process() then \a completion_.
+    /// Bloks waiting for I/O or timers may override this function to return
+    /// as soon as their wait begins, and call \a completion_ from the thread
+    /// owning the blok when it ends, e.g. from an EventLoop. Waiting bloks
+    /// hold no thread, however many they are. The header sb-coroutine.h
+    /// lets C++20 bloks write this function as a coroutine.
+    ///
+    /// \sa AsyncExecutive.
+    virtual
+    void
+    process_async
+    (
+        const AsyncCompletion& completion_
+    );
+
+    /// Returns the executive of this blok.
+    ///
+    /// \sa use_executive().
+    AbstractExecutive*
+    get_executive
+    (
+    )
+    const;
+
     static
     ObjectFormatSequence
     get_inputs_formats
@@ -168,6 +533,22 @@ ANY_BLOK_FORMAT = {
     AbstractBlok::get_properties()
 };
 
+/// Default priority of a blok.
+const int
+DEFAULT_PRIORITY = 0;
+
+/// Constant value representing the latency budget of a blok without
+/// deadline.
+const Size
+NO_DEADLINE = MAX_SIZE;
+
+/// Default policy of an input: the pushed items are all queued.
+const EdgePolicy
+DEFAULT_EDGE_POLICY = {
+    OverflowPolicy::BLOCK,
+    MAX_SIZE
+};
+
 /// Alias for a managed blok uniquely owned.
 using UniqueBlok = Unique<AbstractBlok>;
 
@@ -229,6 +610,75 @@ connect(
     return connect(left_.get(), 0, right_.get(), 0);
 }
 
+/// Connects the output \a left_index_ of \a left_ to the input
+/// \a right_index_ of \a right_, and sets the policy of the input to
+/// \a policy_.
+///
+/// \sa AbstractBlok::set_input_policy().
+inline
+bool
+connect
+(
+    AbstractBlok* left_,
+    Index left_index_,
+    AbstractBlok* right_,
+    Index right_index_,
+    const EdgePolicy& policy_
+)
+{
+    bool is_connected = connect(left_, left_index_, right_, right_index_);
+
+    if(is_connected)
+    {
+        right_->set_input_policy(right_index_, policy_);
+    }
+
+    return is_connected;
+}
+
+template<typename T, typename U>
+inline
+bool
+connect(
+    const T& left_,
+    Index left_index_,
+    U& right_,
+    Index right_index_,
+    const EdgePolicy& policy_
+)
+{
+    return connect(
+        left_.get(),
+        left_index_,
+        right_.get(),
+        right_index_,
+        policy_
+    );
+}
+
+/// Merges the identical bloks of \a bloks_ and returns the number of merged
+/// bloks.
+///
+/// Two bloks are identical if they have the same type, the same inputs and
+/// the same serialized properties (see serialize()): bloks with properties
+/// that can't be serialized are never merged. The followers of a merged blok
+/// are connected to the outputs of the first identical blok of \a bloks_,
+/// which executes for all of them while the merged blok stays idle.
+///
+/// Bloks connected to a merged blok afterwards are connected to the blok it
+/// was merged into as well. A merged blok is split again when its
+/// properties or its inputs, or those of the blok it was merged into,
+/// diverge: its followers are connected back to its outputs and it is
+/// updated.
+///
+/// \sa AbstractBlok::is_merged().
+SB_CORE_API
+Size
+merge_identical_bloks
+(
+    const std::vector<AbstractBlok*>& bloks_
+);
+
 }
 
 #define SB_INPUTS_FORMATS(...)\
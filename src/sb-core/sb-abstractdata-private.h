@@ -22,6 +22,9 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractblok.h>
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <unordered_map>
 
 namespace sb
@@ -54,6 +57,59 @@ namespace Unmapper
 
 }
 
+class SB_DECL_HIDDEN DataPool
+{
+
+public:
+
+    DataPool
+    (
+        const std::string& name_,
+        Size high_water_mark_
+    );
+
+    static
+    SharedData
+    acquire
+    (
+        const Shared<DataPool>& this_
+    );
+
+    void
+    release
+    (
+        UniqueObject&& instance_
+    );
+
+    void
+    set_high_water_mark
+    (
+        Size value_
+    );
+
+    DataPoolStatistics
+    get_statistics
+    (
+    );
+
+public:
+
+    std::string
+    name;
+
+    std::mutex
+    mutex;
+
+    std::vector<UniqueObject>
+    free_list;
+
+    DataPoolStatistics
+    statistics;
+
+};
+
+using NameToDataPoolMap = std::map<std::string, Shared<DataPool>>;
+
 class SB_DECL_HIDDEN AbstractData::Private
 {
 
@@ -78,6 +134,18 @@ public:
         const SharedData& this_
     );
 
+    static
+    void
+    clear_pools
+    (
+    );
+
+    static
+    Size
+    make_version
+    (
+    );
+
 public:
 
     AbstractData*
@@ -92,6 +160,45 @@ public:
     FollowerCollection
     followers;
 
+    Size
+    extent;
+
+    Piece
+    piece;
+
+    Size
+    version;
+
+    // false until update_version() is called: the version of such data
+    // doesn't tell if their content changed
+
+    bool
+    is_versioned;
+
+    // identifies the content of data produced by a memoized execution, in
+    // any process: the key material of the execution, whose output
+    // content_index holds the content; empty if the content is unknown
+
+    std::shared_ptr<const std::vector<char>>
+    content_key;
+
+    Index
+    content_index;
+
+    Size
+    sequence;
+
+    Timestamp
+    timestamp;
+
+    // version and piece of the last push to the followers
+
+    Size
+    pushed_version;
+
+    Piece
+    pushed_piece;
+
 };
 
 }
@@ -21,6 +21,46 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractblok-private.h>
 
+namespace sb
+{
+
+namespace Global
+{
+
+std::mutex
+data_pools_mutex;
+
+NameToDataPoolMap
+data_pools;
+
+std::atomic<Size>
+data_clock(0);
+
+}
+
+inline
+Shared<DataPool>
+find_data_pool
+(
+    const std::string& name_
+)
+{
+    Shared<DataPool> pool;
+
+    std::lock_guard<std::mutex> lock(Global::data_pools_mutex);
+
+    auto mapped_pool = Global::data_pools.find(name_);
+
+    if(mapped_pool != Global::data_pools.end())
+    {
+        pool = mapped_pool->second;
+    }
+
+    return pool;
+}
+
+}
+
 using namespace sb;
 
 AbstractData::AbstractData
@@ -37,12 +77,102 @@ AbstractData::~AbstractData
     delete d_ptr;
 }
 
+Size
+AbstractData::get_extent
+(
+)
+const
+{
+    Size extent = d_ptr->extent;
+
+    if(extent == UNKNOWN_EXTENT && d_ptr->source_blok)
+    {
+        // by default, a blok produces pieces of its first input's dataset
+
+        auto blok_d_ptr = AbstractBlok::Private::from(
+            d_ptr->source_blok
+        );
+
+        if(!blok_d_ptr->inputs.empty())
+        {
+            auto input = blok_d_ptr->inputs[0].lock();
+
+            if(input)
+            {
+                extent = input->get_extent();
+            }
+        }
+    }
+
+    return extent;
+}
+
+Piece
+AbstractData::get_piece
+(
+)
+const
+{
+    return d_ptr->piece;
+}
+
+Size
+AbstractData::get_version
+(
+)
+const
+{
+    return d_ptr->version;
+}
+
+Size
+AbstractData::get_sequence
+(
+)
+const
+{
+    return d_ptr->sequence;
+}
+
+Timestamp
+AbstractData::get_timestamp
+(
+)
+const
+{
+    return d_ptr->timestamp;
+}
+
+void
+AbstractData::update_version
+(
+)
+{
+    d_ptr->version = Private::make_version();
+    d_ptr->is_versioned = true;
+
+    // the content may not match its key anymore
+
+    d_ptr->content_key.reset();
+}
+
 AbstractData::Private::Private
 (
     AbstractData* q_ptr_
 ):
-    q_ptr       (q_ptr_),
-    source_blok (SB_NULLPTR)
+    q_ptr          (q_ptr_),
+    source_blok    (SB_NULLPTR),
+    source_index   (0),
+    extent         (UNKNOWN_EXTENT),
+    piece          (WHOLE_PIECE),
+    version        (make_version()),
+    is_versioned   (false),
+    content_key    (),
+    content_index  (0),
+    sequence       (0),
+    timestamp      (UNKNOWN_TIMESTAMP),
+    pushed_version (0),
+    pushed_piece   (WHOLE_PIECE)
 {
 }
 
@@ -63,3 +193,289 @@ AbstractData::Private::from
 {
     return this_->d_ptr;
 }
+
+Size
+AbstractData::Private::make_version
+(
+)
+{
+    return ++Global::data_clock;
+}
+
+void
+AbstractData::Private::clear_pools
+(
+)
+{
+    NameToDataPoolMap data_pools;
+
+    {
+        std::lock_guard<std::mutex> lock(Global::data_pools_mutex);
+
+        data_pools.swap(Global::data_pools);
+    }
+
+    // pooled data are destroyed here, out of the lock
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+DataPool::DataPool
+(
+    const std::string& name_,
+    Size high_water_mark_
+):
+    name        (name_),
+    statistics  ()
+{
+    this->statistics.high_water_mark = high_water_mark_;
+}
+
+SharedData
+DataPool::acquire
+(
+    const Shared<DataPool>& this_
+)
+{
+    UniqueObject instance;
+
+    {
+        std::lock_guard<std::mutex> lock(this_->mutex);
+
+        if(!this_->free_list.empty())
+        {
+            instance = std::move(this_->free_list.back());
+
+            this_->free_list.pop_back();
+
+            this_->statistics.reused++;
+        }
+    }
+
+    if(!instance)
+    {
+        instance = create_unique_object(this_->name);
+
+        if(instance)
+        {
+            std::lock_guard<std::mutex> lock(this_->mutex);
+
+            this_->statistics.created++;
+        }
+    }
+
+    SharedData data;
+
+    if(instance)
+    {
+        // hand the instance out with a deleter giving it back to the pool,
+        // or destroying it if the pool is gone
+
+        Weak<DataPool> weak_pool = this_;
+
+        auto deleter = instance.get_deleter();
+
+        data = SharedData(
+            static_cast<AbstractData*>(instance.release()),
+            [weak_pool, deleter]
+            (
+                AbstractData* ptr_
+            )
+            {
+                UniqueObject released(ptr_, deleter);
+
+                auto pool = weak_pool.lock();
+
+                if(pool)
+                {
+                    pool->release(std::move(released));
+                }
+            }
+        );
+    }
+
+    return data;
+}
+
+void
+DataPool::release
+(
+    UniqueObject&& instance_
+)
+{
+    auto data = static_cast<AbstractData*>(instance_.get());
+
+    // forget the previous links of the data
+
+    auto data_d_ptr = AbstractData::Private::from(data);
+
+    data_d_ptr->source_blok = SB_NULLPTR;
+    data_d_ptr->source_index = 0;
+    data_d_ptr->followers.clear();
+    data_d_ptr->extent = UNKNOWN_EXTENT;
+    data_d_ptr->piece = WHOLE_PIECE;
+    data_d_ptr->version = AbstractData::Private::make_version();
+    data_d_ptr->content_key.reset();
+    data_d_ptr->content_index = 0;
+    data_d_ptr->sequence = 0;
+    data_d_ptr->timestamp = UNKNOWN_TIMESTAMP;
+    data_d_ptr->pushed_version = 0;
+    data_d_ptr->pushed_piece = WHOLE_PIECE;
+
+    data->recycle();
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if(this->free_list.size() < this->statistics.high_water_mark)
+    {
+        this->free_list.push_back(std::move(instance_));
+
+        this->statistics.recycled++;
+    }
+    else
+    {
+        this->statistics.discarded++;
+    }
+}
+
+void
+DataPool::set_high_water_mark
+(
+    Size value_
+)
+{
+    std::vector<UniqueObject> exceeding;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        this->statistics.high_water_mark = value_;
+
+        if(this->free_list.size() > value_)
+        {
+            exceeding.assign(
+                std::make_move_iterator(this->free_list.begin() + value_),
+                std::make_move_iterator(this->free_list.end())
+            );
+
+            this->free_list.resize(value_);
+        }
+    }
+
+    // exceeding data are destroyed here, out of the lock
+}
+
+DataPoolStatistics
+DataPool::get_statistics
+(
+)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    DataPoolStatistics statistics = this->statistics;
+
+    statistics.available = this->free_list.size();
+
+    return statistics;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+SharedData
+sb::clone_data
+(
+    const SharedData& data_
+)
+{
+    SharedData clone;
+
+    if(data_)
+    {
+        clone = create_shared_data(
+            data_->get_format().type_names[0]
+        );
+
+        if(clone && !clone->copy(*data_))
+        {
+            clone.reset();
+        }
+        else if(clone)
+        {
+            auto clone_d_ptr = AbstractData::Private::from(clone);
+            auto data_d_ptr = AbstractData::Private::from(data_);
+
+            clone_d_ptr->sequence = data_d_ptr->sequence;
+            clone_d_ptr->timestamp = data_d_ptr->timestamp;
+        }
+    }
+
+    return clone;
+}
+
+SharedData
+sb::create_shared_data
+(
+    const std::string& name_
+)
+{
+    auto pool = find_data_pool(name_);
+
+    return (
+        pool ? DataPool::acquire(pool) : create_shared<AbstractData>(name_)
+    );
+}
+
+bool
+sb::enable_data_pool
+(
+    const std::string& name_,
+    Size high_water_mark_
+)
+{
+    bool enabled = false;
+
+    if(get_object_format(name_).includes(ANY_DATA_FORMAT))
+    {
+        std::lock_guard<std::mutex> lock(Global::data_pools_mutex);
+
+        enabled = Global::data_pools.emplace(
+            name_,
+            std::make_shared<DataPool>(name_, high_water_mark_)
+        ).second;
+    }
+
+    return enabled;
+}
+
+void
+sb::set_data_pool_high_water_mark
+(
+    const std::string& name_,
+    Size value_
+)
+{
+    auto pool = find_data_pool(name_);
+
+    if(pool)
+    {
+        pool->set_high_water_mark(value_);
+    }
+}
+
+DataPoolStatistics
+sb::get_data_pool_statistics
+(
+    const std::string& name_
+)
+{
+    DataPoolStatistics statistics = DataPoolStatistics();
+
+    auto pool = find_data_pool(name_);
+
+    if(pool)
+    {
+        statistics = pool->get_statistics();
+    }
+
+    return statistics;
+}
@@ -20,9 +20,20 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractobject.h>
 
+#include <sb-core/sb-piece.h>
+
+#include <chrono>
+
 namespace sb
 {
 
+/// Alias for the point in time a data was produced at.
+using Timestamp = std::chrono::steady_clock::time_point;
+
+/// Constant value representing an unknown timestamp.
+const Timestamp
+UNKNOWN_TIMESTAMP = Timestamp();
+
 /// \brief The AbstractData class represents a piece of data for use with the
 /// DataSet class.
 class SB_CORE_API AbstractData : public AbstractObject
@@ -47,6 +58,127 @@ public:
     (
     );
 
+    /// Returns the number of elements in the whole dataset this data is a
+    /// piece of.
+    ///
+    /// If the extent was not set by the blok producing this data, the extent
+    /// of the first input of that blok is returned; UNKNOWN_EXTENT is
+    /// returned if there is no such input.
+    ///
+    /// \sa AbstractBlok::set_output_extent().
+    Size
+    get_extent
+    (
+    )
+    const;
+
+    /// Returns the piece of the dataset currently held by this data.
+    ///
+    /// \sa AbstractBlok::get_requested_piece().
+    Piece
+    get_piece
+    (
+    )
+    const;
+
+    /// Returns the version of this data.
+    ///
+    /// Versions are unique among all data: a data is given a new version
+    /// each time its content changes, so two data with the same version hold
+    /// the same content.
+    Size
+    get_version
+    (
+    )
+    const;
+
+    /// Returns the sequence number of this data.
+    ///
+    /// Each execution of a source gives its outputs the next sequence number,
+    /// starting at 1; filters and sinks propagate the sequence number of
+    /// their first input by default, so that data produced from the same item
+    /// share a sequence number. Zero is returned if this data was never
+    /// produced.
+    ///
+    /// \sa AbstractBlok::set_output_sequence().
+    Size
+    get_sequence
+    (
+    )
+    const;
+
+    /// Returns the point in time the item held by this data was produced at
+    /// by its source.
+    ///
+    /// Timestamps are propagated like the sequence numbers: sources stamp
+    /// their outputs with the time of their execution, other bloks propagate
+    /// the timestamp of their first input by default. UNKNOWN_TIMESTAMP is
+    /// returned if this data was never produced.
+    ///
+    /// \sa AbstractBlok::set_output_timestamp().
+    Timestamp
+    get_timestamp
+    (
+    )
+    const;
+
+    /// Copies the content of \a other_ into this data.
+    ///
+    /// The function returns \b true if the content was copied; it returns
+    /// \b false if \a other_ is not of the same type as this data. The
+    /// default implementation returns \b false.
+    ///
+    /// \sa clone_data().
+    virtual
+    bool
+    copy
+    (
+        const AbstractData& /*other_*/
+    )
+    {
+        return false;
+    }
+
+    /// Returns an estimation of the memory used by this data, in bytes.
+    virtual
+    Size
+    get_byte_size
+    (
+    )
+    const
+    {
+        return sizeof(AbstractData);
+    }
+
+    /// Prepares this data to be handed out again by its pool.
+    ///
+    /// This function is called when a pooled data is released, before it
+    /// is pushed back to the free list. The default implementation does
+    /// nothing.
+    ///
+    /// \sa enable_data_pool().
+    virtual
+    void
+    recycle
+    (
+    )
+    {
+    }
+
+protected:
+
+    /// Gives a new version to this data.
+    ///
+    /// Derived classes must call this function each time the content of the
+    /// data changes. Data that never call it are pushed to the followers
+    /// each time their blok pushes them, even if their content is unchanged.
+    ///
+    /// \sa get_version().
+    void
+    update_version
+    (
+    );
+
 private:
 
     /// \cond INTERNAL
@@ -69,13 +201,114 @@ using SharedData = Shared<AbstractData>;
 /// Alias for a weakly managed data.
 using WeakData = Weak<AbstractData>;
 
-/// Alias for create_shared<AbstractData>().
-static
+/// Alias for a sequence of managed data.
+using SharedDataSequence = std::vector<SharedData>;
+
+/// Returns a managed pointer to an instance of the data designated by
+/// \a name_.
+///
+/// If a pool was enabled for \a name_, the instance is taken from its free
+/// list when possible and goes back to it once released; otherwise this
+/// function is equivalent to create_shared<AbstractData>().
+///
+/// \sa enable_data_pool().
+SB_CORE_API
+SharedData
+create_shared_data
+(
+    const std::string& name_
+);
+
+/// Returns a new data of the same type as \a data_, holding a copy of its
+/// content, sequence number and timestamp.
+///
+/// The function returns an empty pointer if \a data_ is empty or if its
+/// type doesn't support copy.
+///
+/// \sa AbstractData::copy().
+SB_CORE_API
 SharedData
-(&create_shared_data)
+clone_data
+(
+    const SharedData& data_
+);
+
+/// \brief The DataPoolStatistics structure holds the counters of a data
+/// pool.
+///
+/// \sa get_data_pool_statistics().
+struct DataPoolStatistics
+{
+
+    /// Number of data instantiated by the pool.
+    Size
+    created;
+
+    /// Number of requests served from the free list.
+    Size
+    reused;
+
+    /// Number of released data pushed back to the free list.
+    Size
+    recycled;
+
+    /// Number of released data destroyed because the free list was full.
+    Size
+    discarded;
+
+    /// Number of data currently held by the free list.
+    Size
+    available;
+
+    /// Maximum number of data held by the free list.
+    Size
+    high_water_mark;
+
+};
+
+/// Default maximum number of data held by the free list of a pool.
+const Size DEFAULT_DATA_POOL_HIGH_WATER_MARK = 64;
+
+/// Enables a pool for the data designated by \a name_.
+///
+/// Data created with create_shared_data() then return to a free list when
+/// released, instead of being destroyed, and are handed out again on the next
+/// request. At most \a high_water_mark_ data are kept in the free list.
+///
+/// The function returns \b true if a pool was enabled; it returns \b false
+/// if \a name_ doesn't designate a registered data or if a pool was already
+/// enabled for it.
+///
+/// \sa register_data() and set_data_pool_high_water_mark().
+SB_CORE_API
+bool
+enable_data_pool
+(
+    const std::string& name_,
+    Size high_water_mark_ = DEFAULT_DATA_POOL_HIGH_WATER_MARK
+);
+
+/// Sets the maximum number of data held by the free list of the pool
+/// designated by \a name_ to \a value_.
+///
+/// Exceeding data are destroyed immediately.
+SB_CORE_API
+void
+set_data_pool_high_water_mark
+(
+    const std::string& name_,
+    Size value_
+);
+
+/// Returns the counters of the pool designated by \a name_.
+///
+/// All the counters are zero if no pool was enabled for \a name_.
+SB_CORE_API
+DataPoolStatistics
+get_data_pool_statistics
 (
     const std::string& name_
-) = create_shared<AbstractData>;
+);
 
 }
 
@@ -21,6 +21,13 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 #include <sb-core/sb-abstractexecutive.h>
 
 #include <sb-core/sb-abstractblok.h>
+#include <sb-core/sb-executor-private.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace sb
 {
@@ -35,6 +42,90 @@ public:
         AbstractExecutive* q_ptr_
     );
 
+    // processes the blok, or restores its outputs from the memo cache;
+    // expects the execution mutex to be locked
+
+    void
+    run
+    (
+    );
+
+    // called before the blok processes; stamps the outputs
+
+    void
+    prepare_outputs
+    (
+    );
+
+    // called after the blok processed; records the versions of its inputs
+
+    void
+    notify_outputs
+    (
+    );
+
+    // copies the inputs of the blok into item_, unless an input is missing
+    // or their versions are versions_; returns false in those cases. Empty
+    // versions_ match nothing. Throws if an input can't be copied
+
+    bool
+    snapshot_inputs
+    (
+        std::vector<Size>& versions_,
+        SharedDataSequence& item_,
+        const std::string& function_name_
+    )
+    const;
+
+    // creates a copy of the blok, given its properties, for use in another
+    // thread: the copy only processes the items handed over to it
+
+    UniqueBlok
+    create_copy
+    (
+        const std::string& function_name_
+    )
+    const;
+
+    // copies outputs_, produced by a copy, into the outputs of the blok;
+    // throws if an output can't be copied
+
+    void
+    restore_outputs
+    (
+        const SharedDataSequence& outputs_,
+        const std::string& function_name_
+    );
+
+    // restore_outputs(), then pushes the outputs
+
+    void
+    publish_outputs
+    (
+        const SharedDataSequence& outputs_,
+        const std::string& function_name_
+    );
+
+    // submits task_ to the executor with the priority, the deadline and the
+    // scheduling group of the blok
+
+    std::shared_ptr<TaskGroup>
+    post
+    (
+        std::function<void()> task_
+    );
+
+    // returns copies of the outputs of blok_; throws if an output can't be
+    // copied
+
+    static
+    SharedDataSequence
+    clone_outputs
+    (
+        const AbstractBlok* blok_,
+        const std::string& function_name_
+    );
+
     static
     Private*
     from
@@ -60,6 +151,18 @@ public:
     bool
     is_executing;
 
+    // held while the blok executes; pulls wait for it, other executions
+    // give up
+
+    std::recursive_mutex
+    execution_mutex;
+
+    // set by the executions given up in other threads: the thread holding
+    // the mutex executes the blok again
+
+    std::atomic<bool>
+    is_execution_requested;
+
 };
 
 }
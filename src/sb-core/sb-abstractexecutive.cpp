@@ -19,6 +19,85 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractexecutive-private.h>
 
+#include <stdexcept>
+
+#include <sb-core/sb-abstractblok-private.h>
+#include <sb-core/sb-abstractdata-private.h>
+#include <sb-core/sb-abstractobject-private.h>
+#include <sb-core/sb-event-private.h>
+#include <sb-core/sb-executive.h>
+#include <sb-core/sb-memocache-private.h>
+#include <sb-core/sb-propagation-private.h>
+#include <sb-core/sb-serialization.h>
+
+namespace sb
+{
+
+namespace
+{
+
+// marks the blok of an executive as executing until destroyed, even if the
+// blok throws
+
+class ExecutionScope
+{
+
+public:
+
+    explicit
+    ExecutionScope
+    (
+        bool& is_executing_
+    ):
+        is_executing(is_executing_)
+    {
+        this->is_executing = true;
+    }
+
+    ~ExecutionScope
+    (
+    )
+    {
+        this->is_executing = false;
+    }
+
+private:
+
+    bool&
+    is_executing;
+
+};
+
+// returns a copy of data_: live data must not be shared with the items of
+// an executive, which may be processed in other threads
+
+SharedData
+copy_data
+(
+    const SharedData& data_,
+    const std::string& function_name_
+)
+{
+    SharedData copy = clone_data(data_);
+
+    if(!copy)
+    {
+        throw std::invalid_argument(
+            std::string() +
+            function_name_ +
+            ": " +
+            data_->get_format().type_names[0] +
+            " doesn't support copy; the executive can't snapshot it"
+        );
+    }
+
+    return copy;
+}
+
+}
+
+}
+
 using namespace sb;
 
 AbstractExecutive::AbstractExecutive
@@ -35,18 +114,99 @@ AbstractExecutive::~AbstractExecutive
     delete d_ptr;
 }
 
+void
+AbstractExecutive::on_modified
+(
+)
+{
+    this->execute();
+}
+
+AbstractBlok*
+AbstractExecutive::get_blok
+(
+)
+const
+{
+    return d_ptr->blok;
+}
+
 void
 AbstractExecutive::execute
 (
 )
 {
-    if(!d_ptr->is_executing)
+    std::unique_lock<std::recursive_mutex> lock(
+        d_ptr->execution_mutex,
+        std::try_to_lock
+    );
+
+    bool is_requested = true;
+
+    if(lock.owns_lock())
+    {
+        // a blok executing in this thread is not executed again, and a
+        // visited blok is executed once, however many inputs were pushed
+
+        is_requested =
+            !d_ptr->is_executing &&
+            Propagation::begin_execution(d_ptr->blok);
+
+        if(!is_requested)
+        {
+            return;
+        }
+    }
+
+    // a blok executing in another thread is executed again by that thread
+    // once done, so that the pushed inputs are not lost
+
+    while(is_requested)
+    {
+        if(lock.owns_lock())
+        {
+            d_ptr->is_execution_requested = false;
+
+            d_ptr->run();
+
+            lock.unlock();
+        }
+        else
+        {
+            d_ptr->is_execution_requested = true;
+        }
+
+        // the request may have been made before the mutex was unlocked
+
+        is_requested = d_ptr->is_execution_requested && lock.try_lock();
+    }
+}
+
+void
+AbstractExecutive::execute_batch
+(
+    const DataBatch& items_
+)
+{
+    std::unique_lock<std::recursive_mutex> lock(
+        d_ptr->execution_mutex,
+        std::try_to_lock
+    );
+
+    if(
+        lock.owns_lock() &&
+        !items_.empty() &&
+        !d_ptr->is_executing &&
+        Propagation::begin_execution(d_ptr->blok)
+    )
     {
-        d_ptr->is_executing = true;
+        ExecutionScope scope(d_ptr->is_executing);
 
-        d_ptr->blok->process();
+        d_ptr->prepare_outputs();
 
-        d_ptr->is_executing = false;
+        d_ptr->blok->process_batch(items_);
+
+        d_ptr->notify_outputs();
     }
 }
 
@@ -54,11 +214,370 @@ AbstractExecutive::Private::Private
 (
     AbstractExecutive* q_ptr_
 ):
-    q_ptr           (q_ptr_),
-    is_executing    (false)
+    q_ptr                   (q_ptr_),
+    is_executing            (false),
+    is_execution_requested  (false)
 {
 }
 
+void
+AbstractExecutive::Private::run
+(
+)
+{
+    ExecutionScope scope(this->is_executing);
+
+    this->prepare_outputs();
+
+    auto blok_d_ptr = AbstractBlok::Private::from(this->blok);
+
+    MemoKey memo_key;
+
+    bool is_memoizable = false;
+
+    bool is_memo_key_persistent = false;
+
+    if(blok_d_ptr->memoized)
+    {
+        // pull the inputs once, so that the key matches their content
+
+        for(Index i = 0; i < blok_d_ptr->inputs.size(); ++i)
+        {
+            this->blok->pull_input(i);
+        }
+
+        blok_d_ptr->inputs_pulled = true;
+
+        is_memoizable = blok_d_ptr->get_memo_key(
+            memo_key,
+            is_memo_key_persistent
+        );
+    }
+
+    SharedDataSequence memo_outputs;
+
+    bool is_memo_hit =
+        is_memoizable &&
+        MemoCache::find(memo_key, is_memo_key_persistent, memo_outputs);
+
+    // content keys identify the content of data in any process: they
+    // can't be derived from a key made of versions
+
+    bool has_content_key = is_memoizable && is_memo_key_persistent;
+
+    if(is_memo_hit)
+    {
+        for(Index i = 0; i < blok_d_ptr->outputs.size(); ++i)
+        {
+            auto output = blok_d_ptr->outputs[i];
+
+            auto output_d_ptr = AbstractData::Private::from(output);
+
+            // outputs may already hold the memoized content
+
+            if(
+                !has_content_key ||
+                !output_d_ptr->content_key ||
+                output_d_ptr->content_index != i ||
+                *output_d_ptr->content_key != *memo_key.material
+            )
+            {
+                output->copy(*memo_outputs[i]);
+
+                output_d_ptr->content_key =
+                    has_content_key ?
+                        memo_key.material :
+                        SB_NULLPTR;
+                output_d_ptr->content_index = i;
+            }
+        }
+    }
+    else
+    {
+        this->blok->process();
+
+        if(is_memoizable)
+        {
+            MemoCache::insert(
+                memo_key,
+                is_memo_key_persistent,
+                blok_d_ptr->outputs
+            );
+        }
+
+        if(has_content_key)
+        {
+            for(Index i = 0; i < blok_d_ptr->outputs.size(); ++i)
+            {
+                auto output_d_ptr = AbstractData::Private::from(
+                    blok_d_ptr->outputs[i]
+                );
+
+                output_d_ptr->content_key = memo_key.material;
+                output_d_ptr->content_index = i;
+            }
+        }
+    }
+
+    blok_d_ptr->inputs_pulled = false;
+
+    this->notify_outputs();
+
+    if(is_memo_hit)
+    {
+        // process() was skipped, so the restored outputs are pushed here;
+        // outputs already holding the memoized content are not pushed
+        // again
+
+        for(Index i = 0; i < blok_d_ptr->outputs.size(); ++i)
+        {
+            this->blok->push_output(i);
+        }
+    }
+}
+
+void
+AbstractExecutive::Private::prepare_outputs
+(
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(this->blok);
+
+    blok_d_ptr->stale = false;
+
+    blok_d_ptr->stamp_outputs();
+
+    // outputs will hold the requested piece, unless the blok pushes other
+    // pieces
+
+    for(auto output : blok_d_ptr->outputs)
+    {
+        AbstractData::Private::from(
+            output
+        )->piece = blok_d_ptr->requested_piece;
+    }
+}
+
+void
+AbstractExecutive::Private::notify_outputs
+(
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(this->blok);
+
+    auto object_d_ptr = AbstractObject::Private::from(this->blok);
+
+    // the propagation doesn't execute again a blok whose inputs keep these
+    // versions
+
+    blok_d_ptr->is_executed = true;
+
+    blok_d_ptr->executed_input_versions.clear();
+
+    for(const auto& weak_input : blok_d_ptr->inputs)
+    {
+        auto input = weak_input.lock();
+
+        blok_d_ptr->executed_input_versions.push_back(
+            input ? input->get_version() : 0
+        );
+    }
+
+    if(object_d_ptr->observer_count.load(std::memory_order_relaxed) != 0)
+    {
+        for(Index i = 0; i < blok_d_ptr->outputs.size(); ++i)
+        {
+            EventQueue::post(
+                object_d_ptr->serial,
+                Event{Event::Type::OUTPUT_UPDATED, this->blok, "", i}
+            );
+        }
+    }
+}
+
+bool
+AbstractExecutive::Private::snapshot_inputs
+(
+    std::vector<Size>& versions_,
+    SharedDataSequence& item_,
+    const std::string& function_name_
+)
+const
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(this->blok);
+
+    std::vector<Size> versions;
+
+    for(const auto& weak_input : blok_d_ptr->inputs)
+    {
+        auto input = weak_input.lock();
+
+        // a blok with a missing input has nothing to process yet
+
+        if(!input)
+        {
+            return false;
+        }
+
+        versions.push_back(input->get_version());
+    }
+
+    // empty versions_ force the snapshot
+
+    if(!versions_.empty() && versions == versions_)
+    {
+        return false;
+    }
+
+    versions_ = versions;
+
+    item_.clear();
+
+    for(const auto& weak_input : blok_d_ptr->inputs)
+    {
+        item_.push_back(copy_data(weak_input.lock(), function_name_));
+    }
+
+    return true;
+}
+
+UniqueBlok
+AbstractExecutive::Private::create_copy
+(
+    const std::string& function_name_
+)
+const
+{
+    std::string type_name = this->blok->get_format().type_names[0];
+
+    UniqueBlok copy = create_unique_blok(type_name);
+
+    if(!copy)
+    {
+        throw std::invalid_argument(
+            std::string() +
+            function_name_ +
+            ": failed to create a copy of " +
+            type_name +
+            "; the blok type must be registered"
+        );
+    }
+
+    sb::register_object<PullExecutive>();
+
+    copy->use_executive(get_type_name<PullExecutive>());
+
+    Writer writer;
+
+    serialize(*this->blok, writer);
+
+    Reader reader(writer.get_buffer());
+
+    deserialize(*copy, reader);
+
+    // the work of the copy is scheduled like the work of the blok
+
+    copy->set_priority(this->blok->get_priority());
+    copy->set_deadline(this->blok->get_deadline());
+    copy->set_scheduling_group(this->blok->get_scheduling_group());
+
+    return copy;
+}
+
+void
+AbstractExecutive::Private::restore_outputs
+(
+    const SharedDataSequence& outputs_,
+    const std::string& function_name_
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(this->blok);
+
+    this->prepare_outputs();
+
+    for(
+        Index i = 0;
+        i < blok_d_ptr->outputs.size() && i < outputs_.size();
+        ++i
+    )
+    {
+        auto output = blok_d_ptr->outputs[i];
+
+        if(!output->copy(*outputs_[i]))
+        {
+            throw std::invalid_argument(
+                std::string() +
+                function_name_ +
+                ": the output " +
+                std::to_string(i) +
+                " can't be restored; its type doesn't support copy"
+            );
+        }
+
+        // the copy stamped its outputs with the item it processed
+
+        auto output_d_ptr = AbstractData::Private::from(output);
+        auto copy_d_ptr = AbstractData::Private::from(outputs_[i]);
+
+        output_d_ptr->sequence = copy_d_ptr->sequence;
+        output_d_ptr->timestamp = copy_d_ptr->timestamp;
+    }
+
+    this->notify_outputs();
+}
+
+void
+AbstractExecutive::Private::publish_outputs
+(
+    const SharedDataSequence& outputs_,
+    const std::string& function_name_
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(this->blok);
+
+    this->restore_outputs(outputs_, function_name_);
+
+    for(Index i = 0; i < blok_d_ptr->outputs.size(); ++i)
+    {
+        this->blok->push_output(i);
+    }
+}
+
+std::shared_ptr<TaskGroup>
+AbstractExecutive::Private::post
+(
+    std::function<void()> task_
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(this->blok);
+
+    blok_d_ptr->update_urgency();
+
+    return Executor::post(
+        std::move(task_),
+        blok_d_ptr->effective_priority,
+        blok_d_ptr->effective_deadline,
+        blok_d_ptr->scheduling_group
+    );
+}
+
+SharedDataSequence
+AbstractExecutive::Private::clone_outputs
+(
+    const AbstractBlok* blok_,
+    const std::string& function_name_
+)
+{
+    SharedDataSequence outputs;
+
+    for(const auto& output : AbstractBlok::Private::from(blok_)->outputs)
+    {
+        outputs.push_back(copy_data(output, function_name_));
+    }
+
+    return outputs;
+}
+
 AbstractExecutive::Private*
 AbstractExecutive::Private::from
 (
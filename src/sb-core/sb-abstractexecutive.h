@@ -20,11 +20,19 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractobject.h>
 
+#include <sb-core/sb-abstractdata.h>
+
 namespace sb
 {
 
 class AbstractBlok;
 
+/// Alias for a sequence of items, each item holding a snapshot of the inputs
+/// of a blok.
+///
+/// \sa AbstractBlok::process_batch().
+using DataBatch = std::vector<SharedDataSequence>;
+
 class SB_CORE_API AbstractExecutive : public AbstractObject
 {
 
@@ -63,6 +71,16 @@ public:
     )
     = 0;
 
+    /// This function is called when the properties of the blok were
+    /// modified, through AbstractBlok::update().
+    ///
+    /// The default implementation executes the blok.
+    virtual
+    void
+    on_modified
+    (
+    );
+
 protected:
 
     AbstractBlok*
@@ -76,6 +94,14 @@ protected:
     (
     );
 
+    /// Executes the blok on the items of \a items_ through
+    /// AbstractBlok::process_batch().
+    void
+    execute_batch
+    (
+        const DataBatch& items_
+    );
+
 private:
 
     /// \cond INTERNAL
@@ -49,6 +49,34 @@ const
     )->lock_input(index_);
 }
 
+SharedData
+AbstractFilter::lock_input
+(
+    Index index_,
+    const Piece& piece_
+)
+const
+{
+    return AbstractBlok::Private::from(
+        this
+    )->lock_input(
+        index_,
+        piece_
+    );
+}
+
+SharedDataSequence
+AbstractFilter::lock_inputs
+(
+    const IndexSequence& indexes_
+)
+const
+{
+    return AbstractBlok::Private::from(
+        this
+    )->lock_inputs(indexes_);
+}
+
 bool
 AbstractFilter::set_input
 (
@@ -52,6 +52,30 @@ public:
     )
     const;
 
+    /// Pulls \a piece_ from the input \a index_ and returns the input.
+    ///
+    /// \sa AbstractBlok::pull_input().
+    SharedData
+    lock_input
+    (
+        Index index_,
+        const Piece& piece_
+    )
+    const;
+
+    /// Pulls the inputs \a indexes_ concurrently and returns them, in the
+    /// same order.
+    ///
+    /// Each input is pulled by a thread of a pool shared by the library, so
+    /// that independent upstream branches are processed in parallel; the
+    /// function returns once all of them were pulled.
+    SharedDataSequence
+    lock_inputs
+    (
+        const IndexSequence& indexes_
+    )
+    const;
+
     bool
     set_input
     (
@@ -20,11 +20,11 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractobject.h>
 
+#include <atomic>
+
 namespace sb
 {
 
-using NameToPropertyMap = std::map<std::string, ObjectProperty>;
-
 class SB_DECL_HIDDEN AbstractObject::Private
 {
 
@@ -57,9 +57,15 @@ public:
     StringSequence
     type_names;
 
-    NameToPropertyMap
+    std::shared_ptr<const NameToPropertyMap>
     properties;
 
+    Size
+    serial;
+
+    std::atomic<Size>
+    observer_count;
+
 };
 
 }
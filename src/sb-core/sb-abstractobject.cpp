@@ -19,6 +19,13 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractobject-private.h>
 
+#include <typeindex>
+
+#include <sb-core/sb-abstractdata-private.h>
+#include <sb-core/sb-event-private.h>
+#include <sb-core/sb-memocache.h>
+#include <sb-core/sb-propertytransaction.h>
+
 namespace sb
 {
 
@@ -35,6 +42,9 @@ object_factories;
 NameToObjectFormatMap
 object_formats;
 
+std::atomic<Size>
+object_serial(0);
+
 }
 
 namespace Unmapper
@@ -88,6 +98,11 @@ AbstractObject::~AbstractObject
 (
 )
 {
+    if(d_ptr->observer_count != 0)
+    {
+        ObserverRegistry::remove_all(d_ptr->serial);
+    }
+
     delete d_ptr;
 }
 
@@ -109,30 +124,68 @@ AbstractObject::get
 )
 const
 {
-    ObjectProperty wanted_property = d_ptr->properties.at(name_);
+    return this->get_property(name_, AccessRights::READ).get(*this);
+}
 
-    // check access rights
+Index
+AbstractObject::subscribe
+(
+    const Observer& observer_
+)
+{
+    ++d_ptr->observer_count;
 
-    if(
-        !bitmask(
-            wanted_property.access_rights
-        ).is_set(
-            AccessRights::READ
-        )
-    )
+    return ObserverRegistry::add(d_ptr->serial, observer_);
+}
+
+bool
+AbstractObject::unsubscribe
+(
+    Index id_
+)
+{
+    bool unsubscribed = ObserverRegistry::remove(d_ptr->serial, id_);
+
+    if(unsubscribed)
     {
-        throw std::invalid_argument(
-            std::string() +
-            "sb::AbstractBlok::get: " +
-            "calling on property " +
-            name_ +
-            " which is write-only"
+        --d_ptr->observer_count;
+    }
+
+    return unsubscribed;
+}
+
+void
+AbstractObject::set_many
+(
+    const PropertyValueSequence& values_
+)
+{
+    // check every value first: a failure sets none of them
+
+    for(const auto& name_value : values_)
+    {
+        const ObjectProperty& property = this->get_property(
+            name_value.first,
+            AccessRights::WRITE
         );
+
+        if(
+            std::type_index(name_value.second.get_type_info()) !=
+                property.type
+        )
+        {
+            throw BadAnyCast();
+        }
     }
 
-    // call the accessor
+    PropertyTransaction transaction;
+
+    for(const auto& name_value : values_)
+    {
+        this->set(name_value.first, name_value.second);
+    }
 
-    return wanted_property.get(*this);
+    transaction.commit();
 }
 
 void
@@ -142,7 +195,20 @@ AbstractObject::set
     const Any& value_
 )
 {
-    ObjectProperty wanted_property = d_ptr->properties.at(name_);
+    this->get_property(name_, AccessRights::WRITE).set(*this, value_);
+
+    this->on_property_set(name_);
+}
+
+const ObjectProperty&
+AbstractObject::get_property
+(
+    const std::string& name_,
+    AccessRights access_rights_
+)
+const
+{
+    const ObjectProperty& wanted_property = d_ptr->properties->at(name_);
 
     // check access rights
 
@@ -150,42 +216,51 @@ AbstractObject::set
         !bitmask(
             wanted_property.access_rights
         ).is_set(
-            AccessRights::WRITE
+            access_rights_
         )
     )
     {
+        bool reading = (access_rights_ == AccessRights::READ);
+
         throw std::invalid_argument(
             std::string() +
-            "sb::AbstractBlok::set: " +
+            (reading ? "sb::AbstractBlok::get: " : "sb::AbstractBlok::set: ") +
             "calling on property " +
             name_ +
-            " which is read-only"
+            (reading ? " which is write-only" : " which is read-only")
         );
     }
 
-    // call the accessor
-
-    wanted_property.set(*this, value_);
+    return wanted_property;
 }
 
 void
-AbstractObject::init
+AbstractObject::on_property_set
+(
+    const std::string& name_
+)
+{
+    if(d_ptr->observer_count.load(std::memory_order_relaxed) != 0)
+    {
+        EventQueue::post(
+            d_ptr->serial,
+            Event{Event::Type::PROPERTY_CHANGED, this, name_, 0}
+        );
+    }
+}
+
+std::shared_ptr<const NameToPropertyMap>
+AbstractObject::make_property_table
 (
-    AbstractObject* this_,
-    const StringSequence& type_names_,
     const ObjectPropertySequence& properties_
 )
 {
-    auto d_ptr = AbstractObject::Private::from(
-        this_
-    );
-    
-    d_ptr->type_names = type_names_;
+    auto properties = std::make_shared<NameToPropertyMap>();
 
-    for(auto property : properties_)
+    for(const auto& property : properties_)
     {
         if(
-            ! d_ptr->properties.emplace(
+            ! properties->emplace(
                 property.name,
                 property
             ).second
@@ -202,6 +277,24 @@ AbstractObject::init
         }
     }
 
+    return properties;
+}
+
+void
+AbstractObject::init
+(
+    AbstractObject* this_,
+    const StringSequence& type_names_,
+    const std::shared_ptr<const NameToPropertyMap>& properties_
+)
+{
+    auto d_ptr = AbstractObject::Private::from(
+        this_
+    );
+    
+    d_ptr->type_names = type_names_;
+    d_ptr->properties = properties_;
+
     this_->init();
 }
 
@@ -238,7 +331,10 @@ AbstractObject::Private::Private
 (
     AbstractObject* q_ptr_
 ):
-    q_ptr   (q_ptr_)
+    q_ptr           (q_ptr_),
+    properties      (std::make_shared<NameToPropertyMap>()),
+    serial          (++Global::object_serial),
+    observer_count  (0)
 {
 }
 
@@ -346,6 +442,13 @@ sb::unregister_all_objects
 (
 )
 {
+    // cached and pooled data were created by the registered factories:
+    // release them first
+
+    clear_memo_cache();
+
+    AbstractData::Private::clear_pools();
+
     Global::object_factories.clear();
     Global::object_formats.clear();
 }
@@ -20,6 +20,8 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-objectformat.h>
 
+#include <sb-core/sb-event.h>
+
 #include <functional>
 #include <map>
 #include <type_traits>
@@ -29,6 +31,13 @@ namespace sb
 
 using ObjectFactory = std::function<Unique<AbstractObject>(void)>;
 
+/// \cond INTERNAL
+using NameToPropertyMap = std::map<std::string, Property<AbstractObject>>;
+/// \endcond
+
+/// Alias for a sequence of property names associated with values.
+using PropertyValueSequence = std::vector<std::pair<std::string, Any>>;
+
 /// \brief The AbstractObject class is the base class for all Softbloks
 /// objects.
 ///
@@ -150,9 +159,10 @@ public:
     )
     const
     {
-        return any_cast<T>(
-            this->get(name_)
-        );
+        return this->get_property(
+            name_,
+            AccessRights::READ
+        ).template get_as<T>(*this);
     }
 
     /// Sets the property \a name_ to \a value_.
@@ -171,9 +181,56 @@ public:
         const T& value_
     )
     {
-        this->set(name_, Any(value_));
+        this->get_property(
+            name_,
+            AccessRights::WRITE
+        ).set_as(*this, value_);
+
+        this->on_property_set(name_);
     }
 
+    /// Subscribes \a observer_ to the events of this object and returns the
+    /// identifier of the subscription.
+    ///
+    /// Observers are not called by the thread changing the object: they are
+    /// called by dispatch_events().
+    ///
+    /// \sa unsubscribe().
+    Index
+    subscribe
+    (
+        const Observer& observer_
+    );
+
+    /// Cancels the subscription \a id_.
+    ///
+    /// The function returns \b true if \a id_ was a subscription to this
+    /// object; it returns \b false otherwise.
+    ///
+    /// \sa subscribe().
+    bool
+    unsubscribe
+    (
+        Index id_
+    );
+
+    /// Sets each property of \a values_ to its associated value, within a
+    /// single PropertyTransaction.
+    ///
+    /// \code{cpp}
+    /// blok->set_many({
+    ///     {"text", sb::Any(std::string("Hello"))},
+    ///     {"multiplier", sb::Any(3)}
+    /// });
+    /// \endcode
+    ///
+    /// \sa set().
+    void
+    set_many
+    (
+        const PropertyValueSequence& values_
+    );
+
     static
     StringSequence
     get_type_names
@@ -201,10 +258,17 @@ public:
         AbstractObject* this_
     )
     {
+        // the properties of a type are gathered once, then shared by all its
+        // instances
+        static const std::shared_ptr<const NameToPropertyMap> properties =
+            AbstractObject::make_property_table(
+                T::get_properties()
+            );
+
         AbstractObject::init(
             this_,
             T::get_type_names(),
-            T::get_properties()
+            properties
         );
     }
     /// \endcond
@@ -241,6 +305,33 @@ private:
     );
     /// \endcond
 
+    /// \cond INTERNAL
+    const Property<AbstractObject>&
+    get_property
+    (
+        const std::string& name_,
+        AccessRights access_rights_
+    )
+    const;
+    /// \endcond
+
+    /// \cond INTERNAL
+    void
+    on_property_set
+    (
+        const std::string& name_
+    );
+    /// \endcond
+
+    /// \cond INTERNAL
+    static
+    std::shared_ptr<const NameToPropertyMap>
+    make_property_table
+    (
+        const PropertySequence<AbstractObject>& properties_
+    );
+    /// \endcond
+
     /// \cond INTERNAL
     static
     void
@@ -248,7 +339,7 @@ private:
     (
         AbstractObject* this_,
         const StringSequence& type_names_,
-        const PropertySequence<AbstractObject>& properties_
+        const std::shared_ptr<const NameToPropertyMap>& properties_
     );
     /// \endcond
 
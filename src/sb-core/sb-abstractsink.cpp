@@ -49,6 +49,34 @@ const
     )->lock_input(index_);
 }
 
+SharedData
+AbstractSink::lock_input
+(
+    Index index_,
+    const Piece& piece_
+)
+const
+{
+    return AbstractBlok::Private::from(
+        this
+    )->lock_input(
+        index_,
+        piece_
+    );
+}
+
+SharedDataSequence
+AbstractSink::lock_inputs
+(
+    const IndexSequence& indexes_
+)
+const
+{
+    return AbstractBlok::Private::from(
+        this
+    )->lock_inputs(indexes_);
+}
+
 bool
 AbstractSink::set_input
 (
@@ -64,6 +92,40 @@ AbstractSink::set_input
     );
 }
 
+void
+AbstractSink::set_active
+(
+    bool value_
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(
+        this
+    );
+
+    if(blok_d_ptr->active != value_)
+    {
+        blok_d_ptr->active = value_;
+
+        AbstractBlok::Private::on_graph_changed();
+
+        if(value_)
+        {
+            blok_d_ptr->catch_up();
+        }
+    }
+}
+
+bool
+AbstractSink::is_active
+(
+)
+const
+{
+    return AbstractBlok::Private::from(
+        this
+    )->active;
+}
+
 AbstractSink::Private::Private
 (
     AbstractSink* q_ptr_
@@ -52,6 +52,30 @@ public:
     )
     const;
 
+    /// Pulls \a piece_ from the input \a index_ and returns the input.
+    ///
+    /// \sa AbstractBlok::pull_input().
+    SharedData
+    lock_input
+    (
+        Index index_,
+        const Piece& piece_
+    )
+    const;
+
+    /// Pulls the inputs \a indexes_ concurrently and returns them, in the
+    /// same order.
+    ///
+    /// Each input is pulled by a thread of a pool shared by the library, so
+    /// that independent upstream branches are processed in parallel; the
+    /// function returns once all of them were pulled.
+    SharedDataSequence
+    lock_inputs
+    (
+        const IndexSequence& indexes_
+    )
+    const;
+
     bool
     set_input
     (
@@ -59,6 +83,30 @@ public:
         const SharedData& value_
     );
 
+    /// Declares whether this sink is currently read, e.g. whether the widget
+    /// displaying it is visible.
+    ///
+    /// Pushes only propagate along the paths leading to at least one active
+    /// sink: the bloks reaching inactive sinks only are left stale, and catch
+    /// up when one of these sinks is activated again. Bloks whose outputs
+    /// have no followers are always updated. Sinks are active by default.
+    ///
+    /// \sa is_active().
+    void
+    set_active
+    (
+        bool value_
+    );
+
+    /// Returns \b true if this sink is active; returns \b false otherwise.
+    ///
+    /// \sa set_active().
+    bool
+    is_active
+    (
+    )
+    const;
+
 private:
 
     /// \cond INTERNAL
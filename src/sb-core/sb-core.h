@@ -27,10 +27,19 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 #include <sb-core/sb-abstractsoft.h>
 #include <sb-core/sb-abstractsource.h>
 #include <sb-core/sb-coredefine.h>
+#include <sb-core/sb-coroutine.h>
 #include <sb-core/sb-data.h>
+#include <sb-core/sb-event.h>
+#include <sb-core/sb-eventloop.h>
 #include <sb-core/sb-executive.h>
+#include <sb-core/sb-executor.h>
+#include <sb-core/sb-memocache.h>
 #include <sb-core/sb-objectformat.h>
+#include <sb-core/sb-piece.h>
 #include <sb-core/sb-property.h>
+#include <sb-core/sb-propertytransaction.h>
 #include <sb-core/sb-propertyformat.h>
+#include <sb-core/sb-serialization.h>
+#include <sb-core/sb-sharedmemory.h>
 
 #endif // SB_CORE_H
@@ -64,6 +64,9 @@ using Index = Size;
 /// Alias for a sequence container of strings.
 using StringSequence = std::vector<std::string>;
 
+/// Alias for a sequence container of positions.
+using IndexSequence = std::vector<Index>;
+
 /// \brief This enum describes a bitmask for access rights.
 ///
 /// The applicable operators for this enum are overloaded using
@@ -0,0 +1,443 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_COROUTINE_H
+#define SB_COROUTINE_H
+
+#include <sb-core/sb-abstractblok.h>
+#include <sb-core/sb-eventloop.h>
+
+// coroutines are available to C++20 translation units only: the library
+// itself is built without them
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace sb
+{
+
+/// \brief The AsyncTask class is the return type of the coroutines
+/// implementing AbstractBlok::process_async().
+///
+/// A task starts suspended; start() runs it until its first suspension and
+/// calls the given completion once it returns or raises an exception:
+///
+/// \code
+/// AsyncTask
+/// read_input
+/// (
+/// )
+/// {
+///     co_await wait_readable(*this->loop, this->fd);
+///
+///     // read fd and update the outputs
+/// }
+///
+/// void
+/// process_async
+/// (
+///     const AsyncCompletion& completion_
+/// )
+/// override
+/// {
+///     this->read_input().start(completion_);
+/// }
+/// \endcode
+///
+/// A blok must not be destroyed while one of its tasks is suspended.
+class AsyncTask
+{
+
+public:
+
+    /// \cond INTERNAL
+    struct promise_type;
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // destroys the coroutine, then calls its completion
+
+    struct FinalAwaiter
+    {
+
+        bool
+        await_ready
+        (
+        )
+        noexcept
+        {
+            return false;
+        }
+
+        void
+        await_suspend
+        (
+            Handle handle_
+        )
+        noexcept
+        {
+            AsyncCompletion completion = std::move(
+                handle_.promise().completion
+            );
+            std::exception_ptr error = handle_.promise().error;
+
+            handle_.destroy();
+
+            if(completion)
+            {
+                completion(error);
+            }
+        }
+
+        void
+        await_resume
+        (
+        )
+        noexcept
+        {
+        }
+
+    };
+
+    struct promise_type
+    {
+
+        AsyncTask
+        get_return_object
+        (
+        )
+        {
+            return AsyncTask(Handle::from_promise(*this));
+        }
+
+        std::suspend_always
+        initial_suspend
+        (
+        )
+        noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter
+        final_suspend
+        (
+        )
+        noexcept
+        {
+            return {};
+        }
+
+        void
+        return_void
+        (
+        )
+        {
+        }
+
+        void
+        unhandled_exception
+        (
+        )
+        {
+            this->error = std::current_exception();
+        }
+
+        AsyncCompletion
+        completion;
+
+        std::exception_ptr
+        error;
+
+    };
+    /// \endcond
+
+    AsyncTask
+    (
+        AsyncTask&& other_
+    )
+    noexcept:
+        handle(std::exchange(other_.handle, nullptr))
+    {
+    }
+
+    AsyncTask&
+    operator=
+    (
+        AsyncTask&& other_
+    )
+    noexcept
+    {
+        std::swap(this->handle, other_.handle);
+
+        return *this;
+    }
+
+    /// Destroys this object, and the coroutine if it wasn't started.
+    ~AsyncTask
+    (
+    )
+    {
+        if(this->handle)
+        {
+            this->handle.destroy();
+        }
+    }
+
+    /// Runs the coroutine until its first suspension; \a completion_ is
+    /// called once it completes.
+    void
+    start
+    (
+        const AsyncCompletion& completion_
+    )
+    {
+        Handle handle = std::exchange(this->handle, nullptr);
+
+        if(handle)
+        {
+            handle.promise().completion = completion_;
+
+            handle.resume();
+        }
+    }
+
+private:
+
+    explicit
+    AsyncTask
+    (
+        Handle handle_
+    ):
+        handle(handle_)
+    {
+    }
+
+    Handle
+    handle;
+
+};
+
+/// \cond INTERNAL
+
+// resumes a coroutine from the first call of a watch, then removes it; a
+// zero delay doesn't suspend
+
+class WatchAwaiter
+{
+
+public:
+
+    WatchAwaiter
+    (
+        EventLoop& loop_,
+        Size period_,
+        int fd_
+    ):
+        loop(loop_),
+        period(period_),
+        fd(fd_)
+    {
+    }
+
+    bool
+    await_ready
+    (
+    )
+    const
+    noexcept
+    {
+        // loop timers can't have a zero period
+
+        return this->fd < 0 && this->period == 0;
+    }
+
+    void
+    await_suspend
+    (
+        std::coroutine_handle<> handle_
+    )
+    {
+        auto id = std::make_shared<Size>(0);
+
+        EventLoop* loop = &this->loop;
+
+        EventCallback callback = [loop, id, handle_]()
+        {
+            loop->remove(*id);
+
+            handle_.resume();
+        };
+
+        *id = (
+            this->fd < 0
+        ) ? (
+            this->loop.add_timer(this->period, callback)
+        ) : (
+            this->loop.add_fd(this->fd, callback)
+        );
+
+        if(*id == 0)
+        {
+            throw std::invalid_argument(
+                std::string() +
+                "sb::WatchAwaiter::await_suspend: " +
+                "failed to add a watch to the loop"
+            );
+        }
+    }
+
+    void
+    await_resume
+    (
+    )
+    const
+    noexcept
+    {
+    }
+
+private:
+
+    EventLoop&
+    loop;
+
+    Size
+    period;
+
+    int
+    fd;
+
+};
+
+// resumes a coroutine from the thread dispatching the watches of a loop
+
+class PostAwaiter
+{
+
+public:
+
+    explicit
+    PostAwaiter
+    (
+        EventLoop& loop_
+    ):
+        loop(loop_)
+    {
+    }
+
+    bool
+    await_ready
+    (
+    )
+    const
+    noexcept
+    {
+        return false;
+    }
+
+    void
+    await_suspend
+    (
+        std::coroutine_handle<> handle_
+    )
+    {
+        bool is_posted = this->loop.post(
+            [handle_]()
+            {
+                handle_.resume();
+            }
+        );
+
+        if(!is_posted)
+        {
+            throw std::invalid_argument(
+                std::string() +
+                "sb::PostAwaiter::await_suspend: " +
+                "failed to post to the loop"
+            );
+        }
+    }
+
+    void
+    await_resume
+    (
+    )
+    const
+    noexcept
+    {
+    }
+
+private:
+
+    EventLoop&
+    loop;
+
+};
+
+/// \endcond
+
+/// Suspends the calling coroutine for \a delay_ milliseconds; \a loop_
+/// resumes it. A zero \a delay_ doesn't suspend the coroutine.
+inline
+WatchAwaiter
+sleep_for
+(
+    EventLoop& loop_,
+    Size delay_
+)
+{
+    return WatchAwaiter(loop_, delay_, -1);
+}
+
+/// Suspends the calling coroutine until \a fd_ is readable; \a loop_
+/// resumes it.
+inline
+WatchAwaiter
+wait_readable
+(
+    EventLoop& loop_,
+    int fd_
+)
+{
+    return WatchAwaiter(loop_, 0, fd_);
+}
+
+/// Suspends the calling coroutine until \a loop_ resumes it, at its next
+/// dispatch.
+///
+/// A coroutine whose work continued in another thread, e.g. waiting for a
+/// computation, goes back to the thread owning its blok this way.
+inline
+PostAwaiter
+resume_on
+(
+    EventLoop& loop_
+)
+{
+    return PostAwaiter(loop_);
+}
+
+}
+
+#endif
+
+#endif // SB_COROUTINE_H
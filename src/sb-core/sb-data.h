@@ -20,11 +20,78 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-abstractdata.h>
 
+#include <sb-core/sb-serialization.h>
+
 #include <sstream>
 
 namespace sb
 {
 
+/// \cond INTERNAL
+namespace DataTraits
+{
+
+    // clear containers, keeping their capacity
+
+    template<typename T>
+    inline
+    auto
+    clear
+    (
+        T& value_,
+        int
+    )
+    -> decltype(value_.clear(), void())
+    {
+        value_.clear();
+    }
+
+    // reset other values, as held by a new data
+
+    template<typename T>
+    inline
+    void
+    clear
+    (
+        T& value_,
+        long
+    )
+    {
+        value_ = T();
+    }
+
+    // count the elements of contiguous containers
+
+    template<typename T>
+    inline
+    auto
+    get_byte_size
+    (
+        const T& value_,
+        int
+    )
+    -> decltype(value_.data(), value_.size(), Size())
+    {
+        return value_.size() * sizeof(*value_.data());
+    }
+
+    // other values have no dynamic size
+
+    template<typename T>
+    inline
+    Size
+    get_byte_size
+    (
+        const T& /*value_*/,
+        long
+    )
+    {
+        return 0;
+    }
+
+}
+/// \endcond
+
 template<typename Type>
 class Data : public AbstractData
 {
@@ -62,6 +129,50 @@ public:
     )
     {
         this->value = value_;
+
+        this->update_version();
+    }
+
+    virtual
+    bool
+    copy
+    (
+        const AbstractData& other_
+    )
+    SB_OVERRIDE
+    {
+        const Data* other = dynamic_cast<const Data*>(&other_);
+
+        if(other)
+        {
+            this->set_value(other->value);
+        }
+
+        return other != SB_NULLPTR;
+    }
+
+    virtual
+    Size
+    get_byte_size
+    (
+    )
+    const
+    SB_OVERRIDE
+    {
+        return sizeof(Data) + DataTraits::get_byte_size(this->value, 0);
+    }
+
+    /// Clears the value of this data if it provides a clear() method, so
+    /// that a recycled container keeps its capacity; resets the value to
+    /// Type() otherwise, as held by a new data.
+    virtual
+    void
+    recycle
+    (
+    )
+    SB_OVERRIDE
+    {
+        DataTraits::clear(this->value, 0);
     }
 
 private:
@@ -71,13 +182,31 @@ private:
 
 };
 
+/// Registers the type Data<T> as an instantiable data, enables its pool and
+/// registers the codec of \a T.
+///
+/// The function returns \b true if there was no previously registered data
+/// for the type \a T; it returns \b false otherwise.
+///
+/// \sa register_object(), enable_data_pool() and register_codec().
 template<typename T>
 bool
 register_data
 (
 )
 {
-    return register_object<Data<T>>();
+    bool registered = register_object<Data<T>>();
+
+    if(registered)
+    {
+        enable_data_pool(
+            get_type_name<Data<T>>()
+        );
+
+        register_codec<T>();
+    }
+
+    return registered;
 }
 
 }
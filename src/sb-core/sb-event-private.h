@@ -0,0 +1,144 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EVENT_PRIVATE_H
+#define SB_EVENT_PRIVATE_H
+
+#include <sb-core/sb-event.h>
+
+#include <atomic>
+#include <vector>
+
+namespace sb
+{
+
+struct SB_DECL_HIDDEN QueuedEvent
+{
+
+    // identifies the object among its successors at the same address
+
+    Size
+    serial;
+
+    Event
+    event;
+
+};
+
+struct SB_DECL_HIDDEN EventNode
+{
+
+    QueuedEvent
+    value;
+
+    std::atomic<EventNode*>
+    next;
+
+};
+
+// unbounded single-producer single-consumer queue: the producer only touches
+// the tail, the consumer only touches the head
+
+class SB_DECL_HIDDEN EventQueue
+{
+
+public:
+
+    EventQueue
+    (
+    );
+
+    ~EventQueue
+    (
+    );
+
+    // called by the producer thread only
+
+    void
+    push
+    (
+        const QueuedEvent& value_
+    );
+
+    // called by the consumer thread only
+
+    bool
+    pop
+    (
+        QueuedEvent& value_
+    );
+
+    // queues the event in the queue of the current thread
+
+    static
+    void
+    post
+    (
+        Size serial_,
+        const Event& event_
+    );
+
+private:
+
+    EventNode*
+    head;
+
+    EventNode*
+    tail;
+
+};
+
+class SB_DECL_HIDDEN ObserverRegistry
+{
+
+public:
+
+    static
+    Index
+    add
+    (
+        Size serial_,
+        const Observer& observer_
+    );
+
+    static
+    bool
+    remove
+    (
+        Size serial_,
+        Index id_
+    );
+
+    static
+    void
+    remove_all
+    (
+        Size serial_
+    );
+
+    static
+    std::vector<Observer>
+    get
+    (
+        Size serial_
+    );
+
+};
+
+}
+
+#endif // SB_EVENT_PRIVATE_H
@@ -0,0 +1,344 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-event.h>
+
+#include <sb-core/sb-event-private.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+namespace sb
+{
+
+using EventQueueSequence = std::vector<std::shared_ptr<EventQueue>>;
+
+using IdToObserverMap = std::map<Index, Observer>;
+
+using SerialToObserversMap = std::map<Size, IdToObserverMap>;
+
+namespace Global
+{
+
+// queues of the threads which posted events; a queue outlives its thread
+// until it is drained
+
+std::mutex
+event_queues_mutex;
+
+EventQueueSequence
+event_queues;
+
+// the queues have a single consumer: held while they are drained
+
+std::mutex
+event_dispatch_mutex;
+
+std::mutex
+observers_mutex;
+
+SerialToObserversMap
+observers;
+
+Index
+next_observer_id = 0;
+
+}
+
+}
+
+using namespace sb;
+
+Size
+sb::dispatch_events
+(
+)
+{
+    std::vector<QueuedEvent> batch;
+
+    std::set<std::tuple<Size, Event::Type, std::string, Index>> keys;
+
+    // drains queue_, coalescing repeated events
+
+    auto drain = [&batch, &keys]
+    (
+        EventQueue& queue_
+    )
+    {
+        QueuedEvent value;
+
+        while(queue_.pop(value))
+        {
+            if(
+                keys.insert(
+                    std::make_tuple(
+                        value.serial,
+                        value.event.type,
+                        value.event.name,
+                        value.event.index
+                    )
+                ).second
+            )
+            {
+                batch.push_back(value);
+            }
+        }
+    };
+
+    {
+        // concurrent calls drain the queues one after the other; the
+        // observers are called out of the lock, so that they can dispatch
+        // events themselves
+
+        std::lock_guard<std::mutex> dispatch_lock(
+            Global::event_dispatch_mutex
+        );
+
+        EventQueueSequence queues;
+
+        {
+            std::lock_guard<std::mutex> lock(Global::event_queues_mutex);
+
+            queues = Global::event_queues;
+        }
+
+        for(const auto& queue : queues)
+        {
+            drain(*queue);
+        }
+
+        // forget the queues of finished threads, once drained of the events
+        // they posted since the previous drain
+
+        std::lock_guard<std::mutex> lock(Global::event_queues_mutex);
+
+        for(const auto& queue : queues)
+        {
+            if(queue.use_count() == 2)
+            {
+                // the thread released the queue after its last push
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                drain(*queue);
+
+                Global::event_queues.erase(
+                    std::find(
+                        Global::event_queues.begin(),
+                        Global::event_queues.end(),
+                        queue
+                    )
+                );
+            }
+        }
+    }
+
+    // deliver the events; observers are copied so that they can subscribe
+    // or unsubscribe
+
+    Size delivered = 0;
+
+    for(const auto& value : batch)
+    {
+        // events of destroyed objects have no observers anymore
+
+        auto observers = ObserverRegistry::get(value.serial);
+
+        for(const auto& observer : observers)
+        {
+            observer(value.event);
+        }
+
+        if(!observers.empty())
+        {
+            ++delivered;
+        }
+    }
+
+    return delivered;
+}
+
+EventQueue::EventQueue
+(
+)
+{
+    // the head is always a consumed node
+
+    this->head = this->tail = new EventNode();
+
+    this->head->next.store(SB_NULLPTR);
+}
+
+EventQueue::~EventQueue
+(
+)
+{
+    while(this->head)
+    {
+        EventNode* next = this->head->next.load();
+
+        delete this->head;
+
+        this->head = next;
+    }
+}
+
+void
+EventQueue::push
+(
+    const QueuedEvent& value_
+)
+{
+    EventNode* node = new EventNode();
+
+    node->value = value_;
+    node->next.store(SB_NULLPTR, std::memory_order_relaxed);
+
+    // publish the node
+
+    this->tail->next.store(node, std::memory_order_release);
+
+    this->tail = node;
+}
+
+bool
+EventQueue::pop
+(
+    QueuedEvent& value_
+)
+{
+    EventNode* next = this->head->next.load(std::memory_order_acquire);
+
+    if(next)
+    {
+        value_ = std::move(next->value);
+
+        delete this->head;
+
+        this->head = next;
+    }
+
+    return next != SB_NULLPTR;
+}
+
+void
+EventQueue::post
+(
+    Size serial_,
+    const Event& event_
+)
+{
+    static SB_THREAD_LOCAL std::shared_ptr<EventQueue> queue;
+
+    if(!queue)
+    {
+        // register the queue of this thread on its first event
+
+        queue.reset(new EventQueue());
+
+        std::lock_guard<std::mutex> lock(Global::event_queues_mutex);
+
+        Global::event_queues.push_back(queue);
+    }
+
+    queue->push(
+        QueuedEvent{serial_, event_}
+    );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Index
+ObserverRegistry::add
+(
+    Size serial_,
+    const Observer& observer_
+)
+{
+    std::lock_guard<std::mutex> lock(Global::observers_mutex);
+
+    Index id = Global::next_observer_id++;
+
+    Global::observers[serial_][id] = observer_;
+
+    return id;
+}
+
+bool
+ObserverRegistry::remove
+(
+    Size serial_,
+    Index id_
+)
+{
+    std::lock_guard<std::mutex> lock(Global::observers_mutex);
+
+    bool removed = false;
+
+    auto found_observers = Global::observers.find(serial_);
+
+    if(found_observers != Global::observers.end())
+    {
+        removed = found_observers->second.erase(id_) != 0;
+
+        if(found_observers->second.empty())
+        {
+            Global::observers.erase(found_observers);
+        }
+    }
+
+    return removed;
+}
+
+void
+ObserverRegistry::remove_all
+(
+    Size serial_
+)
+{
+    std::lock_guard<std::mutex> lock(Global::observers_mutex);
+
+    Global::observers.erase(serial_);
+}
+
+std::vector<Observer>
+ObserverRegistry::get
+(
+    Size serial_
+)
+{
+    std::lock_guard<std::mutex> lock(Global::observers_mutex);
+
+    std::vector<Observer> observers;
+
+    auto found_observers = Global::observers.find(serial_);
+
+    if(found_observers != Global::observers.end())
+    {
+        for(const auto& id_observer : found_observers->second)
+        {
+            observers.push_back(id_observer.second);
+        }
+    }
+
+    return observers;
+}
@@ -0,0 +1,87 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EVENT_H
+#define SB_EVENT_H
+
+#include <sb-core/sb-coredefine.h>
+
+#include <functional>
+#include <string>
+
+namespace sb
+{
+
+class AbstractObject;
+
+/// \brief The Event structure describes a change observed on an object.
+///
+/// \sa AbstractObject::subscribe() and dispatch_events().
+struct Event
+{
+
+    /// This enum describes the kinds of events.
+    enum class Type
+    {
+        /// A property was set through AbstractObject::set().
+        PROPERTY_CHANGED,
+        /// An output of a blok was updated by an execution.
+        OUTPUT_UPDATED
+    };
+
+    Type
+    type;
+
+    /// The object which changed. It is valid while the object is subscribed
+    /// to, i.e. until the object is destroyed.
+    AbstractObject*
+    object;
+
+    /// The name of the changed property, for PROPERTY_CHANGED events.
+    std::string
+    name;
+
+    /// The index of the updated output, for OUTPUT_UPDATED events.
+    Index
+    index;
+
+};
+
+/// Alias for a function observing events.
+using Observer = std::function<void(const Event&)>;
+
+/// Delivers the events queued since the last call to their observers, and
+/// returns the number of delivered events.
+///
+/// Events are queued by the threads changing the objects, in a lock-free
+/// queue per thread: the producer threads never wait for the observers.
+/// This function drains the queues in the calling thread, typically a GUI
+/// thread calling it periodically. Repeated events on the same property or
+/// the same output are coalesced in a single delivery. Concurrent calls
+/// drain the queues one after the other, and the events posted by a thread
+/// before it exits are still delivered.
+///
+/// \sa AbstractObject::subscribe().
+SB_CORE_API
+Size
+dispatch_events
+(
+);
+
+}
+
+#endif // SB_EVENT_H
@@ -0,0 +1,158 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EVENTLOOP_PRIVATE_H
+#define SB_EVENTLOOP_PRIVATE_H
+
+#include <sb-core/sb-eventloop.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace sb
+{
+
+// a timer or a file descriptor watched by a loop
+
+struct SB_DECL_HIDDEN Watch
+{
+
+    int
+    fd;
+
+    // timers own their timerfd
+
+    bool
+    is_timer;
+
+    EventCallback
+    callback;
+
+};
+
+class SB_DECL_HIDDEN EventLoop::Private
+{
+
+public:
+
+    Private
+    (
+        EventLoop* q_ptr_
+    );
+
+    ~Private
+    (
+    );
+
+    // adds fd_ to the epoll set; returns 0 on failure
+
+    Size
+    add_watch
+    (
+        int fd_,
+        bool is_timer_,
+        const EventCallback& callback_
+    );
+
+public:
+
+    EventLoop*
+    q_ptr;
+
+    int
+    epoll_fd;
+
+    // written by stop() to wake the loop up
+
+    int
+    wake_fd;
+
+    Size
+    last_id;
+
+    std::map<Size, Watch>
+    watches;
+
+    std::atomic<bool>
+    is_stopping;
+
+    // the fields below are guarded by posted_mutex
+
+    std::mutex
+    posted_mutex;
+
+    std::vector<EventCallback>
+    posted_callbacks;
+
+};
+
+class SB_DECL_HIDDEN EventLoopExecutive::Private
+{
+
+public:
+
+    Private
+    (
+        EventLoopExecutive* q_ptr_
+    );
+
+    // registers the watches with loop, after removing the previous ones
+
+    void
+    watch
+    (
+    );
+
+    void
+    unwatch
+    (
+    );
+
+    // processes the blok from the loop
+
+    void
+    on_event
+    (
+    );
+
+public:
+
+    EventLoopExecutive*
+    q_ptr;
+
+    EventLoop*
+    loop;
+
+    Size
+    period;
+
+    int
+    fd;
+
+    Size
+    timer_id;
+
+    Size
+    fd_id;
+
+};
+
+}
+
+#endif // SB_EVENTLOOP_PRIVATE_H
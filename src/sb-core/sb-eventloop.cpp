@@ -0,0 +1,585 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-eventloop.h>
+
+#include <sb-core/sb-eventloop-private.h>
+
+#include <cstdint>
+#include <vector>
+
+#if SB_OS_IS_LINUX
+#   include <sys/epoll.h>
+#   include <sys/eventfd.h>
+#   include <sys/timerfd.h>
+#   include <unistd.h>
+#endif
+
+#include <sb-core/sb-abstractexecutive-private.h>
+
+namespace sb
+{
+
+namespace Global
+{
+
+// maximum number of watches dispatched by a single wait
+
+const int MAX_READY_WATCHES = 64;
+
+}
+
+EventLoop::EventLoop
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+EventLoop::~EventLoop
+(
+)
+{
+    delete d_ptr;
+}
+
+bool
+EventLoop::is_valid
+(
+)
+const
+{
+    return d_ptr->epoll_fd >= 0;
+}
+
+Size
+EventLoop::add_timer
+(
+    Size period_,
+    const EventCallback& callback_
+)
+{
+#if SB_OS_IS_LINUX
+    if(!this->is_valid() || period_ == 0)
+    {
+        return 0;
+    }
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    if(fd < 0)
+    {
+        return 0;
+    }
+
+    itimerspec spec;
+
+    spec.it_interval.tv_sec = period_ / 1000;
+    spec.it_interval.tv_nsec = (period_ % 1000) * 1000000;
+    spec.it_value = spec.it_interval;
+
+    Size id = 0;
+
+    if(timerfd_settime(fd, 0, &spec, SB_NULLPTR) == 0)
+    {
+        id = d_ptr->add_watch(fd, true, callback_);
+    }
+
+    if(id == 0)
+    {
+        close(fd);
+    }
+
+    return id;
+#else
+    (void)period_;
+    (void)callback_;
+
+    return 0;
+#endif
+}
+
+Size
+EventLoop::add_fd
+(
+    int fd_,
+    const EventCallback& callback_
+)
+{
+    if(!this->is_valid() || fd_ < 0)
+    {
+        return 0;
+    }
+
+    return d_ptr->add_watch(fd_, false, callback_);
+}
+
+void
+EventLoop::remove
+(
+    Size id_
+)
+{
+    auto found_watch = d_ptr->watches.find(id_);
+
+    if(found_watch != d_ptr->watches.end())
+    {
+#if SB_OS_IS_LINUX
+        epoll_ctl(
+            d_ptr->epoll_fd,
+            EPOLL_CTL_DEL,
+            found_watch->second.fd,
+            SB_NULLPTR
+        );
+
+        if(found_watch->second.is_timer)
+        {
+            close(found_watch->second.fd);
+        }
+#endif
+
+        d_ptr->watches.erase(found_watch);
+    }
+}
+
+bool
+EventLoop::post
+(
+    const EventCallback& callback_
+)
+{
+#if SB_OS_IS_LINUX
+    if(!this->is_valid())
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(d_ptr->posted_mutex);
+
+        d_ptr->posted_callbacks.push_back(callback_);
+    }
+
+    std::uint64_t value = 1;
+
+    return write(d_ptr->wake_fd, &value, sizeof(value)) > 0;
+#else
+    (void)callback_;
+
+    return false;
+#endif
+}
+
+Size
+EventLoop::run_once
+(
+    int timeout_
+)
+{
+    Size call_count = 0;
+
+#if SB_OS_IS_LINUX
+    if(!this->is_valid())
+    {
+        return 0;
+    }
+
+    epoll_event events[Global::MAX_READY_WATCHES];
+
+    int event_count = epoll_wait(
+        d_ptr->epoll_fd,
+        events,
+        Global::MAX_READY_WATCHES,
+        timeout_
+    );
+
+    // collect the identifiers first: callbacks may remove any watch
+
+    std::vector<Size> ready_ids;
+
+    std::vector<EventCallback> posted_callbacks;
+
+    for(int i = 0; i < event_count; ++i)
+    {
+        if(events[i].data.u64 == 0)
+        {
+            std::uint64_t value;
+
+            while(read(d_ptr->wake_fd, &value, sizeof(value)) > 0)
+            {
+            }
+
+            std::lock_guard<std::mutex> lock(d_ptr->posted_mutex);
+
+            posted_callbacks.swap(d_ptr->posted_callbacks);
+        }
+        else
+        {
+            ready_ids.push_back(events[i].data.u64);
+        }
+    }
+
+    // callbacks posted during this dispatch wait for the next one
+
+    for(const auto& callback : posted_callbacks)
+    {
+        callback();
+
+        ++call_count;
+    }
+
+    for(auto id : ready_ids)
+    {
+        auto found_watch = d_ptr->watches.find(id);
+
+        if(found_watch == d_ptr->watches.end())
+        {
+            continue;
+        }
+
+        if(found_watch->second.is_timer)
+        {
+            // missed ticks are merged into this one
+
+            std::uint64_t expirations;
+
+            if(
+                read(
+                    found_watch->second.fd,
+                    &expirations,
+                    sizeof(expirations)
+                ) <= 0
+            )
+            {
+                continue;
+            }
+        }
+
+        // the watch may be removed by its own callback
+
+        EventCallback callback = found_watch->second.callback;
+
+        callback();
+
+        ++call_count;
+    }
+#else
+    (void)timeout_;
+#endif
+
+    return call_count;
+}
+
+void
+EventLoop::run
+(
+)
+{
+    d_ptr->is_stopping = false;
+
+    while(this->is_valid() && !d_ptr->is_stopping)
+    {
+        this->run_once();
+    }
+}
+
+void
+EventLoop::stop
+(
+)
+{
+    d_ptr->is_stopping = true;
+
+#if SB_OS_IS_LINUX
+    if(d_ptr->wake_fd >= 0)
+    {
+        std::uint64_t value = 1;
+
+        (void)write(d_ptr->wake_fd, &value, sizeof(value));
+    }
+#endif
+}
+
+EventLoop::Private::Private
+(
+    EventLoop* q_ptr_
+):
+    q_ptr       (q_ptr_),
+    epoll_fd    (-1),
+    wake_fd     (-1),
+    last_id     (0),
+    is_stopping (false)
+{
+#if SB_OS_IS_LINUX
+    this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    this->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    epoll_event event;
+
+    event.events = EPOLLIN;
+    event.data.u64 = 0;
+
+    if(
+        this->epoll_fd >= 0 && (
+            this->wake_fd < 0 ||
+            epoll_ctl(
+                this->epoll_fd,
+                EPOLL_CTL_ADD,
+                this->wake_fd,
+                &event
+            ) != 0
+        )
+    )
+    {
+        // a loop which can't be stopped is not usable
+
+        close(this->epoll_fd);
+
+        this->epoll_fd = -1;
+    }
+#endif
+}
+
+EventLoop::Private::~Private
+(
+)
+{
+#if SB_OS_IS_LINUX
+    for(auto& id_watch : this->watches)
+    {
+        if(id_watch.second.is_timer)
+        {
+            close(id_watch.second.fd);
+        }
+    }
+
+    if(this->epoll_fd >= 0)
+    {
+        close(this->epoll_fd);
+    }
+
+    if(this->wake_fd >= 0)
+    {
+        close(this->wake_fd);
+    }
+#endif
+}
+
+Size
+EventLoop::Private::add_watch
+(
+    int fd_,
+    bool is_timer_,
+    const EventCallback& callback_
+)
+{
+#if SB_OS_IS_LINUX
+    // identifier 0 is the wake up descriptor
+
+    Size id = ++this->last_id;
+
+    epoll_event event;
+
+    event.events = EPOLLIN;
+    event.data.u64 = id;
+
+    if(epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd_, &event) != 0)
+    {
+        return 0;
+    }
+
+    this->watches[id] = Watch{fd_, is_timer_, callback_};
+
+    return id;
+#else
+    (void)fd_;
+    (void)is_timer_;
+    (void)callback_;
+
+    return 0;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+EventLoopExecutive::EventLoopExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+EventLoopExecutive::~EventLoopExecutive
+(
+)
+{
+    this->detach();
+
+    delete d_ptr;
+}
+
+void
+EventLoopExecutive::on_input_pushed
+(
+    Index /*index_*/
+)
+{
+    this->execute();
+}
+
+void
+EventLoopExecutive::on_output_pulled
+(
+    Index /*index_*/
+)
+{
+    this->execute();
+}
+
+void
+EventLoopExecutive::attach
+(
+    EventLoop& loop_
+)
+{
+    d_ptr->unwatch();
+
+    d_ptr->loop = &loop_;
+
+    d_ptr->watch();
+}
+
+void
+EventLoopExecutive::detach
+(
+)
+{
+    d_ptr->unwatch();
+
+    d_ptr->loop = SB_NULLPTR;
+}
+
+Size
+EventLoopExecutive::get_period
+(
+)
+const
+{
+    return d_ptr->period;
+}
+
+void
+EventLoopExecutive::set_period
+(
+    const Size& value_
+)
+{
+    d_ptr->period = value_;
+
+    d_ptr->watch();
+}
+
+int
+EventLoopExecutive::get_fd
+(
+)
+const
+{
+    return d_ptr->fd;
+}
+
+void
+EventLoopExecutive::set_fd
+(
+    const int& value_
+)
+{
+    d_ptr->fd = value_;
+
+    d_ptr->watch();
+}
+
+EventLoopExecutive::Private::Private
+(
+    EventLoopExecutive* q_ptr_
+):
+    q_ptr    (q_ptr_),
+    loop     (SB_NULLPTR),
+    period   (0),
+    fd       (-1),
+    timer_id (0),
+    fd_id    (0)
+{
+}
+
+void
+EventLoopExecutive::Private::watch
+(
+)
+{
+    this->unwatch();
+
+    if(this->loop)
+    {
+        if(this->period != 0)
+        {
+            this->timer_id = this->loop->add_timer(
+                this->period,
+                [this]()
+                {
+                    this->on_event();
+                }
+            );
+        }
+
+        if(this->fd >= 0)
+        {
+            this->fd_id = this->loop->add_fd(
+                this->fd,
+                [this]()
+                {
+                    this->on_event();
+                }
+            );
+        }
+    }
+}
+
+void
+EventLoopExecutive::Private::unwatch
+(
+)
+{
+    if(this->loop)
+    {
+        this->loop->remove(this->timer_id);
+        this->loop->remove(this->fd_id);
+    }
+
+    this->timer_id = 0;
+    this->fd_id = 0;
+}
+
+void
+EventLoopExecutive::Private::on_event
+(
+)
+{
+    q_ptr->execute();
+}
+
+}
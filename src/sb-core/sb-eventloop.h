@@ -0,0 +1,270 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EVENTLOOP_H
+#define SB_EVENTLOOP_H
+
+#include <sb-core/sb-abstractexecutive.h>
+
+#include <functional>
+
+namespace sb
+{
+
+/// Alias for the function called by an EventLoop when a watch is ready.
+using EventCallback = std::function<void()>;
+
+/// \brief The EventLoop class waits for timers and file descriptors, and
+/// calls the functions watching them.
+///
+/// A loop dispatches the ready watches from the thread calling run() or
+/// run_once(): the watching functions, and the bloks they execute, run in
+/// that thread. Only post() and stop() may be called from another thread.
+///
+/// Event loops are only supported on Linux, where they rely on epoll, timerfd
+/// and eventfd.
+///
+/// \sa EventLoopExecutive.
+class SB_CORE_API EventLoop
+{
+
+public:
+
+    class Private;
+
+    /// Constructs a loop without watches.
+    EventLoop
+    (
+    );
+
+    /// Destroys this object, removing its watches.
+    ~EventLoop
+    (
+    );
+
+    EventLoop
+    (
+        const EventLoop& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    EventLoop&
+    operator=
+    (
+        const EventLoop& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    /// Returns \b true if the loop can wait for events; returns \b false if
+    /// the platform doesn't support event loops.
+    bool
+    is_valid
+    (
+    )
+    const;
+
+    /// Calls \a callback_ every \a period_ milliseconds, and returns the
+    /// identifier of the watch.
+    ///
+    /// The function returns 0 if the timer couldn't be created. Ticks missed
+    /// while the loop was busy result in a single call.
+    Size
+    add_timer
+    (
+        Size period_,
+        const EventCallback& callback_
+    );
+
+    /// Calls \a callback_ each time \a fd_ is readable, and returns the
+    /// identifier of the watch.
+    ///
+    /// The function returns 0 if \a fd_ can't be watched. The callback must
+    /// read the available data, or it is called again at once.
+    Size
+    add_fd
+    (
+        int fd_,
+        const EventCallback& callback_
+    );
+
+    /// Removes the watch \a id_; its callback is not called anymore, even
+    /// if it is ready in the current dispatch.
+    void
+    remove
+    (
+        Size id_
+    );
+
+    /// Calls \a callback_ once, from the thread dispatching the watches, at
+    /// its next dispatch.
+    ///
+    /// Work completed in another thread hands its result over to the bloks
+    /// of the loop this way. The function returns \b false if the loop is
+    /// not valid.
+    ///
+    /// This function is thread-safe.
+    bool
+    post
+    (
+        const EventCallback& callback_
+    );
+
+    /// Waits at most \a timeout_ milliseconds for ready watches, calls their
+    /// callbacks and returns the number of calls.
+    ///
+    /// A negative \a timeout_ waits without limit.
+    Size
+    run_once
+    (
+        int timeout_ = -1
+    );
+
+    /// Dispatches the ready watches until stop() is called.
+    void
+    run
+    (
+    );
+
+    /// Makes run() return after its current dispatch.
+    ///
+    /// This function is thread-safe.
+    void
+    stop
+    (
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The EventLoopExecutive class is an executive processing its blok
+/// from an EventLoop.
+///
+/// Once attached to a loop, the blok is processed every "period"
+/// milliseconds if "period" is not zero, and each time "fd" is readable if
+/// "fd" is not negative. Its outputs are then pushed through the executives
+/// of the followers, as if its properties were set. The blok is also
+/// processed when modified or pulled.
+///
+/// The executive is meant for sources polling a device or reading a file
+/// descriptor: process() must read the data available on "fd".
+class SB_CORE_API EventLoopExecutive : public AbstractExecutive
+{
+
+    SB_SELF(sb::EventLoopExecutive)
+
+    SB_NAME("sb.EventLoopExecutive")
+
+    SB_PROPERTIES({
+        "period",
+        &EventLoopExecutive::get_period,
+        &EventLoopExecutive::set_period
+    }, {
+        "fd",
+        &EventLoopExecutive::get_fd,
+        &EventLoopExecutive::set_fd
+    })
+
+public:
+
+    class Private;
+
+    /// Constructs an executive attached to no loop.
+    EventLoopExecutive
+    (
+    );
+
+    /// Destroys this object, detaching it from its loop.
+    virtual
+    ~EventLoopExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    /// Registers the watches of this executive with \a loop_, after
+    /// detaching it from its previous loop.
+    ///
+    /// The loop must outlive the executive, or the executive must be
+    /// detached before the loop is destroyed.
+    void
+    attach
+    (
+        EventLoop& loop_
+    );
+
+    /// Removes the watches of this executive from its loop, if any.
+    void
+    detach
+    (
+    );
+
+    Size
+    get_period
+    (
+    )
+    const;
+
+    void
+    set_period
+    (
+        const Size& value_
+    );
+
+    int
+    get_fd
+    (
+    )
+    const;
+
+    void
+    set_fd
+    (
+        const int& value_
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+}
+
+#endif // SB_EVENTLOOP_H
@@ -20,6 +20,20 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-executive.h>
 
+#include <sb-core/sb-abstractblok.h>
+#include <sb-core/sb-executor-private.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <set>
+#include <vector>
+
 namespace sb
 {
 
@@ -74,6 +88,723 @@ public:
 
 };
 
+class SB_DECL_HIDDEN BatchingExecutive::Private
+{
+
+public:
+
+    Private
+    (
+        BatchingExecutive* q_ptr_
+    );
+
+    // returns false if the inputs didn't change since the last snapshot
+
+    bool
+    snapshot
+    (
+    );
+
+    // calls flush() from loop once the oldest item waited max_delay, after
+    // removing the previous timer
+
+    void
+    arm_timer
+    (
+    );
+
+    void
+    disarm_timer
+    (
+    );
+
+public:
+
+    BatchingExecutive*
+    q_ptr;
+
+    EventLoop*
+    loop;
+
+    Size
+    timer_id;
+
+    Size
+    batch_size;
+
+    Size
+    max_delay;
+
+    DataBatch
+    items;
+
+    // versions of the inputs at the last snapshot
+
+    std::vector<Size>
+    input_versions;
+
+    std::chrono::steady_clock::time_point
+    oldest_item_time;
+
+};
+
+// an item numbered in the order of the pushes
+
+struct SB_DECL_HIDDEN SequencedItem
+{
+
+    Size
+    sequence;
+
+    SharedDataSequence
+    data;
+
+};
+
+// the outputs produced for an item, or the exception raised by its process
+
+struct SB_DECL_HIDDEN ItemResult
+{
+
+    SharedDataSequence
+    outputs;
+
+    std::exception_ptr
+    error;
+
+};
+
+class SB_DECL_HIDDEN ReplicatedExecutive::Private
+{
+
+public:
+
+    enum class Dispatch
+    {
+        ROUND_ROBIN,
+        KEY_HASH
+    };
+
+    Private
+    (
+        ReplicatedExecutive* q_ptr_
+    );
+
+    void
+    start
+    (
+    );
+
+    // waits for the drain tasks to finish their items, then destroys the
+    // copies
+
+    void
+    stop
+    (
+    );
+
+    // queues item_, pushed through the input index_, after applying the
+    // policy of the input if the queues are full
+
+    void
+    dispatch
+    (
+        SharedDataSequence&& item_,
+        Index index_
+    );
+
+    // pushes the results following the last delivered one, if any; with
+    // is_blocking_, waits for all the dispatched items
+
+    void
+    deliver
+    (
+        bool is_blocking_
+    );
+
+    // gives the properties of the blok to the copies
+
+    void
+    synchronize
+    (
+    );
+
+    Index
+    select_replica
+    (
+        const SharedDataSequence& item_
+    );
+
+    // helps the drain tasks no thread started yet
+
+    void
+    help
+    (
+    );
+
+    // the following functions expect the mutex to be locked
+
+    Size
+    get_queued_count
+    (
+    )
+    const;
+
+    // discards the queued item pushed first
+
+    void
+    drop_oldest
+    (
+    );
+
+    // posts a delivery to loop, unless one is pending
+
+    void
+    post_delivery
+    (
+    );
+
+    // processes the items of the copy index_ until there is none; runs in
+    // the executor
+
+    void
+    drain
+    (
+        Index index_
+    );
+
+public:
+
+    ReplicatedExecutive*
+    q_ptr;
+
+    Size
+    replica_count;
+
+    Dispatch
+    dispatch_policy;
+
+    std::string
+    dispatch_key;
+
+    std::vector<UniqueBlok>
+    replicas;
+
+    std::vector<std::shared_ptr<TaskGroup>>
+    drain_tasks;
+
+    // the fields below are guarded by mutex
+
+    std::mutex
+    mutex;
+
+    std::condition_variable
+    result_condition;
+
+    std::vector<std::deque<SequencedItem>>
+    queues;
+
+    std::vector<bool>
+    draining_replicas;
+
+    // the reorder buffer
+
+    std::map<Size, ItemResult>
+    results;
+
+    // sequence numbers of the discarded items, skipped by the reorder buffer
+
+    std::set<Size>
+    dropped_sequences;
+
+    EventLoop*
+    loop;
+
+    bool
+    is_delivery_posted;
+
+    // expires when the executive is detached or destroyed, so that the
+    // deliveries posted before are skipped
+
+    std::shared_ptr<bool>
+    delivery_token;
+
+    // the fields below are used by the thread owning the blok only
+
+    Size
+    next_sequence;
+
+    Size
+    next_delivery;
+
+    Index
+    next_replica;
+
+    std::vector<Size>
+    input_versions;
+
+};
+
+class SB_DECL_HIDDEN JoinExecutive::Private
+{
+
+public:
+
+    Private
+    (
+        JoinExecutive* q_ptr_
+    );
+
+    // marks the input index_ as arrived if it holds a new version; returns
+    // true if the required inputs arrived or if the timeout elapsed
+
+    bool
+    arrive
+    (
+        Index index_
+    );
+
+    // processes the blok and starts a new cycle
+
+    void
+    execute
+    (
+    );
+
+    // processes the blok from loop once the timeout of the cycle elapsed,
+    // after removing the previous timer
+
+    void
+    arm_timer
+    (
+    );
+
+    void
+    disarm_timer
+    (
+    );
+
+public:
+
+    JoinExecutive*
+    q_ptr;
+
+    EventLoop*
+    loop;
+
+    Size
+    timer_id;
+
+    Size
+    timeout;
+
+    std::set<Index>
+    optional_inputs;
+
+    // versions of the inputs at the last execution
+
+    std::vector<Size>
+    input_versions;
+
+    std::vector<bool>
+    arrived_inputs;
+
+    std::chrono::steady_clock::time_point
+    first_arrival_time;
+
+};
+
+class SB_DECL_HIDDEN ThreadedExecutive::Private
+{
+
+public:
+
+    Private
+    (
+        ThreadedExecutive* q_ptr_
+    );
+
+    void
+    start
+    (
+    );
+
+    // cancels the current item and waits for the drain task to end
+
+    void
+    stop
+    (
+    );
+
+    // makes item_ the newest item if has_item_; properties_ are given to
+    // the copy before it processes its next item, unless empty. Returns the
+    // number of items discarded for item_
+
+    Size
+    submit
+    (
+        bool has_item_,
+        SharedDataSequence&& item_,
+        std::vector<char>&& properties_
+    );
+
+    // pushes the last result, if any; with is_blocking_, waits for the
+    // newest item first
+
+    void
+    deliver
+    (
+        bool is_blocking_
+    );
+
+    // processes the newest item until there is none; runs in the executor
+
+    void
+    drain
+    (
+    );
+
+public:
+
+    ThreadedExecutive*
+    q_ptr;
+
+    UniqueBlok
+    replica;
+
+    std::shared_ptr<TaskGroup>
+    drain_task;
+
+    // the fields below are guarded by mutex
+
+    std::mutex
+    mutex;
+
+    std::condition_variable
+    result_condition;
+
+    bool
+    is_draining;
+
+    bool
+    has_pending_item;
+
+    SharedDataSequence
+    pending_item;
+
+    std::vector<char>
+    pending_properties;
+
+    bool
+    is_running;
+
+    bool
+    has_result;
+
+    ItemResult
+    result;
+
+    Size
+    cancelled_count;
+
+    bool
+    is_stopping;
+
+    // used by the thread owning the blok only
+
+    std::vector<Size>
+    input_versions;
+
+};
+
+class SB_DECL_HIDDEN AsyncExecutive::Private
+{
+
+public:
+
+    Private
+    (
+        AsyncExecutive* q_ptr_
+    );
+
+    // starts an execution, or merges it into the pending one if the blok is
+    // running; returns true if a pending execution was superseded
+
+    bool
+    start
+    (
+    );
+
+    // pushes the outputs, then starts the pending execution, if any
+
+    void
+    complete
+    (
+        std::exception_ptr error_
+    );
+
+public:
+
+    AsyncExecutive*
+    q_ptr;
+
+    // completions hold a weak reference to it, so that they are ignored once
+    // the executive is destroyed
+
+    std::shared_ptr<Private*>
+    handle;
+
+    bool
+    is_running;
+
+    bool
+    is_pending;
+
+};
+
+// a piece computed ahead by a PrefetchExecutive
+
+struct SB_DECL_HIDDEN PrefetchedPiece
+{
+
+    Piece
+    piece;
+
+    SharedDataSequence
+    outputs;
+
+};
+
+class SB_DECL_HIDDEN PrefetchExecutive::Private
+{
+
+public:
+
+    Private
+    (
+        PrefetchExecutive* q_ptr_
+    );
+
+    void
+    start
+    (
+    );
+
+    // waits for the drain task to end
+
+    void
+    stop
+    (
+    );
+
+    // discards the prefetched pieces and gives the copy the properties of
+    // the blok
+
+    void
+    invalidate
+    (
+    );
+
+    // copies the prefetched piece_ into the outputs; returns false if
+    // piece_ wasn't prefetched
+
+    bool
+    take
+    (
+        const Piece& piece_
+    );
+
+    // records the pull of piece_ and, if it follows the previous one,
+    // schedules the next pieces
+
+    void
+    anticipate
+    (
+        const Piece& piece_
+    );
+
+    // computes the expected pieces until there is none; runs in the executor
+
+    void
+    drain
+    (
+    );
+
+public:
+
+    PrefetchExecutive*
+    q_ptr;
+
+    UniqueBlok
+    replica;
+
+    std::shared_ptr<TaskGroup>
+    drain_task;
+
+    // the fields below are guarded by mutex
+
+    std::mutex
+    mutex;
+
+    std::condition_variable
+    drain_condition;
+
+    bool
+    is_draining;
+
+    bool
+    is_stopping;
+
+    // pieces to compute, in order
+
+    std::deque<Piece>
+    expected_pieces;
+
+    std::vector<PrefetchedPiece>
+    prefetched_pieces;
+
+    // incremented by invalidate(), so that the drain task discards the piece
+    // it was computing
+
+    Size
+    generation;
+
+    Size
+    hit_count;
+
+    // the fields below are used by the thread owning the blok only
+
+    Size
+    depth;
+
+    Size
+    change_epoch;
+
+    bool
+    has_last_piece;
+
+    Piece
+    last_piece;
+
+};
+
+class SB_DECL_HIDDEN AdaptiveExecutive::Private
+{
+
+public:
+
+    enum class Mode
+    {
+        EAGER,
+        LAZY,
+        PARALLEL,
+        COALESCING
+    };
+
+    Private
+    (
+        AdaptiveExecutive* q_ptr_
+    );
+
+    // ends the current window if it elapsed, and switches to the mode it
+    // selects once confirmed
+
+    void
+    evaluate
+    (
+    );
+
+    // returns the mode matching the activity of the last window, whose load
+    // was computed
+
+    Mode
+    select
+    (
+        double push_rate_,
+        double pull_rate_
+    )
+    const;
+
+    // replaces the executive of the current mode by the one of mode_
+
+    void
+    use_mode
+    (
+        Mode mode_
+    );
+
+    // forwards an event to the executive of the current mode; measures the
+    // processing time if is_executing_, i.e. if the event executes the blok
+    // in this thread
+
+    void
+    forward
+    (
+        bool is_executing_,
+        const std::function<void()>& event_
+    );
+
+    static
+    std::string
+    get_name
+    (
+        Mode mode_
+    );
+
+public:
+
+    AdaptiveExecutive*
+    q_ptr;
+
+    UniqueExecutive
+    strategy;
+
+    Mode
+    mode;
+
+    Size
+    window;
+
+    Size
+    hysteresis;
+
+    // activity of the current window
+
+    std::chrono::steady_clock::time_point
+    window_start;
+
+    Size
+    push_count;
+
+    Size
+    pull_count;
+
+    Size
+    execution_count;
+
+    std::chrono::steady_clock::duration
+    execution_time;
+
+    // average processing time, in seconds
+
+    double
+    cost;
+
+    // fraction of a thread the pushes of the last window keep busy
+
+    double
+    load;
+
+    // the mode selected by the last windows, and for how many of them
+
+    Mode
+    candidate;
+
+    Size
+    candidate_count;
+
+};
+
 }
 
 #endif // SB_EXECUTIVE_PRIVATE_H
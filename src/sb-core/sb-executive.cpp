@@ -19,6 +19,15 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-executive-private.h>
 
+#include <algorithm>
+#include <cmath>
+
+#include <sb-core/sb-abstractblok-private.h>
+#include <sb-core/sb-abstractexecutive-private.h>
+#include <sb-core/sb-abstractobject-private.h>
+#include <sb-core/sb-propagation-private.h>
+#include <sb-core/sb-serialization.h>
+
 using namespace sb;
 
 PushExecutive::PushExecutive
@@ -93,6 +102,13 @@ PullExecutive::on_output_pulled
     this->execute();
 }
 
+void
+PullExecutive::on_modified
+(
+)
+{
+}
+
 PullExecutive::Private::Private
 (
     PullExecutive* q_ptr_
@@ -142,3 +158,2690 @@ PushPullExecutive::Private::Private
     q_ptr(q_ptr_)
 {
 }
+
+//////////////////////////////////////////////////////////////////////////////
+
+ReplicatedExecutive::ReplicatedExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+ReplicatedExecutive::~ReplicatedExecutive
+(
+)
+{
+    this->detach();
+
+    d_ptr->stop();
+
+    delete d_ptr;
+}
+
+void
+ReplicatedExecutive::on_input_pushed
+(
+    Index index_
+)
+{
+    SharedDataSequence item;
+
+    // several inputs pushed during a single visit make a single item
+
+    if(
+        AbstractExecutive::Private::from(
+            this
+        )->snapshot_inputs(
+            d_ptr->input_versions,
+            item,
+            "sb::ReplicatedExecutive::on_input_pushed"
+        )
+    )
+    {
+        d_ptr->dispatch(std::move(item), index_);
+    }
+
+    d_ptr->deliver(false);
+}
+
+void
+ReplicatedExecutive::on_output_pulled
+(
+    Index /*index_*/
+)
+{
+    d_ptr->deliver(true);
+}
+
+void
+ReplicatedExecutive::on_modified
+(
+)
+{
+    d_ptr->deliver(true);
+
+    if(!d_ptr->replicas.empty())
+    {
+        d_ptr->synchronize();
+    }
+
+    // the current inputs must be processed with the new properties
+
+    d_ptr->input_versions.clear();
+
+    this->on_input_pushed(0);
+}
+
+void
+ReplicatedExecutive::wait
+(
+)
+{
+    d_ptr->deliver(true);
+}
+
+void
+ReplicatedExecutive::attach
+(
+    EventLoop& loop_
+)
+{
+    this->detach();
+
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    d_ptr->loop = &loop_;
+
+    d_ptr->delivery_token = std::make_shared<bool>(true);
+
+    if(!d_ptr->results.empty() || !d_ptr->dropped_sequences.empty())
+    {
+        d_ptr->post_delivery();
+    }
+}
+
+void
+ReplicatedExecutive::detach
+(
+)
+{
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    d_ptr->loop = SB_NULLPTR;
+
+    d_ptr->is_delivery_posted = false;
+
+    d_ptr->delivery_token.reset();
+}
+
+Size
+ReplicatedExecutive::get_replica_count
+(
+)
+const
+{
+    return d_ptr->replica_count;
+}
+
+void
+ReplicatedExecutive::set_replica_count
+(
+    const Size& value_
+)
+{
+    Size replica_count = std::max<Size>(value_, 1);
+
+    if(replica_count != d_ptr->replica_count)
+    {
+        d_ptr->deliver(true);
+
+        // the copies are created again at the next push
+
+        d_ptr->stop();
+
+        d_ptr->replica_count = replica_count;
+    }
+}
+
+std::string
+ReplicatedExecutive::get_dispatch
+(
+)
+const
+{
+    return (
+        d_ptr->dispatch_policy == Private::Dispatch::KEY_HASH
+    ) ? (
+        "key_hash"
+    ) : (
+        "round_robin"
+    );
+}
+
+void
+ReplicatedExecutive::set_dispatch
+(
+    const std::string& value_
+)
+{
+    if(value_ == "round_robin")
+    {
+        d_ptr->dispatch_policy = Private::Dispatch::ROUND_ROBIN;
+    }
+    else if(value_ == "key_hash")
+    {
+        d_ptr->dispatch_policy = Private::Dispatch::KEY_HASH;
+    }
+    else
+    {
+        throw std::invalid_argument(
+            std::string() +
+            "sb::ReplicatedExecutive::set_dispatch: " +
+            "unknown dispatch policy " +
+            value_
+        );
+    }
+}
+
+std::string
+ReplicatedExecutive::get_dispatch_key
+(
+)
+const
+{
+    return d_ptr->dispatch_key;
+}
+
+void
+ReplicatedExecutive::set_dispatch_key
+(
+    const std::string& value_
+)
+{
+    d_ptr->dispatch_key = value_;
+}
+
+ReplicatedExecutive::Private::Private
+(
+    ReplicatedExecutive* q_ptr_
+):
+    q_ptr               (q_ptr_),
+    replica_count       (DEFAULT_REPLICA_COUNT),
+    dispatch_policy     (Dispatch::ROUND_ROBIN),
+    loop                (SB_NULLPTR),
+    is_delivery_posted  (false),
+    next_sequence       (0),
+    next_delivery       (0),
+    next_replica        (0)
+{
+}
+
+void
+ReplicatedExecutive::Private::start
+(
+)
+{
+    auto executive_d_ptr = AbstractExecutive::Private::from(q_ptr);
+
+    for(Index i = 0; i < this->replica_count; ++i)
+    {
+        try
+        {
+            this->replicas.push_back(
+                executive_d_ptr->create_copy(
+                    "sb::ReplicatedExecutive::start"
+                )
+            );
+        }
+        catch(...)
+        {
+            this->replicas.clear();
+
+            throw;
+        }
+    }
+
+    this->drain_tasks.resize(this->replica_count);
+    this->queues.resize(this->replica_count);
+    this->draining_replicas.assign(this->replica_count, false);
+}
+
+void
+ReplicatedExecutive::Private::stop
+(
+)
+{
+    // the drain tasks process their remaining items before ending
+
+    this->help();
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        this->result_condition.wait(
+            lock,
+            [this]
+            (
+            )
+            {
+                return std::none_of(
+                    this->draining_replicas.begin(),
+                    this->draining_replicas.end(),
+                    [](bool is_draining_)
+                    {
+                        return is_draining_;
+                    }
+                );
+            }
+        );
+    }
+
+    this->drain_tasks.clear();
+    this->replicas.clear();
+    this->queues.clear();
+    this->draining_replicas.clear();
+}
+
+void
+ReplicatedExecutive::Private::dispatch
+(
+    SharedDataSequence&& item_,
+    Index index_
+)
+{
+    if(this->replicas.empty())
+    {
+        this->start();
+    }
+
+    auto blok_d_ptr = AbstractBlok::Private::from(
+        AbstractExecutive::Private::from(q_ptr)->blok
+    );
+
+    // modifications of a blok without inputs are pushed through no edge
+
+    EdgePolicy policy = DEFAULT_EDGE_POLICY;
+
+    EdgeStatistics unused_statistics = {0, 0, 0};
+
+    EdgeStatistics& statistics = (
+        index_ < blok_d_ptr->input_statistics.size()
+    ) ? (
+        blok_d_ptr->input_statistics[index_]
+    ) : (
+        unused_statistics
+    );
+
+    if(index_ < blok_d_ptr->input_policies.size())
+    {
+        policy = blok_d_ptr->input_policies[index_];
+    }
+
+    Size capacity = std::max<Size>(policy.capacity, 1);
+
+    Index replica_index = 0;
+
+    bool is_drain_needed = false;
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        if(this->get_queued_count() >= capacity)
+        {
+            if(policy.overflow == OverflowPolicy::BLOCK)
+            {
+                ++statistics.blocked_count;
+
+                // no thread of the executor may be free to drain the copies
+
+                lock.unlock();
+
+                this->help();
+
+                lock.lock();
+
+                this->result_condition.wait(
+                    lock,
+                    [this, capacity]
+                    (
+                    )
+                    {
+                        return this->get_queued_count() < capacity;
+                    }
+                );
+            }
+            else if(policy.overflow == OverflowPolicy::DROP_NEWEST)
+            {
+                ++statistics.dropped_count;
+
+                return;
+            }
+            else
+            {
+                // keeping the latest item only leaves room for it alone
+
+                Size kept_count = (
+                    policy.overflow == OverflowPolicy::KEEP_LATEST
+                ) ? (
+                    0
+                ) : (
+                    capacity - 1
+                );
+
+                while(this->get_queued_count() > kept_count)
+                {
+                    this->drop_oldest();
+
+                    ++statistics.dropped_count;
+                }
+            }
+        }
+
+        replica_index = this->select_replica(item_);
+
+        this->queues[replica_index].push_back(
+            SequencedItem{this->next_sequence, std::move(item_)}
+        );
+
+        if(!this->draining_replicas[replica_index])
+        {
+            this->draining_replicas[replica_index] = true;
+
+            is_drain_needed = true;
+        }
+    }
+
+    ++this->next_sequence;
+
+    if(is_drain_needed)
+    {
+        this->drain_tasks[replica_index] = AbstractExecutive::Private::from(
+            q_ptr
+        )->post(
+            [this, replica_index]
+            (
+            )
+            {
+                this->drain(replica_index);
+            }
+        );
+    }
+}
+
+void
+ReplicatedExecutive::Private::deliver
+(
+    bool is_blocking_
+)
+{
+    auto executive_d_ptr = AbstractExecutive::Private::from(q_ptr);
+
+    if(is_blocking_)
+    {
+        // no thread of the executor may be free to drain the copies
+
+        this->help();
+    }
+
+    while(this->next_delivery != this->next_sequence)
+    {
+        ItemResult result;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+
+            if(is_blocking_)
+            {
+                this->result_condition.wait(
+                    lock,
+                    [this]
+                    (
+                    )
+                    {
+                        return this->results.count(
+                            this->next_delivery
+                        ) != 0 || this->dropped_sequences.count(
+                            this->next_delivery
+                        ) != 0;
+                    }
+                );
+            }
+
+            if(this->dropped_sequences.erase(this->next_delivery) != 0)
+            {
+                ++this->next_delivery;
+
+                continue;
+            }
+
+            auto found_result = this->results.find(this->next_delivery);
+
+            if(found_result == this->results.end())
+            {
+                break;
+            }
+
+            result = std::move(found_result->second);
+
+            this->results.erase(found_result);
+        }
+
+        ++this->next_delivery;
+
+        if(result.error)
+        {
+            std::rethrow_exception(result.error);
+        }
+
+        executive_d_ptr->publish_outputs(
+            result.outputs,
+            "sb::ReplicatedExecutive::deliver"
+        );
+    }
+}
+
+void
+ReplicatedExecutive::Private::synchronize
+(
+)
+{
+    Writer writer;
+
+    serialize(*AbstractExecutive::Private::from(q_ptr)->blok, writer);
+
+    for(const auto& replica : this->replicas)
+    {
+        Reader reader(writer.get_buffer());
+
+        deserialize(*replica, reader);
+    }
+}
+
+Index
+ReplicatedExecutive::Private::select_replica
+(
+    const SharedDataSequence& item_
+)
+{
+    if(
+        this->dispatch_policy == Dispatch::KEY_HASH &&
+        !item_.empty() &&
+        item_[0]
+    )
+    {
+        // hash the key property of the first input, or all its readable
+        // properties
+
+        auto object_d_ptr = AbstractObject::Private::from(item_[0].get());
+
+        Size key = 0;
+
+        bool is_hashable = true;
+
+        for(const auto& name_property : *object_d_ptr->properties)
+        {
+            const ObjectProperty& property = name_property.second;
+
+            if(
+                !this->dispatch_key.empty() &&
+                name_property.first != this->dispatch_key
+            )
+            {
+                continue;
+            }
+
+            if(
+                bitmask(
+                    property.access_rights
+                ).is_set(
+                    AccessRights::READ
+                )
+            )
+            {
+                if(!property.hash)
+                {
+                    is_hashable = false;
+
+                    break;
+                }
+
+                key = hash_combine(
+                    key,
+                    property.hash(property.get(*item_[0]))
+                );
+            }
+        }
+
+        // a missing key property is not hashable
+
+        if(
+            !this->dispatch_key.empty() &&
+            object_d_ptr->properties->count(this->dispatch_key) == 0
+        )
+        {
+            is_hashable = false;
+        }
+
+        if(is_hashable)
+        {
+            return key % this->replicas.size();
+        }
+    }
+
+    return this->next_replica++ % this->replicas.size();
+}
+
+void
+ReplicatedExecutive::Private::help
+(
+)
+{
+    for(const auto& drain_task : this->drain_tasks)
+    {
+        if(drain_task)
+        {
+            Executor::help(*drain_task);
+        }
+    }
+}
+
+Size
+ReplicatedExecutive::Private::get_queued_count
+(
+)
+const
+{
+    Size queued_count = 0;
+
+    for(const auto& queue : this->queues)
+    {
+        queued_count += queue.size();
+    }
+
+    return queued_count;
+}
+
+void
+ReplicatedExecutive::Private::drop_oldest
+(
+)
+{
+    std::deque<SequencedItem>* oldest_queue = SB_NULLPTR;
+
+    for(auto& queue : this->queues)
+    {
+        if(
+            !queue.empty() && (
+                !oldest_queue ||
+                queue.front().sequence < oldest_queue->front().sequence
+            )
+        )
+        {
+            oldest_queue = &queue;
+        }
+    }
+
+    if(oldest_queue)
+    {
+        this->dropped_sequences.insert(oldest_queue->front().sequence);
+
+        oldest_queue->pop_front();
+    }
+}
+
+void
+ReplicatedExecutive::Private::post_delivery
+(
+)
+{
+    if(this->is_delivery_posted)
+    {
+        return;
+    }
+
+    std::weak_ptr<bool> weak_token = this->delivery_token;
+
+    this->is_delivery_posted = this->loop->post(
+        [this, weak_token]
+        (
+        )
+        {
+            // the loop thread owns the blok: the executive can't be
+            // destroyed while the token is checked
+
+            if(weak_token.expired())
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                this->is_delivery_posted = false;
+            }
+
+            this->deliver(false);
+        }
+    );
+}
+
+void
+ReplicatedExecutive::Private::drain
+(
+    Index index_
+)
+{
+    AbstractBlok* replica = this->replicas[index_].get();
+
+    auto& queue = this->queues[index_];
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while(!queue.empty())
+    {
+        SequencedItem item = std::move(queue.front());
+
+        queue.pop_front();
+
+        lock.unlock();
+
+        ItemResult result;
+
+        try
+        {
+            replica->process_batch({item.data});
+
+            // snapshot the outputs: the copy processes its next item in them
+
+            result.outputs = AbstractExecutive::Private::clone_outputs(
+                replica,
+                "sb::ReplicatedExecutive::drain"
+            );
+        }
+        catch(...)
+        {
+            result.error = std::current_exception();
+        }
+
+        lock.lock();
+
+        this->results.emplace(item.sequence, std::move(result));
+
+        this->result_condition.notify_all();
+
+        if(this->loop)
+        {
+            this->post_delivery();
+        }
+    }
+
+    this->draining_replicas[index_] = false;
+
+    this->result_condition.notify_all();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BatchingExecutive::BatchingExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+BatchingExecutive::~BatchingExecutive
+(
+)
+{
+    this->detach();
+
+    delete d_ptr;
+}
+
+void
+BatchingExecutive::on_input_pushed
+(
+    Index /*index_*/
+)
+{
+    // several inputs pushed during a single visit make a single item
+
+    if(!d_ptr->snapshot())
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+
+    if(d_ptr->items.size() == 1)
+    {
+        d_ptr->oldest_item_time = now;
+
+        d_ptr->arm_timer();
+    }
+
+    if(
+        d_ptr->items.size() >= d_ptr->batch_size ||
+        now - d_ptr->oldest_item_time >=
+            std::chrono::milliseconds(d_ptr->max_delay)
+    )
+    {
+        this->flush();
+    }
+}
+
+void
+BatchingExecutive::on_output_pulled
+(
+    Index /*index_*/
+)
+{
+    this->flush();
+}
+
+void
+BatchingExecutive::on_modified
+(
+)
+{
+    this->flush();
+
+    this->execute();
+}
+
+void
+BatchingExecutive::flush
+(
+)
+{
+    if(!d_ptr->items.empty())
+    {
+        d_ptr->disarm_timer();
+
+        DataBatch items;
+
+        std::swap(items, d_ptr->items);
+
+        this->execute_batch(items);
+    }
+}
+
+void
+BatchingExecutive::attach
+(
+    EventLoop& loop_
+)
+{
+    this->detach();
+
+    d_ptr->loop = &loop_;
+
+    if(!d_ptr->items.empty())
+    {
+        d_ptr->arm_timer();
+    }
+}
+
+void
+BatchingExecutive::detach
+(
+)
+{
+    d_ptr->disarm_timer();
+
+    d_ptr->loop = SB_NULLPTR;
+}
+
+Size
+BatchingExecutive::get_pending_count
+(
+)
+const
+{
+    return d_ptr->items.size();
+}
+
+Size
+BatchingExecutive::get_batch_size
+(
+)
+const
+{
+    return d_ptr->batch_size;
+}
+
+void
+BatchingExecutive::set_batch_size
+(
+    const Size& value_
+)
+{
+    d_ptr->batch_size = std::max<Size>(value_, 1);
+
+    if(d_ptr->items.size() >= d_ptr->batch_size)
+    {
+        this->flush();
+    }
+}
+
+Size
+BatchingExecutive::get_max_delay
+(
+)
+const
+{
+    return d_ptr->max_delay;
+}
+
+void
+BatchingExecutive::set_max_delay
+(
+    const Size& value_
+)
+{
+    d_ptr->max_delay = value_;
+
+    if(!d_ptr->items.empty())
+    {
+        d_ptr->arm_timer();
+    }
+}
+
+BatchingExecutive::Private::Private
+(
+    BatchingExecutive* q_ptr_
+):
+    q_ptr       (q_ptr_),
+    loop        (SB_NULLPTR),
+    timer_id    (0),
+    batch_size  (DEFAULT_BATCH_SIZE),
+    max_delay   (DEFAULT_MAX_BATCH_DELAY)
+{
+}
+
+bool
+BatchingExecutive::Private::snapshot
+(
+)
+{
+    SharedDataSequence item;
+
+    bool is_changed = AbstractExecutive::Private::from(
+        q_ptr
+    )->snapshot_inputs(
+        this->input_versions,
+        item,
+        "sb::BatchingExecutive::snapshot"
+    );
+
+    if(is_changed)
+    {
+        this->items.push_back(item);
+    }
+
+    return is_changed;
+}
+
+void
+BatchingExecutive::Private::arm_timer
+(
+)
+{
+    this->disarm_timer();
+
+    if(!this->loop)
+    {
+        return;
+    }
+
+    Size waited = Size(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - this->oldest_item_time
+        ).count()
+    );
+
+    // loop timers are periodic: the first tick removes this one
+
+    Size delay = std::max<Size>(
+        this->max_delay > waited ? this->max_delay - waited : 0,
+        1
+    );
+
+    this->timer_id = this->loop->add_timer(
+        delay,
+        [this]()
+        {
+            this->disarm_timer();
+
+            q_ptr->flush();
+        }
+    );
+}
+
+void
+BatchingExecutive::Private::disarm_timer
+(
+)
+{
+    if(this->loop)
+    {
+        this->loop->remove(this->timer_id);
+    }
+
+    this->timer_id = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+JoinExecutive::JoinExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+JoinExecutive::~JoinExecutive
+(
+)
+{
+    this->detach();
+
+    delete d_ptr;
+}
+
+void
+JoinExecutive::on_input_pushed
+(
+    Index index_
+)
+{
+    if(d_ptr->arrive(index_))
+    {
+        d_ptr->execute();
+    }
+}
+
+void
+JoinExecutive::on_output_pulled
+(
+    Index /*index_*/
+)
+{
+    d_ptr->execute();
+}
+
+void
+JoinExecutive::on_modified
+(
+)
+{
+    d_ptr->execute();
+}
+
+Size
+JoinExecutive::get_arrived_count
+(
+)
+const
+{
+    return std::count(
+        d_ptr->arrived_inputs.begin(),
+        d_ptr->arrived_inputs.end(),
+        true
+    );
+}
+
+bool
+JoinExecutive::is_input_required
+(
+    Index index_
+)
+const
+{
+    return d_ptr->optional_inputs.count(index_) == 0;
+}
+
+void
+JoinExecutive::set_input_required
+(
+    Index index_,
+    bool value_
+)
+{
+    if(value_)
+    {
+        d_ptr->optional_inputs.erase(index_);
+    }
+    else
+    {
+        d_ptr->optional_inputs.insert(index_);
+    }
+}
+
+void
+JoinExecutive::attach
+(
+    EventLoop& loop_
+)
+{
+    this->detach();
+
+    d_ptr->loop = &loop_;
+
+    if(this->get_arrived_count() != 0)
+    {
+        d_ptr->arm_timer();
+    }
+}
+
+void
+JoinExecutive::detach
+(
+)
+{
+    d_ptr->disarm_timer();
+
+    d_ptr->loop = SB_NULLPTR;
+}
+
+Size
+JoinExecutive::get_timeout
+(
+)
+const
+{
+    return d_ptr->timeout;
+}
+
+void
+JoinExecutive::set_timeout
+(
+    const Size& value_
+)
+{
+    d_ptr->timeout = value_;
+
+    if(this->get_arrived_count() != 0)
+    {
+        d_ptr->arm_timer();
+    }
+}
+
+JoinExecutive::Private::Private
+(
+    JoinExecutive* q_ptr_
+):
+    q_ptr       (q_ptr_),
+    loop        (SB_NULLPTR),
+    timer_id    (0),
+    timeout     (0)
+{
+}
+
+bool
+JoinExecutive::Private::arrive
+(
+    Index index_
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(
+        AbstractExecutive::Private::from(q_ptr)->blok
+    );
+
+    Size input_count = blok_d_ptr->inputs.size();
+
+    this->input_versions.resize(input_count, 0);
+    this->arrived_inputs.resize(input_count, false);
+
+    auto input = blok_d_ptr->inputs.at(index_).lock();
+
+    // an input pushed again with the same content didn't arrive
+
+    if(!input || input->get_version() == this->input_versions[index_])
+    {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+
+    bool is_first_arrival = q_ptr->get_arrived_count() == 0;
+
+    if(is_first_arrival)
+    {
+        this->first_arrival_time = now;
+    }
+
+    this->arrived_inputs[index_] = true;
+
+    if(is_first_arrival)
+    {
+        this->arm_timer();
+    }
+
+    bool is_ready = true;
+
+    for(Index i = 0; i < input_count; ++i)
+    {
+        if(!this->arrived_inputs[i] && this->optional_inputs.count(i) == 0)
+        {
+            is_ready = false;
+        }
+    }
+
+    return is_ready || (
+        this->timeout != 0 &&
+        now - this->first_arrival_time >=
+            std::chrono::milliseconds(this->timeout)
+    );
+}
+
+void
+JoinExecutive::Private::execute
+(
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(
+        AbstractExecutive::Private::from(q_ptr)->blok
+    );
+
+    Size input_count = blok_d_ptr->inputs.size();
+
+    this->input_versions.resize(input_count);
+
+    for(Index i = 0; i < input_count; ++i)
+    {
+        auto input = blok_d_ptr->inputs[i].lock();
+
+        this->input_versions[i] = input ? input->get_version() : 0;
+    }
+
+    this->arrived_inputs.assign(input_count, false);
+
+    this->disarm_timer();
+
+    q_ptr->execute();
+}
+
+void
+JoinExecutive::Private::arm_timer
+(
+)
+{
+    this->disarm_timer();
+
+    if(!this->loop || this->timeout == 0)
+    {
+        return;
+    }
+
+    Size waited = Size(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - this->first_arrival_time
+        ).count()
+    );
+
+    // loop timers are periodic: the first tick removes this one
+
+    Size delay = std::max<Size>(
+        this->timeout > waited ? this->timeout - waited : 0,
+        1
+    );
+
+    this->timer_id = this->loop->add_timer(
+        delay,
+        [this]()
+        {
+            this->disarm_timer();
+
+            this->execute();
+        }
+    );
+}
+
+void
+JoinExecutive::Private::disarm_timer
+(
+)
+{
+    if(this->loop)
+    {
+        this->loop->remove(this->timer_id);
+    }
+
+    this->timer_id = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ThreadedExecutive::ThreadedExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+ThreadedExecutive::~ThreadedExecutive
+(
+)
+{
+    d_ptr->stop();
+
+    delete d_ptr;
+}
+
+void
+ThreadedExecutive::on_input_pushed
+(
+    Index index_
+)
+{
+    auto executive_d_ptr = AbstractExecutive::Private::from(this);
+
+    SharedDataSequence item;
+
+    // several inputs pushed during a single visit make a single item
+
+    bool is_changed = executive_d_ptr->snapshot_inputs(
+        d_ptr->input_versions,
+        item,
+        "sb::ThreadedExecutive::on_input_pushed"
+    );
+
+    Size dropped_count = d_ptr->submit(is_changed, std::move(item), {});
+
+    AbstractBlok::Private::from(
+        executive_d_ptr->blok
+    )->input_statistics[index_].dropped_count += dropped_count;
+
+    d_ptr->deliver(false);
+}
+
+void
+ThreadedExecutive::on_output_pulled
+(
+    Index /*index_*/
+)
+{
+    d_ptr->deliver(true);
+}
+
+void
+ThreadedExecutive::on_modified
+(
+)
+{
+    auto executive_d_ptr = AbstractExecutive::Private::from(this);
+
+    Writer writer;
+
+    serialize(*executive_d_ptr->blok, writer);
+
+    // the current inputs must be processed with the new properties
+
+    d_ptr->input_versions.clear();
+
+    SharedDataSequence item;
+
+    bool is_changed = executive_d_ptr->snapshot_inputs(
+        d_ptr->input_versions,
+        item,
+        "sb::ThreadedExecutive::on_modified"
+    );
+
+    d_ptr->submit(
+        is_changed,
+        std::move(item),
+        std::vector<char>(writer.get_buffer())
+    );
+
+    d_ptr->deliver(false);
+}
+
+void
+ThreadedExecutive::poll
+(
+)
+{
+    d_ptr->deliver(false);
+}
+
+void
+ThreadedExecutive::wait
+(
+)
+{
+    d_ptr->deliver(true);
+}
+
+Size
+ThreadedExecutive::get_cancelled_count
+(
+)
+const
+{
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    return d_ptr->cancelled_count;
+}
+
+ThreadedExecutive::Private::Private
+(
+    ThreadedExecutive* q_ptr_
+):
+    q_ptr            (q_ptr_),
+    is_draining      (false),
+    has_pending_item (false),
+    is_running       (false),
+    has_result       (false),
+    cancelled_count  (0),
+    is_stopping      (false)
+{
+}
+
+void
+ThreadedExecutive::Private::start
+(
+)
+{
+    this->replica = AbstractExecutive::Private::from(
+        q_ptr
+    )->create_copy(
+        "sb::ThreadedExecutive::start"
+    );
+
+    this->is_stopping = false;
+}
+
+void
+ThreadedExecutive::Private::stop
+(
+)
+{
+    if(this->replica)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            this->is_stopping = true;
+
+            AbstractBlok::Private::from(
+                this->replica.get()
+            )->cancellation_requested = true;
+        }
+
+        if(this->drain_task)
+        {
+            Executor::help(*this->drain_task);
+        }
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        this->result_condition.wait(
+            lock,
+            [this]
+            (
+            )
+            {
+                return !this->is_draining;
+            }
+        );
+    }
+
+    this->drain_task.reset();
+    this->replica.reset();
+}
+
+Size
+ThreadedExecutive::Private::submit
+(
+    bool has_item_,
+    SharedDataSequence&& item_,
+    std::vector<char>&& properties_
+)
+{
+    if(!this->replica)
+    {
+        this->start();
+    }
+
+    Size dropped_count = 0;
+
+    bool is_drain_needed = false;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if(!properties_.empty())
+        {
+            this->pending_properties = std::move(properties_);
+        }
+
+        if(has_item_)
+        {
+            if(this->has_pending_item)
+            {
+                ++this->cancelled_count;
+
+                ++dropped_count;
+            }
+
+            this->pending_item = std::move(item_);
+            this->has_pending_item = true;
+
+            // the drain task counts the cancelled item once it returns
+
+            if(
+                this->is_running &&
+                !AbstractBlok::Private::from(
+                    this->replica.get()
+                )->cancellation_requested
+            )
+            {
+                AbstractBlok::Private::from(
+                    this->replica.get()
+                )->cancellation_requested = true;
+
+                ++dropped_count;
+            }
+
+            if(!this->is_draining)
+            {
+                this->is_draining = true;
+
+                is_drain_needed = true;
+            }
+        }
+    }
+
+    if(is_drain_needed)
+    {
+        this->drain_task = AbstractExecutive::Private::from(
+            q_ptr
+        )->post(
+            [this]
+            (
+            )
+            {
+                this->drain();
+            }
+        );
+    }
+
+    return dropped_count;
+}
+
+void
+ThreadedExecutive::Private::deliver
+(
+    bool is_blocking_
+)
+{
+    ItemResult last_result;
+
+    if(is_blocking_ && this->drain_task)
+    {
+        // no thread of the executor may be free to drain the items
+
+        Executor::help(*this->drain_task);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        if(is_blocking_)
+        {
+            this->result_condition.wait(
+                lock,
+                [this]
+                (
+                )
+                {
+                    return !this->has_pending_item && !this->is_running;
+                }
+            );
+        }
+
+        if(!this->has_result)
+        {
+            return;
+        }
+
+        last_result = std::move(this->result);
+
+        this->has_result = false;
+    }
+
+    if(last_result.error)
+    {
+        std::rethrow_exception(last_result.error);
+    }
+
+    AbstractExecutive::Private::from(
+        q_ptr
+    )->publish_outputs(
+        last_result.outputs,
+        "sb::ThreadedExecutive::deliver"
+    );
+}
+
+void
+ThreadedExecutive::Private::drain
+(
+)
+{
+    AbstractBlok* replica = this->replica.get();
+
+    auto replica_d_ptr = AbstractBlok::Private::from(replica);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while(!this->is_stopping && this->has_pending_item)
+    {
+        SharedDataSequence item = std::move(this->pending_item);
+        std::vector<char> properties = std::move(this->pending_properties);
+
+        this->pending_properties.clear();
+        this->has_pending_item = false;
+        this->is_running = true;
+
+        replica_d_ptr->cancellation_requested = false;
+
+        lock.unlock();
+
+        ItemResult item_result;
+
+        try
+        {
+            if(!properties.empty())
+            {
+                Reader reader(properties);
+
+                deserialize(*replica, reader);
+            }
+
+            replica->process_batch({item});
+
+            // snapshot the outputs: the copy processes its next item in them
+
+            item_result.outputs = AbstractExecutive::Private::clone_outputs(
+                replica,
+                "sb::ThreadedExecutive::drain"
+            );
+        }
+        catch(...)
+        {
+            item_result.error = std::current_exception();
+        }
+
+        lock.lock();
+
+        this->is_running = false;
+
+        // the outputs of a cancelled item are partial
+
+        if(replica_d_ptr->cancellation_requested)
+        {
+            ++this->cancelled_count;
+        }
+        else
+        {
+            this->result = std::move(item_result);
+            this->has_result = true;
+        }
+
+        this->result_condition.notify_all();
+    }
+
+    this->is_draining = false;
+
+    this->result_condition.notify_all();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncExecutive::AsyncExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+AsyncExecutive::~AsyncExecutive
+(
+)
+{
+    delete d_ptr;
+}
+
+void
+AsyncExecutive::on_input_pushed
+(
+    Index index_
+)
+{
+    if(d_ptr->start())
+    {
+        AbstractBlok::Private::from(
+            AbstractExecutive::Private::from(this)->blok
+        )->input_statistics[index_].dropped_count += 1;
+    }
+}
+
+void
+AsyncExecutive::on_output_pulled
+(
+    Index /*index_*/
+)
+{
+}
+
+void
+AsyncExecutive::on_modified
+(
+)
+{
+    d_ptr->start();
+}
+
+bool
+AsyncExecutive::is_running
+(
+)
+const
+{
+    return d_ptr->is_running;
+}
+
+AsyncExecutive::Private::Private
+(
+    AsyncExecutive* q_ptr_
+):
+    q_ptr      (q_ptr_),
+    handle     (std::make_shared<Private*>(this)),
+    is_running (false),
+    is_pending (false)
+{
+}
+
+bool
+AsyncExecutive::Private::start
+(
+)
+{
+    auto executive_d_ptr = AbstractExecutive::Private::from(q_ptr);
+
+    // a visited blok is executed once, however many inputs were pushed
+
+    if(!Propagation::begin_execution(executive_d_ptr->blok))
+    {
+        return false;
+    }
+
+    if(this->is_running)
+    {
+        bool is_superseded = this->is_pending;
+
+        this->is_pending = true;
+
+        return is_superseded;
+    }
+
+    this->is_running = true;
+
+    executive_d_ptr->prepare_outputs();
+
+    std::weak_ptr<Private*> weak_handle = this->handle;
+
+    // a completion called twice completes once
+
+    auto is_completed = std::make_shared<bool>(false);
+
+    try
+    {
+        executive_d_ptr->blok->process_async(
+            [weak_handle, is_completed]
+            (
+                std::exception_ptr error_
+            )
+            {
+                auto handle = weak_handle.lock();
+
+                if(handle && !*is_completed)
+                {
+                    *is_completed = true;
+
+                    (*handle)->complete(error_);
+                }
+            }
+        );
+    }
+    catch(...)
+    {
+        if(!*is_completed)
+        {
+            *is_completed = true;
+
+            this->is_running = false;
+            this->is_pending = false;
+        }
+
+        throw;
+    }
+
+    return false;
+}
+
+void
+AsyncExecutive::Private::complete
+(
+    std::exception_ptr error_
+)
+{
+    this->is_running = false;
+
+    if(error_)
+    {
+        this->is_pending = false;
+
+        std::rethrow_exception(error_);
+    }
+
+    auto executive_d_ptr = AbstractExecutive::Private::from(q_ptr);
+
+    auto blok_d_ptr = AbstractBlok::Private::from(executive_d_ptr->blok);
+
+    executive_d_ptr->notify_outputs();
+
+    for(Index i = 0; i < blok_d_ptr->outputs.size(); ++i)
+    {
+        executive_d_ptr->blok->push_output(i);
+    }
+
+    if(this->is_pending)
+    {
+        this->is_pending = false;
+
+        this->start();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+PrefetchExecutive::PrefetchExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+PrefetchExecutive::~PrefetchExecutive
+(
+)
+{
+    d_ptr->stop();
+
+    delete d_ptr;
+}
+
+void
+PrefetchExecutive::on_input_pushed
+(
+    Index /*index_*/
+)
+{
+    // the prefetched pieces were computed from the previous inputs
+
+    d_ptr->invalidate();
+}
+
+void
+PrefetchExecutive::on_output_pulled
+(
+    Index /*index_*/
+)
+{
+    if(AbstractBlok::Private::get_change_epoch() != d_ptr->change_epoch)
+    {
+        d_ptr->invalidate();
+    }
+
+    Piece piece = this->get_blok()->get_requested_piece();
+
+    if(!d_ptr->take(piece))
+    {
+        this->execute();
+    }
+
+    d_ptr->anticipate(piece);
+}
+
+void
+PrefetchExecutive::on_modified
+(
+)
+{
+}
+
+void
+PrefetchExecutive::wait
+(
+)
+{
+    if(d_ptr->drain_task)
+    {
+        // no thread of the executor may be free to compute the pieces
+
+        Executor::help(*d_ptr->drain_task);
+    }
+
+    std::unique_lock<std::mutex> lock(d_ptr->mutex);
+
+    d_ptr->drain_condition.wait(
+        lock,
+        [this]
+        (
+        )
+        {
+            return !d_ptr->is_draining;
+        }
+    );
+}
+
+Size
+PrefetchExecutive::get_hit_count
+(
+)
+const
+{
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    return d_ptr->hit_count;
+}
+
+Size
+PrefetchExecutive::get_depth
+(
+)
+const
+{
+    return d_ptr->depth;
+}
+
+void
+PrefetchExecutive::set_depth
+(
+    const Size& value_
+)
+{
+    d_ptr->depth = value_;
+
+    d_ptr->invalidate();
+}
+
+PrefetchExecutive::Private::Private
+(
+    PrefetchExecutive* q_ptr_
+):
+    q_ptr           (q_ptr_),
+    is_draining     (false),
+    is_stopping     (false),
+    generation      (0),
+    hit_count       (0),
+    depth           (DEFAULT_PREFETCH_DEPTH),
+    change_epoch    (0),
+    has_last_piece  (false),
+    last_piece      (WHOLE_PIECE)
+{
+}
+
+void
+PrefetchExecutive::Private::start
+(
+)
+{
+    this->replica = AbstractExecutive::Private::from(
+        q_ptr
+    )->create_copy(
+        "sb::PrefetchExecutive::start"
+    );
+
+    this->is_stopping = false;
+
+    // creating the copy isn't a change of the pulled graph
+
+    this->change_epoch = AbstractBlok::Private::get_change_epoch();
+}
+
+void
+PrefetchExecutive::Private::stop
+(
+)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        this->is_stopping = true;
+    }
+
+    if(this->drain_task)
+    {
+        Executor::help(*this->drain_task);
+    }
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    this->drain_condition.wait(
+        lock,
+        [this]
+        (
+        )
+        {
+            return !this->is_draining;
+        }
+    );
+
+    lock.unlock();
+
+    this->drain_task.reset();
+    this->replica.reset();
+}
+
+void
+PrefetchExecutive::Private::invalidate
+(
+)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        ++this->generation;
+
+        this->expected_pieces.clear();
+        this->prefetched_pieces.clear();
+    }
+
+    this->has_last_piece = false;
+
+    if(this->replica)
+    {
+        auto executive_d_ptr = AbstractExecutive::Private::from(q_ptr);
+
+        // the copy is only used under the execution mutex of the blok
+
+        std::lock_guard<std::recursive_mutex> lock(
+            executive_d_ptr->execution_mutex
+        );
+
+        Writer writer;
+
+        serialize(*executive_d_ptr->blok, writer);
+
+        Reader reader(writer.get_buffer());
+
+        deserialize(*this->replica, reader);
+    }
+
+    // giving the properties to the copy modified it
+
+    this->change_epoch = AbstractBlok::Private::get_change_epoch();
+}
+
+bool
+PrefetchExecutive::Private::take
+(
+    const Piece& piece_
+)
+{
+    SharedDataSequence outputs;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        auto prefetched_piece = std::find_if(
+            this->prefetched_pieces.begin(),
+            this->prefetched_pieces.end(),
+            [&piece_]
+            (
+                const PrefetchedPiece& prefetched_piece_
+            )
+            {
+                return prefetched_piece_.piece == piece_;
+            }
+        );
+
+        if(prefetched_piece == this->prefetched_pieces.end())
+        {
+            return false;
+        }
+
+        outputs = std::move(prefetched_piece->outputs);
+
+        this->prefetched_pieces.erase(prefetched_piece);
+
+        ++this->hit_count;
+    }
+
+    AbstractExecutive::Private::from(q_ptr)->restore_outputs(
+        outputs,
+        "sb::PrefetchExecutive::take"
+    );
+
+    return true;
+}
+
+void
+PrefetchExecutive::Private::anticipate
+(
+    const Piece& piece_
+)
+{
+    bool is_sequential = (
+        this->has_last_piece &&
+        piece_ != WHOLE_PIECE &&
+        piece_.size != 0 &&
+        piece_.size == this->last_piece.size &&
+        piece_.offset == this->last_piece.offset + this->last_piece.size
+    );
+
+    this->has_last_piece = true;
+    this->last_piece = piece_;
+
+    auto executive_d_ptr = AbstractExecutive::Private::from(q_ptr);
+
+    auto blok_d_ptr = AbstractBlok::Private::from(executive_d_ptr->blok);
+
+    Size extent = (
+        blok_d_ptr->outputs.empty()
+    ) ? (
+        UNKNOWN_EXTENT
+    ) : (
+        blok_d_ptr->outputs[0]->get_extent()
+    );
+
+    if(is_sequential && this->depth != 0 && !this->replica)
+    {
+        this->start();
+    }
+
+    bool is_drain_needed = false;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        // pieces behind the pulled one won't be pulled
+
+        auto is_behind = [&piece_]
+        (
+            const Piece& piece_behind_
+        )
+        {
+            return piece_behind_.offset <= piece_.offset;
+        };
+
+        this->expected_pieces.erase(
+            std::remove_if(
+                this->expected_pieces.begin(),
+                this->expected_pieces.end(),
+                is_behind
+            ),
+            this->expected_pieces.end()
+        );
+
+        this->prefetched_pieces.erase(
+            std::remove_if(
+                this->prefetched_pieces.begin(),
+                this->prefetched_pieces.end(),
+                [&is_behind]
+                (
+                    const PrefetchedPiece& prefetched_piece_
+                )
+                {
+                    return is_behind(prefetched_piece_.piece);
+                }
+            ),
+            this->prefetched_pieces.end()
+        );
+
+        if(!is_sequential)
+        {
+            this->expected_pieces.clear();
+            this->prefetched_pieces.clear();
+
+            return;
+        }
+
+        for(Size i = 1; i <= this->depth; ++i)
+        {
+            Index offset = piece_.offset + i * piece_.size;
+
+            if(extent != UNKNOWN_EXTENT && offset >= extent)
+            {
+                break;
+            }
+
+            Piece next_piece = {
+                offset,
+                extent == UNKNOWN_EXTENT ?
+                    piece_.size :
+                    std::min(piece_.size, extent - offset)
+            };
+
+            bool is_known = std::find(
+                this->expected_pieces.begin(),
+                this->expected_pieces.end(),
+                next_piece
+            ) != this->expected_pieces.end() || std::any_of(
+                this->prefetched_pieces.begin(),
+                this->prefetched_pieces.end(),
+                [&next_piece]
+                (
+                    const PrefetchedPiece& prefetched_piece_
+                )
+                {
+                    return prefetched_piece_.piece == next_piece;
+                }
+            );
+
+            if(!is_known)
+            {
+                this->expected_pieces.push_back(next_piece);
+            }
+        }
+
+        if(!this->expected_pieces.empty() && !this->is_draining)
+        {
+            this->is_draining = true;
+
+            is_drain_needed = true;
+        }
+    }
+
+    if(is_drain_needed)
+    {
+        this->drain_task = executive_d_ptr->post(
+            [this]
+            (
+            )
+            {
+                this->drain();
+            }
+        );
+    }
+}
+
+void
+PrefetchExecutive::Private::drain
+(
+)
+{
+    auto executive_d_ptr = AbstractExecutive::Private::from(q_ptr);
+
+    auto blok_d_ptr = AbstractBlok::Private::from(executive_d_ptr->blok);
+
+    AbstractBlok* replica = this->replica.get();
+
+    auto replica_d_ptr = AbstractBlok::Private::from(replica);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while(!this->is_stopping && !this->expected_pieces.empty())
+    {
+        Piece piece = this->expected_pieces.front();
+
+        this->expected_pieces.pop_front();
+
+        Size generation = this->generation;
+
+        lock.unlock();
+
+        SharedDataSequence outputs;
+
+        {
+            // the upstream bloks serve the pulls of the blok and of its copy
+            // one after the other
+
+            std::lock_guard<std::recursive_mutex> execution_lock(
+                executive_d_ptr->execution_mutex
+            );
+
+            SharedDataSequence item;
+
+            bool is_complete = true;
+
+            for(const auto& weak_input : blok_d_ptr->inputs)
+            {
+                item.push_back(weak_input.lock());
+
+                is_complete = is_complete && item.back() != SB_NULLPTR;
+            }
+
+            try
+            {
+                if(is_complete)
+                {
+                    // the copy pulls the inputs of the blok, with the piece
+
+                    replica_d_ptr->requested_piece = piece;
+                    replica_d_ptr->inputs_pulled = false;
+
+                    replica->process_batch({item});
+
+                    outputs = AbstractExecutive::Private::clone_outputs(
+                        replica,
+                        "sb::PrefetchExecutive::drain"
+                    );
+                }
+            }
+            catch(...)
+            {
+                // the pull of the piece will execute the blok, raising the
+                // error again if processing failed
+
+                outputs.clear();
+            }
+        }
+
+        lock.lock();
+
+        if(!outputs.empty() && generation == this->generation)
+        {
+            this->prefetched_pieces.push_back(
+                PrefetchedPiece{piece, std::move(outputs)}
+            );
+        }
+    }
+
+    this->is_draining = false;
+
+    this->drain_condition.notify_all();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AdaptiveExecutive::AdaptiveExecutive
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+AdaptiveExecutive::~AdaptiveExecutive
+(
+)
+{
+    delete d_ptr;
+}
+
+void
+AdaptiveExecutive::on_input_pushed
+(
+    Index index_
+)
+{
+    d_ptr->evaluate();
+
+    ++d_ptr->push_count;
+
+    d_ptr->forward(
+        d_ptr->mode == Private::Mode::EAGER,
+        [this, index_]
+        (
+        )
+        {
+            d_ptr->strategy->on_input_pushed(index_);
+        }
+    );
+}
+
+void
+AdaptiveExecutive::on_output_pulled
+(
+    Index index_
+)
+{
+    d_ptr->evaluate();
+
+    ++d_ptr->pull_count;
+
+    d_ptr->forward(
+        d_ptr->mode == Private::Mode::LAZY,
+        [this, index_]
+        (
+        )
+        {
+            d_ptr->strategy->on_output_pulled(index_);
+        }
+    );
+}
+
+void
+AdaptiveExecutive::on_modified
+(
+)
+{
+    d_ptr->evaluate();
+
+    d_ptr->forward(
+        d_ptr->mode == Private::Mode::EAGER,
+        [this]
+        (
+        )
+        {
+            d_ptr->strategy->on_modified();
+        }
+    );
+}
+
+void
+AdaptiveExecutive::wait
+(
+)
+{
+    if(d_ptr->mode == Private::Mode::PARALLEL)
+    {
+        static_cast<ReplicatedExecutive*>(d_ptr->strategy.get())->wait();
+    }
+    else if(d_ptr->mode == Private::Mode::COALESCING)
+    {
+        static_cast<ThreadedExecutive*>(d_ptr->strategy.get())->wait();
+    }
+}
+
+std::string
+AdaptiveExecutive::get_mode
+(
+)
+const
+{
+    return Private::get_name(d_ptr->mode);
+}
+
+Size
+AdaptiveExecutive::get_window
+(
+)
+const
+{
+    return d_ptr->window;
+}
+
+void
+AdaptiveExecutive::set_window
+(
+    const Size& value_
+)
+{
+    d_ptr->window = std::max<Size>(value_, 1);
+}
+
+Size
+AdaptiveExecutive::get_hysteresis
+(
+)
+const
+{
+    return d_ptr->hysteresis;
+}
+
+void
+AdaptiveExecutive::set_hysteresis
+(
+    const Size& value_
+)
+{
+    d_ptr->hysteresis = std::max<Size>(value_, 1);
+}
+
+AdaptiveExecutive::Private::Private
+(
+    AdaptiveExecutive* q_ptr_
+):
+    q_ptr           (q_ptr_),
+    mode            (Mode::EAGER),
+    window          (DEFAULT_ADAPTIVE_WINDOW),
+    hysteresis      (DEFAULT_ADAPTIVE_HYSTERESIS),
+    push_count      (0),
+    pull_count      (0),
+    execution_count (0),
+    execution_time  (0),
+    cost            (0),
+    load            (0),
+    candidate       (Mode::EAGER),
+    candidate_count (0)
+{
+}
+
+void
+AdaptiveExecutive::Private::evaluate
+(
+)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    // the blok is only known once the executive receives its first event
+
+    if(!this->strategy)
+    {
+        this->use_mode(this->mode);
+
+        this->window_start = now;
+
+        return;
+    }
+
+    auto elapsed = now - this->window_start;
+
+    if(elapsed < std::chrono::milliseconds(this->window))
+    {
+        return;
+    }
+
+    double seconds = std::chrono::duration<double>(elapsed).count();
+
+    if(this->execution_count != 0)
+    {
+        double sample = std::chrono::duration<double>(
+            this->execution_time
+        ).count() / this->execution_count;
+
+        // smooth the measures over the windows
+
+        this->cost = (this->cost == 0) ? sample : (this->cost + sample) / 2;
+    }
+
+    double push_rate = this->push_count / seconds;
+    double pull_rate = this->pull_count / seconds;
+
+    this->load = push_rate * this->cost;
+
+    Mode selected_mode = this->select(push_rate, pull_rate);
+
+    this->window_start = now;
+    this->push_count = 0;
+    this->pull_count = 0;
+    this->execution_count = 0;
+    this->execution_time = std::chrono::steady_clock::duration::zero();
+
+    if(selected_mode == this->mode)
+    {
+        this->candidate_count = 0;
+
+        return;
+    }
+
+    if(this->candidate_count == 0 || selected_mode != this->candidate)
+    {
+        this->candidate = selected_mode;
+        this->candidate_count = 0;
+    }
+
+    if(++this->candidate_count >= this->hysteresis)
+    {
+        this->use_mode(selected_mode);
+    }
+}
+
+AdaptiveExecutive::Private::Mode
+AdaptiveExecutive::Private::select
+(
+    double push_rate_,
+    double pull_rate_
+)
+const
+{
+    // each limit is eased for the mode it selected, so that the mode is only
+    // left once the activity clearly moved past it
+
+    double push_pull_ratio = (this->mode == Mode::LAZY) ? 1 : 2;
+
+    if(pull_rate_ > 0 && push_rate_ >= push_pull_ratio * pull_rate_)
+    {
+        return Mode::LAZY;
+    }
+
+    bool is_background = (
+        this->mode == Mode::PARALLEL || this->mode == Mode::COALESCING
+    );
+
+    if(this->load < (is_background ? 0.25 : 0.5))
+    {
+        return Mode::EAGER;
+    }
+
+    double thread_count = static_cast<double>(Executor::get_thread_count());
+
+    double parallel_load = (
+        this->mode == Mode::COALESCING
+    ) ? (
+        thread_count / 2
+    ) : (
+        thread_count
+    );
+
+    if(this->load < parallel_load)
+    {
+        return Mode::PARALLEL;
+    }
+
+    return Mode::COALESCING;
+}
+
+void
+AdaptiveExecutive::Private::use_mode
+(
+    Mode mode_
+)
+{
+    AbstractBlok* blok = AbstractExecutive::Private::from(q_ptr)->blok;
+
+    // the pushes ignored in lazy mode must reach the followers
+
+    bool is_catching_up = this->strategy && this->mode == Mode::LAZY;
+
+    if(this->strategy)
+    {
+        // the results computed in the background belong to past pushes
+
+        q_ptr->wait();
+    }
+
+    std::string name;
+
+    if(mode_ == Mode::EAGER)
+    {
+        sb::register_object<PushExecutive>();
+
+        name = get_type_name<PushExecutive>();
+    }
+    else if(mode_ == Mode::LAZY)
+    {
+        sb::register_object<PullExecutive>();
+
+        name = get_type_name<PullExecutive>();
+    }
+    else if(mode_ == Mode::PARALLEL)
+    {
+        sb::register_object<ReplicatedExecutive>();
+
+        name = get_type_name<ReplicatedExecutive>();
+    }
+    else
+    {
+        sb::register_object<ThreadedExecutive>();
+
+        name = get_type_name<ThreadedExecutive>();
+    }
+
+    this->strategy = create_unique_executive(name);
+
+    AbstractExecutive::Private::from(this->strategy)->blok = blok;
+
+    if(mode_ == Mode::PARALLEL)
+    {
+        // enough copies to absorb the load, one per thread at most
+
+        Size thread_count = std::max<Size>(Executor::get_thread_count(), 2);
+
+        Size replica_count = static_cast<Size>(std::ceil(this->load)) + 1;
+
+        static_cast<ReplicatedExecutive*>(
+            this->strategy.get()
+        )->set_replica_count(
+            std::min(std::max<Size>(replica_count, 2), thread_count)
+        );
+    }
+
+    this->mode = mode_;
+    this->candidate_count = 0;
+
+    if(is_catching_up)
+    {
+        this->strategy->on_modified();
+    }
+}
+
+void
+AdaptiveExecutive::Private::forward
+(
+    bool is_executing_,
+    const std::function<void()>& event_
+)
+{
+    if(!is_executing_)
+    {
+        event_();
+
+        return;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    event_();
+
+    this->execution_time += std::chrono::steady_clock::now() - start_time;
+
+    ++this->execution_count;
+}
+
+std::string
+AdaptiveExecutive::Private::get_name
+(
+    Mode mode_
+)
+{
+    if(mode_ == Mode::LAZY)
+    {
+        return "lazy";
+    }
+    else if(mode_ == Mode::PARALLEL)
+    {
+        return "parallel";
+    }
+    else if(mode_ == Mode::COALESCING)
+    {
+        return "coalescing";
+    }
+
+    return "eager";
+}
@@ -19,6 +19,7 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 #define SB_EXECUTIVE_H
 
 #include <sb-core/sb-abstractexecutive.h>
+#include <sb-core/sb-eventloop.h>
 
 namespace sb
 {
@@ -104,6 +105,14 @@ public:
     )
     SB_OVERRIDE;
 
+    /// Does nothing: the blok is executed when its outputs are pulled.
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
 private:
 
     /// \cond INTERNAL
@@ -158,6 +167,890 @@ private:
 
 };
 
+/// \brief The BatchingExecutive class executes its blok on batches of pushed
+/// items.
+///
+/// Each push snapshots the inputs of the blok as one item. The items are
+/// handed over to AbstractBlok::process_batch() once "batch_size" items were
+/// gathered, or once the oldest pending item waited "max_delay"
+/// milliseconds. Pulling the outputs of the blok, modifying it or calling
+/// flush() processes the pending items.
+///
+/// The delay is timed by the EventLoop given to attach(), whose thread must
+/// push the inputs. A detached executive only checks the delay when an item
+/// is pushed: the last items of a burst wait for the next push.
+///
+/// The types of the inputs must support AbstractData::copy(): a push of an
+/// input that can't be snapshotted raises std::invalid_argument.
+class SB_CORE_API BatchingExecutive : public AbstractExecutive
+{
+
+    SB_SELF(sb::BatchingExecutive)
+
+    SB_NAME("sb.BatchingExecutive")
+
+    SB_PROPERTIES({
+        "batch_size",
+        &BatchingExecutive::get_batch_size,
+        &BatchingExecutive::set_batch_size
+    }, {
+        "max_delay",
+        &BatchingExecutive::get_max_delay,
+        &BatchingExecutive::set_max_delay
+    })
+
+public:
+
+    class Private;
+
+    /// Constructs an executive gathering up to DEFAULT_BATCH_SIZE items, for
+    /// at most DEFAULT_MAX_BATCH_DELAY milliseconds, attached to no loop.
+    BatchingExecutive
+    (
+    );
+
+    /// Destroys this object, detaching it from its loop.
+    virtual
+    ~BatchingExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
+    /// Processes the pending items, if any.
+    void
+    flush
+    (
+    );
+
+    /// Processes the pending items from \a loop_ once the oldest one waited
+    /// "max_delay" milliseconds, after detaching this executive from its
+    /// previous loop.
+    ///
+    /// The loop must outlive the executive, or the executive must be
+    /// detached before the loop is destroyed.
+    void
+    attach
+    (
+        EventLoop& loop_
+    );
+
+    /// Stops timing the pending items from a loop.
+    void
+    detach
+    (
+    );
+
+    /// Returns the number of items gathered but not processed yet.
+    Size
+    get_pending_count
+    (
+    )
+    const;
+
+    Size
+    get_batch_size
+    (
+    )
+    const;
+
+    void
+    set_batch_size
+    (
+        const Size& value_
+    );
+
+    Size
+    get_max_delay
+    (
+    )
+    const;
+
+    void
+    set_max_delay
+    (
+        const Size& value_
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The ReplicatedExecutive class processes the pushed items of its
+/// blok on several copies of it, running concurrently.
+///
+/// Each push snapshots the inputs of the blok as one item, numbered in
+/// sequence. The items are dispatched to "replicas" copies of the blok,
+/// created with create_unique_blok() and given the properties of the blok.
+/// The "dispatch" property selects how: "round_robin" cycles through the
+/// copies, "key_hash" sends the items whose first input holds equal keys to
+/// the same copy. The key is the value of the property "dispatch_key" of the
+/// first input, or its whole content if "dispatch_key" is empty: hashing the
+/// content costs as much as reading it. Items whose key can't be hashed are
+/// dispatched in round robin.
+///
+/// A reorder buffer restores the sequence order of the results, which are
+/// copied into the outputs of the blok and pushed from the thread owning the
+/// blok: at each push, at each pull and by wait(). Once attach() gave the
+/// executive the EventLoop of that thread, the results are also pushed from
+/// the loop as soon as the copies produce them.
+///
+/// The copies run on the threads shared by the whole library, in the
+/// scheduling group of the blok. Items waiting for a copy are bounded by the
+/// policy of the input they were pushed through, see
+/// AbstractBlok::set_input_policy().
+///
+/// The blok must be registered, and the copies must not share state with
+/// the blok besides its properties. The types of its inputs and outputs
+/// must support AbstractData::copy(), as the copies never share live data
+/// with the blok: items that can't be copied raise std::invalid_argument.
+class SB_CORE_API ReplicatedExecutive : public AbstractExecutive
+{
+
+    SB_SELF(sb::ReplicatedExecutive)
+
+    SB_NAME("sb.ReplicatedExecutive")
+
+    SB_PROPERTIES({
+        "replicas",
+        &ReplicatedExecutive::get_replica_count,
+        &ReplicatedExecutive::set_replica_count
+    }, {
+        "dispatch",
+        &ReplicatedExecutive::get_dispatch,
+        &ReplicatedExecutive::set_dispatch
+    }, {
+        "dispatch_key",
+        &ReplicatedExecutive::get_dispatch_key,
+        &ReplicatedExecutive::set_dispatch_key
+    })
+
+public:
+
+    class Private;
+
+    /// Constructs an executive using DEFAULT_REPLICA_COUNT copies of its
+    /// blok, dispatching the items in round robin, attached to no loop.
+    ReplicatedExecutive
+    (
+    );
+
+    /// Destroys this object, after the copies finished their current item.
+    virtual
+    ~ReplicatedExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    /// Waits for the processed items, then gives the copies the new
+    /// properties of the blok and dispatches its current inputs again.
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
+    /// Waits until all the dispatched items were processed and pushes their
+    /// results.
+    ///
+    /// An exception raised by a copy is raised again by this function.
+    void
+    wait
+    (
+    );
+
+    /// Pushes the results from \a loop_ as soon as the copies produce them,
+    /// after detaching this executive from its previous loop.
+    ///
+    /// The loop must be dispatched by the thread owning the blok. An
+    /// exception raised by a copy is then raised from the dispatch of the
+    /// loop. The loop must outlive the executive, or the executive must be
+    /// detached before the loop is destroyed.
+    void
+    attach
+    (
+        EventLoop& loop_
+    );
+
+    /// Stops pushing the results from a loop.
+    void
+    detach
+    (
+    );
+
+    Size
+    get_replica_count
+    (
+    )
+    const;
+
+    /// Sets the number of copies of the blok to \a value_, after the
+    /// dispatched items were processed.
+    void
+    set_replica_count
+    (
+        const Size& value_
+    );
+
+    std::string
+    get_dispatch
+    (
+    )
+    const;
+
+    /// Sets the dispatch policy to \a value_, either "round_robin" or
+    /// "key_hash".
+    ///
+    /// An exception is raised if \a value_ is not one of them.
+    void
+    set_dispatch
+    (
+        const std::string& value_
+    );
+
+    std::string
+    get_dispatch_key
+    (
+    )
+    const;
+
+    /// Sets the name of the property of the first input hashed by the
+    /// "key_hash" dispatch policy to \a value_; an empty name hashes all
+    /// the readable properties.
+    void
+    set_dispatch_key
+    (
+        const std::string& value_
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The JoinExecutive class is an executive processing its blok once
+/// all its required inputs received new data.
+///
+/// Each push marks the pushed input as arrived if it holds a new version
+/// since the last execution. The blok is processed once all its required
+/// inputs arrived, so that it sees the inputs of the same cycle together
+/// instead of running once per input with mixed old and new data. All the
+/// inputs are required by default: see set_input_required().
+///
+/// If "timeout" is not zero, the blok is processed with the inputs that
+/// arrived once "timeout" milliseconds elapsed since the first arrival of the
+/// cycle. Pulling the outputs of the blok or modifying it processes the blok
+/// at once.
+///
+/// The timeout is timed by the EventLoop given to attach(), whose thread
+/// must push the inputs. A detached executive only checks the timeout when
+/// an input arrives: a cycle missing an input waits for the next arrival.
+class SB_CORE_API JoinExecutive : public AbstractExecutive
+{
+
+    SB_SELF(sb::JoinExecutive)
+
+    SB_NAME("sb.JoinExecutive")
+
+    SB_PROPERTIES({
+        "timeout",
+        &JoinExecutive::get_timeout,
+        &JoinExecutive::set_timeout
+    })
+
+public:
+
+    class Private;
+
+    /// Constructs an executive waiting for all the inputs, without timeout,
+    /// attached to no loop.
+    JoinExecutive
+    (
+    );
+
+    /// Destroys this object, detaching it from its loop.
+    virtual
+    ~JoinExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
+    /// Returns the number of inputs which arrived since the last execution.
+    Size
+    get_arrived_count
+    (
+    )
+    const;
+
+    /// Returns \b true if the blok waits for the input \a index_ before
+    /// processing.
+    bool
+    is_input_required
+    (
+        Index index_
+    )
+    const;
+
+    /// Sets whether the blok waits for the input \a index_ before processing.
+    ///
+    /// An optional input is processed with the next cycle of the required
+    /// ones; a blok without required inputs is processed at each push.
+    void
+    set_input_required
+    (
+        Index index_,
+        bool value_
+    );
+
+    /// Processes the blok from \a loop_ once the timeout of a cycle elapsed,
+    /// after detaching this executive from its previous loop.
+    ///
+    /// The loop must outlive the executive, or the executive must be
+    /// detached before the loop is destroyed.
+    void
+    attach
+    (
+        EventLoop& loop_
+    );
+
+    /// Stops timing the cycles from a loop.
+    void
+    detach
+    (
+    );
+
+    Size
+    get_timeout
+    (
+    )
+    const;
+
+    void
+    set_timeout
+    (
+        const Size& value_
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The ThreadedExecutive class is an executive processing its blok in
+/// the background, cancelling the items superseded by newer ones.
+///
+/// Each push or modification snapshots the inputs and the properties of the
+/// blok as an item, processed by a copy of the blok on the threads shared
+/// by the whole library, in the scheduling group of the blok. Only the
+/// newest item waits for the copy: it replaces the item waiting before it,
+/// and requests the cancellation of the item being processed.
+/// The copy should check AbstractBlok::is_cancellation_requested() during
+/// long computations; the outputs of a cancelled item are discarded.
+///
+/// An interactive change thus waits for a single computation, instead of a
+/// queue of stale ones. The results are copied into the outputs of the blok
+/// and pushed from the thread owning the blok: at each push, at each pull,
+/// and by poll() and wait().
+///
+/// The blok must be registered, and the copy must not share state with the
+/// blok besides its properties. The types of its inputs and outputs must
+/// support AbstractData::copy(), as the copy never shares live data with
+/// the blok: items that can't be copied raise std::invalid_argument.
+class SB_CORE_API ThreadedExecutive : public AbstractExecutive
+{
+
+    SB_NAME("sb.ThreadedExecutive")
+
+public:
+
+    class Private;
+
+    /// Constructs an executive whose copy is created at the first item.
+    ThreadedExecutive
+    (
+    );
+
+    /// Destroys this object, after cancelling the current item.
+    virtual
+    ~ThreadedExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
+    /// Pushes the result of the last processed item, if it wasn't pushed
+    /// yet, without waiting.
+    ///
+    /// An exception raised by the copy is raised again by this function.
+    void
+    poll
+    (
+    );
+
+    /// Waits for the newest item, then pushes its result.
+    ///
+    /// An exception raised by the copy is raised again by this function.
+    void
+    wait
+    (
+    );
+
+    /// Returns the number of items cancelled or replaced before being
+    /// processed.
+    Size
+    get_cancelled_count
+    (
+    )
+    const;
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The AsyncExecutive class is an executive starting its blok
+/// without waiting for it to complete.
+///
+/// Each push or modification calls AbstractBlok::process_async(); the
+/// outputs are pushed when the blok calls the given completion. Pushes and
+/// modifications arriving before that are merged into a single execution,
+/// started once the current one completes. Pulls don't execute the blok:
+/// they read the outputs of the last completed execution.
+///
+/// I/O-bound bloks thus wait without stalling the push cascade, nor holding
+/// a thread. Bloks not overriding process_async() complete at once, as with
+/// a PushExecutive. The completion must be called from the thread owning the
+/// blok, and raises again the exception it is given; it is ignored once the
+/// executive is destroyed.
+class SB_CORE_API AsyncExecutive : public AbstractExecutive
+{
+
+    SB_NAME("sb.AsyncExecutive")
+
+public:
+
+    class Private;
+
+    /// Constructs an executive.
+    AsyncExecutive
+    (
+    );
+
+    /// Destroys this object; the completion of a running execution is
+    /// ignored.
+    virtual
+    ~AsyncExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
+    /// Returns \b true if an execution was started and didn't complete yet;
+    /// returns \b false otherwise.
+    bool
+    is_running
+    (
+    )
+    const;
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The PrefetchExecutive class is an executive executing its blok
+/// when its outputs are pulled, computing ahead the pieces likely to be
+/// pulled next.
+///
+/// Once two consecutive pulls request adjacent pieces of the same size,
+/// the executive expects the next pieces to follow: the next "depth" pieces,
+/// within the extent of the outputs, are computed in the background by a
+/// copy of the blok, which pulls its inputs like the blok. The prefetched
+/// pieces are held until they are pulled, or until the access pattern
+/// breaks. A pull of a prefetched piece copies it into the outputs without
+/// executing the blok; a pull of another piece executes the blok, as with a
+/// PullExecutive.
+///
+/// A consumer iterating over pieces thus processes a piece while the next
+/// ones are computed upstream. The prefetched pieces are discarded when the
+/// graph changes or when a blok is modified. The copy runs on the threads
+/// shared by the whole library, in the scheduling group of the blok; pulls
+/// of the blok wait for the piece the copy is computing.
+///
+/// The blok must be registered, and the copy must not share state with the
+/// blok besides its properties. Pieces whose outputs don't support
+/// AbstractData::copy() are not prefetched: their pulls execute the blok.
+class SB_CORE_API PrefetchExecutive : public AbstractExecutive
+{
+
+    SB_SELF(sb::PrefetchExecutive)
+
+    SB_NAME("sb.PrefetchExecutive")
+
+    SB_PROPERTIES({
+        "depth",
+        &PrefetchExecutive::get_depth,
+        &PrefetchExecutive::set_depth
+    })
+
+public:
+
+    class Private;
+
+    /// Constructs an executive prefetching DEFAULT_PREFETCH_DEPTH pieces.
+    PrefetchExecutive
+    (
+    );
+
+    /// Destroys this object, after the copy finished its current piece.
+    virtual
+    ~PrefetchExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
+    /// Waits until the expected pieces were prefetched.
+    void
+    wait
+    (
+    );
+
+    /// Returns the number of pulls served by a prefetched piece.
+    Size
+    get_hit_count
+    (
+    )
+    const;
+
+    Size
+    get_depth
+    (
+    )
+    const;
+
+    /// Sets the number of pieces computed ahead to \a value_; zero disables
+    /// prefetching.
+    void
+    set_depth
+    (
+        const Size& value_
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The AdaptiveExecutive class is an executive choosing how to
+/// execute its blok from the activity it observes.
+///
+/// The executive counts the pushes of the inputs and the pulls of the
+/// outputs of the blok, and measures the time the blok takes to process.
+/// Every "window" milliseconds, it selects one of the following modes:
+/// - "eager" executes the blok at each push, as a PushExecutive;
+/// - "lazy" executes the blok at each pull, as a PullExecutive, once the
+/// inputs are pushed at least twice as often as the outputs are pulled;
+/// - "parallel" processes the pushed items on copies of the blok, as a
+/// ReplicatedExecutive, once processing takes more than half of the time
+/// between the pushes;
+/// - "coalescing" processes only the newest pushed item in the background,
+/// as a ThreadedExecutive, once the threads shared by the whole library
+/// can't process all the pushed items.
+///
+/// A mode is only left once the activity moved clearly past the limit that
+/// selected it, and after "hysteresis" consecutive windows selecting the
+/// same new mode. The pushes ignored in lazy mode are caught up by the next
+/// mode. The processing time is measured in the eager and lazy modes only:
+/// the other modes keep the last measure.
+///
+/// The parallel and coalescing modes require the blok to be registered, and
+/// the copies not to share state with the blok besides its properties.
+class SB_CORE_API AdaptiveExecutive : public AbstractExecutive
+{
+
+    SB_SELF(sb::AdaptiveExecutive)
+
+    SB_NAME("sb.AdaptiveExecutive")
+
+    SB_PROPERTIES({
+        "mode",
+        &AdaptiveExecutive::get_mode
+    }, {
+        "window",
+        &AdaptiveExecutive::get_window,
+        &AdaptiveExecutive::set_window
+    }, {
+        "hysteresis",
+        &AdaptiveExecutive::get_hysteresis,
+        &AdaptiveExecutive::set_hysteresis
+    })
+
+public:
+
+    class Private;
+
+    /// Constructs an executive in eager mode.
+    AdaptiveExecutive
+    (
+    );
+
+    /// Destroys this object and the executive of its current mode.
+    virtual
+    ~AdaptiveExecutive
+    (
+    );
+
+    virtual
+    void
+    on_input_pushed
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_output_pulled
+    (
+        Index index_
+    )
+    SB_OVERRIDE;
+
+    virtual
+    void
+    on_modified
+    (
+    )
+    SB_OVERRIDE;
+
+    /// Waits until the items processed in the background were processed and
+    /// pushes their results.
+    ///
+    /// An exception raised by a copy of the blok is raised again by this
+    /// function.
+    void
+    wait
+    (
+    );
+
+    /// Returns the current mode: "eager", "lazy", "parallel" or
+    /// "coalescing".
+    std::string
+    get_mode
+    (
+    )
+    const;
+
+    Size
+    get_window
+    (
+    )
+    const;
+
+    /// Sets the duration, in milliseconds, over which the activity is
+    /// measured before selecting a mode; zero is taken as one.
+    void
+    set_window
+    (
+        const Size& value_
+    );
+
+    Size
+    get_hysteresis
+    (
+    )
+    const;
+
+    /// Sets the number of consecutive windows that must select a new mode
+    /// before it is used; zero is taken as one.
+    void
+    set_hysteresis
+    (
+        const Size& value_
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// Default number of copies of a blok using a ReplicatedExecutive.
+const Size
+DEFAULT_REPLICA_COUNT = 2;
+
+/// Default number of items of a batch.
+const Size
+DEFAULT_BATCH_SIZE = 64;
+
+/// Default delay, in milliseconds, after which a partial batch is processed.
+const Size
+DEFAULT_MAX_BATCH_DELAY = 10;
+
+/// Default number of pieces computed ahead by a PrefetchExecutive.
+const Size
+DEFAULT_PREFETCH_DEPTH = 2;
+
+/// Default duration, in milliseconds, of the windows measured by an
+/// AdaptiveExecutive.
+const Size
+DEFAULT_ADAPTIVE_WINDOW = 100;
+
+/// Default number of windows confirming a new mode of an AdaptiveExecutive.
+const Size
+DEFAULT_ADAPTIVE_HYSTERESIS = 3;
+
 }
 
 #endif // SB_EXECUTIVE_H
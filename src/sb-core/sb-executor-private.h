@@ -0,0 +1,325 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EXECUTOR_PRIVATE_H
+#define SB_EXECUTOR_PRIVATE_H
+
+#include <sb-core/sb-executor.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sb
+{
+
+struct SchedulingGroup;
+
+// tasks run together by Executor::run_all() or Executor::post()
+
+struct SB_DECL_HIDDEN TaskGroup
+{
+
+    std::vector<std::function<void()>>
+    tasks;
+
+    // index of the next task to start
+
+    std::atomic<Size>
+    next_task;
+
+    // number of finished tasks, guarded by mutex
+
+    Size
+    done_count;
+
+    std::exception_ptr
+    error;
+
+    std::mutex
+    mutex;
+
+    std::condition_variable
+    done_condition;
+
+    // group charged for the tasks, owned by the executor
+
+    SchedulingGroup*
+    scheduling_group;
+
+};
+
+using TaskQueue = std::multimap<
+    std::pair<int, Size>,
+    std::shared_ptr<TaskGroup>
+>;
+
+// the fields below are guarded by the executor mutex
+
+struct SB_DECL_HIDDEN SchedulingGroup
+{
+
+    Size
+    weight;
+
+    Size
+    quota;
+
+    // busy time of the group in nanoseconds divided by its weight: workers
+    // serve the group with the smallest one
+
+    Size
+    virtual_time;
+
+    // time the group may still spend before being throttled, refilled at
+    // the rate of its quota
+
+    std::chrono::nanoseconds
+    balance;
+
+    std::chrono::steady_clock::time_point
+    refill_time;
+
+    // one entry per task submitted to the workers, keyed by (-priority,
+    // deadline)
+
+    TaskQueue
+    queue;
+
+    SchedulingStatistics
+    statistics;
+
+};
+
+// A pool of worker threads shared by the whole library. The thread waiting
+// for a group runs the tasks no worker started yet, so that nested groups
+// can't starve the pool: it never runs the tasks of another group, which
+// may need a blok it is executing.
+//
+// Tasks are queued per scheduling group; workers serve the groups by weighted
+// fair queuing, skipping the ones which exhausted their quota.
+
+class SB_DECL_HIDDEN Executor
+{
+
+public:
+
+    // runs tasks_ concurrently and waits for all of them; the first
+    // exception raised by a task is raised again once they all finished.
+    // Within a scheduling group, workers serve the tasks by decreasing
+    // priority_, then by increasing deadline_
+
+    static
+    void
+    run_all
+    (
+        std::vector<std::function<void()>> tasks_,
+        int priority_,
+        Size deadline_,
+        const std::string& scheduling_group_
+    );
+
+    // submits task_ to the workers without waiting for it; help() runs it
+    // in the calling thread if no worker started it yet
+
+    static
+    std::shared_ptr<TaskGroup>
+    post
+    (
+        std::function<void()> task_,
+        int priority_,
+        Size deadline_,
+        const std::string& scheduling_group_
+    );
+
+    // runs the tasks of group_ no worker started yet
+
+    static
+    void
+    help
+    (
+        TaskGroup& group_
+    );
+
+    static
+    void
+    set_weight
+    (
+        const std::string& scheduling_group_,
+        Size value_
+    );
+
+    static
+    Size
+    get_weight
+    (
+        const std::string& scheduling_group_
+    );
+
+    static
+    void
+    set_quota
+    (
+        const std::string& scheduling_group_,
+        Size value_
+    );
+
+    static
+    Size
+    get_quota
+    (
+        const std::string& scheduling_group_
+    );
+
+    static
+    SchedulingStatistics
+    get_statistics
+    (
+        const std::string& scheduling_group_
+    );
+
+    // returns the number of worker threads
+
+    static
+    Size
+    get_thread_count
+    (
+    );
+
+private:
+
+    Executor
+    (
+    );
+
+    ~Executor
+    (
+    );
+
+    static
+    Executor&
+    get_instance
+    (
+    );
+
+    // starts the next task of group_; returns false if all were started
+
+    static
+    bool
+    run_next
+    (
+        TaskGroup& group_
+    );
+
+    // returns true if all the tasks of group_ were started
+
+    static
+    bool
+    is_started
+    (
+        const TaskGroup& group_
+    );
+
+    // the following functions expect the mutex to be locked
+
+    SchedulingGroup&
+    get_group
+    (
+        const std::string& name_
+    );
+
+    // submits entry_count_ entries of group_ to the workers
+
+    void
+    enqueue
+    (
+        const std::shared_ptr<TaskGroup>& group_,
+        Size entry_count_,
+        int priority_,
+        Size deadline_
+    );
+
+    void
+    refill
+    (
+        SchedulingGroup& group_,
+        std::chrono::steady_clock::time_point now_
+    );
+
+    void
+    charge
+    (
+        SchedulingGroup& group_,
+        std::chrono::nanoseconds elapsed_time_
+    );
+
+    // returns the group to serve, or nullptr; wake_time_ is set to the end
+    // of the shortest throttling if a group was skipped
+
+    SchedulingGroup*
+    select
+    (
+        std::chrono::steady_clock::time_point now_,
+        std::chrono::steady_clock::time_point& wake_time_
+    );
+
+    void
+    run_worker
+    (
+    );
+
+private:
+
+    std::vector<std::thread>
+    workers;
+
+    std::map<std::string, SchedulingGroup>
+    groups;
+
+    // virtual time of the last served group: a group with no queued task
+    // restarts from it, so that idle groups can't save up time
+
+    Size
+    virtual_time;
+
+    // number of entries in the queues of all the groups
+
+    Size
+    queued_count;
+
+    bool
+    is_stopping;
+
+    std::mutex
+    mutex;
+
+    std::condition_variable
+    work_condition;
+
+};
+
+}
+
+#endif // SB_EXECUTOR_PRIVATE_H
@@ -0,0 +1,643 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-executor-private.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace sb;
+
+void
+sb::set_scheduling_weight
+(
+    const std::string& group_,
+    Size value_
+)
+{
+    Executor::set_weight(group_, value_);
+}
+
+Size
+sb::get_scheduling_weight
+(
+    const std::string& group_
+)
+{
+    return Executor::get_weight(group_);
+}
+
+void
+sb::set_scheduling_quota
+(
+    const std::string& group_,
+    Size value_
+)
+{
+    Executor::set_quota(group_, value_);
+}
+
+Size
+sb::get_scheduling_quota
+(
+    const std::string& group_
+)
+{
+    return Executor::get_quota(group_);
+}
+
+SchedulingStatistics
+sb::get_scheduling_statistics
+(
+    const std::string& group_
+)
+{
+    return Executor::get_statistics(group_);
+}
+
+Size
+sb::get_scheduling_thread_count
+(
+)
+{
+    return Executor::get_thread_count();
+}
+
+void
+Executor::run_all
+(
+    std::vector<std::function<void()>> tasks_,
+    int priority_,
+    Size deadline_,
+    const std::string& scheduling_group_
+)
+{
+    auto group = std::make_shared<TaskGroup>();
+
+    group->tasks = std::move(tasks_);
+    group->next_task = 0;
+    group->done_count = 0;
+
+    Size task_count = group->tasks.size();
+
+    Executor& executor = get_instance();
+
+    {
+        std::lock_guard<std::mutex> lock(executor.mutex);
+
+        group->scheduling_group = &executor.get_group(scheduling_group_);
+
+        // the calling thread takes its share of the tasks
+
+        if(task_count > 1)
+        {
+            executor.enqueue(
+                group,
+                std::min(task_count - 1, executor.workers.size()),
+                priority_,
+                deadline_
+            );
+        }
+    }
+
+    while(run_next(*group))
+    {
+    }
+
+    std::unique_lock<std::mutex> lock(group->mutex);
+
+    group->done_condition.wait(
+        lock,
+        [&group, task_count]()
+        {
+            return group->done_count == task_count;
+        }
+    );
+
+    if(group->error)
+    {
+        std::rethrow_exception(group->error);
+    }
+}
+
+std::shared_ptr<TaskGroup>
+Executor::post
+(
+    std::function<void()> task_,
+    int priority_,
+    Size deadline_,
+    const std::string& scheduling_group_
+)
+{
+    auto group = std::make_shared<TaskGroup>();
+
+    group->tasks.push_back(std::move(task_));
+    group->next_task = 0;
+    group->done_count = 0;
+
+    Executor& executor = get_instance();
+
+    {
+        std::lock_guard<std::mutex> lock(executor.mutex);
+
+        group->scheduling_group = &executor.get_group(scheduling_group_);
+
+        executor.enqueue(group, 1, priority_, deadline_);
+    }
+
+    return group;
+}
+
+void
+Executor::help
+(
+    TaskGroup& group_
+)
+{
+    while(run_next(group_))
+    {
+    }
+}
+
+void
+Executor::set_weight
+(
+    const std::string& scheduling_group_,
+    Size value_
+)
+{
+    Executor& executor = get_instance();
+
+    std::lock_guard<std::mutex> lock(executor.mutex);
+
+    executor.get_group(scheduling_group_).weight = std::max<Size>(value_, 1);
+}
+
+Size
+Executor::get_weight
+(
+    const std::string& scheduling_group_
+)
+{
+    Executor& executor = get_instance();
+
+    std::lock_guard<std::mutex> lock(executor.mutex);
+
+    return executor.get_group(scheduling_group_).weight;
+}
+
+void
+Executor::set_quota
+(
+    const std::string& scheduling_group_,
+    Size value_
+)
+{
+    Executor& executor = get_instance();
+
+    {
+        std::lock_guard<std::mutex> lock(executor.mutex);
+
+        SchedulingGroup& group = executor.get_group(scheduling_group_);
+
+        group.quota = value_;
+        group.balance = std::chrono::milliseconds(value_);
+        group.refill_time = std::chrono::steady_clock::now();
+    }
+
+    // throttled tasks may be runnable now
+
+    executor.work_condition.notify_all();
+}
+
+Size
+Executor::get_quota
+(
+    const std::string& scheduling_group_
+)
+{
+    Executor& executor = get_instance();
+
+    std::lock_guard<std::mutex> lock(executor.mutex);
+
+    return executor.get_group(scheduling_group_).quota;
+}
+
+SchedulingStatistics
+Executor::get_statistics
+(
+    const std::string& scheduling_group_
+)
+{
+    Executor& executor = get_instance();
+
+    std::lock_guard<std::mutex> lock(executor.mutex);
+
+    SchedulingGroup& group = executor.get_group(scheduling_group_);
+
+    SchedulingStatistics statistics = group.statistics;
+
+    // entries already run by the threads waiting for them don't count
+
+    statistics.queued_count = std::count_if(
+        group.queue.begin(),
+        group.queue.end(),
+        [](const TaskQueue::value_type& entry_)
+        {
+            return !is_started(*entry_.second);
+        }
+    );
+
+    return statistics;
+}
+
+Size
+Executor::get_thread_count
+(
+)
+{
+    return get_instance().workers.size();
+}
+
+Executor::Executor
+(
+):
+    virtual_time (0),
+    queued_count (0),
+    is_stopping  (false)
+{
+    Size thread_count = std::max<Size>(
+        std::thread::hardware_concurrency(),
+        2
+    ) - 1;
+
+    for(Size i = 0; i < thread_count; ++i)
+    {
+        this->workers.emplace_back(&Executor::run_worker, this);
+    }
+}
+
+Executor::~Executor
+(
+)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        this->is_stopping = true;
+    }
+
+    this->work_condition.notify_all();
+
+    for(auto& worker : this->workers)
+    {
+        worker.join();
+    }
+}
+
+Executor&
+Executor::get_instance
+(
+)
+{
+    static Executor instance;
+
+    return instance;
+}
+
+bool
+Executor::run_next
+(
+    TaskGroup& group_
+)
+{
+    Size index = group_.next_task.fetch_add(1);
+
+    if(index >= group_.tasks.size())
+    {
+        return false;
+    }
+
+    std::exception_ptr error;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    try
+    {
+        group_.tasks[index]();
+    }
+    catch(...)
+    {
+        error = std::current_exception();
+    }
+
+    {
+        Executor& executor = get_instance();
+
+        std::lock_guard<std::mutex> lock(executor.mutex);
+
+        executor.charge(
+            *group_.scheduling_group,
+            std::chrono::steady_clock::now() - start_time
+        );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(group_.mutex);
+
+        if(error && !group_.error)
+        {
+            group_.error = error;
+        }
+
+        ++group_.done_count;
+    }
+
+    group_.done_condition.notify_all();
+
+    return true;
+}
+
+bool
+Executor::is_started
+(
+    const TaskGroup& group_
+)
+{
+    return group_.next_task >= group_.tasks.size();
+}
+
+SchedulingGroup&
+Executor::get_group
+(
+    const std::string& name_
+)
+{
+    auto found_group = this->groups.find(name_);
+
+    if(found_group == this->groups.end())
+    {
+        SchedulingGroup group;
+
+        group.weight = DEFAULT_SCHEDULING_WEIGHT;
+        group.quota = NO_SCHEDULING_QUOTA;
+        group.virtual_time = this->virtual_time;
+        group.balance = std::chrono::nanoseconds::zero();
+        group.refill_time = std::chrono::steady_clock::now();
+        group.statistics = {0, 0, 0, 0};
+
+        found_group = this->groups.emplace(name_, std::move(group)).first;
+    }
+
+    return found_group->second;
+}
+
+void
+Executor::enqueue
+(
+    const std::shared_ptr<TaskGroup>& group_,
+    Size entry_count_,
+    int priority_,
+    Size deadline_
+)
+{
+    SchedulingGroup& scheduling_group = *group_->scheduling_group;
+
+    if(scheduling_group.queue.empty())
+    {
+        scheduling_group.virtual_time = std::max(
+            scheduling_group.virtual_time,
+            this->virtual_time
+        );
+    }
+
+    for(Size i = 0; i < entry_count_; ++i)
+    {
+        scheduling_group.queue.emplace(
+            std::make_pair(-priority_, deadline_),
+            group_
+        );
+    }
+
+    this->queued_count += entry_count_;
+
+    this->work_condition.notify_all();
+}
+
+void
+Executor::refill
+(
+    SchedulingGroup& group_,
+    std::chrono::steady_clock::time_point now_
+)
+{
+    std::chrono::nanoseconds quota_time = std::chrono::milliseconds(
+        group_.quota
+    );
+
+    auto quota = static_cast<std::chrono::nanoseconds::rep>(group_.quota);
+    auto period = static_cast<std::chrono::nanoseconds::rep>(
+        SCHEDULING_PERIOD
+    );
+
+    std::chrono::nanoseconds elapsed_time = now_ - group_.refill_time;
+
+    if(elapsed_time >= std::chrono::milliseconds(SCHEDULING_PERIOD))
+    {
+        group_.balance = quota_time;
+    }
+    else
+    {
+        group_.balance = std::min(
+            quota_time,
+            group_.balance + elapsed_time * quota / period
+        );
+    }
+
+    group_.refill_time = now_;
+}
+
+void
+Executor::charge
+(
+    SchedulingGroup& group_,
+    std::chrono::nanoseconds elapsed_time_
+)
+{
+    ++group_.statistics.task_count;
+
+    group_.statistics.busy_time += std::chrono::duration_cast<
+        std::chrono::microseconds
+    >(elapsed_time_).count();
+
+    group_.virtual_time += static_cast<Size>(
+        elapsed_time_.count()
+    ) / group_.weight;
+
+    if(group_.quota != NO_SCHEDULING_QUOTA)
+    {
+        this->refill(group_, std::chrono::steady_clock::now());
+
+        bool was_throttled = (
+            group_.balance <= std::chrono::nanoseconds::zero()
+        );
+
+        group_.balance -= elapsed_time_;
+
+        if(
+            !was_throttled &&
+            group_.balance <= std::chrono::nanoseconds::zero()
+        )
+        {
+            ++group_.statistics.throttled_count;
+        }
+    }
+}
+
+SchedulingGroup*
+Executor::select
+(
+    std::chrono::steady_clock::time_point now_,
+    std::chrono::steady_clock::time_point& wake_time_
+)
+{
+    SchedulingGroup* selected_group = SB_NULLPTR;
+
+    wake_time_ = std::chrono::steady_clock::time_point::max();
+
+    for(auto& name_group : this->groups)
+    {
+        SchedulingGroup& group = name_group.second;
+
+        // drop the entries already run by the threads waiting for them, so
+        // that a throttled group doesn't keep the workers waking up
+
+        while(
+            !group.queue.empty() &&
+            is_started(*group.queue.begin()->second)
+        )
+        {
+            group.queue.erase(group.queue.begin());
+
+            --this->queued_count;
+        }
+
+        if(group.queue.empty())
+        {
+            continue;
+        }
+
+        if(group.quota != NO_SCHEDULING_QUOTA)
+        {
+            this->refill(group, now_);
+
+            if(group.balance <= std::chrono::nanoseconds::zero())
+            {
+                // time to pay back the overspent time, rounded up
+
+                auto quota = static_cast<std::chrono::nanoseconds::rep>(
+                    group.quota
+                );
+                auto period = static_cast<std::chrono::nanoseconds::rep>(
+                    SCHEDULING_PERIOD
+                );
+
+                auto refill_time = std::chrono::duration_cast<
+                    std::chrono::steady_clock::duration
+                >(
+                    (std::chrono::milliseconds(1) - group.balance) *
+                    period / quota
+                );
+
+                wake_time_ = std::min(wake_time_, now_ + refill_time);
+
+                continue;
+            }
+        }
+
+        if(
+            !selected_group ||
+            group.virtual_time < selected_group->virtual_time
+        )
+        {
+            selected_group = &group;
+        }
+    }
+
+    if(selected_group)
+    {
+        this->virtual_time = selected_group->virtual_time;
+    }
+
+    return selected_group;
+}
+
+void
+Executor::run_worker
+(
+)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while(!this->is_stopping)
+    {
+        if(this->queued_count == 0)
+        {
+            this->work_condition.wait(lock);
+
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point wake_time;
+
+        SchedulingGroup* group = this->select(
+            std::chrono::steady_clock::now(),
+            wake_time
+        );
+
+        if(!group)
+        {
+            // all the groups with queued tasks are throttled, unless the
+            // remaining entries were already run
+
+            if(this->queued_count != 0)
+            {
+                this->work_condition.wait_until(lock, wake_time);
+            }
+
+            continue;
+        }
+
+        // equal keys are served in submission order
+
+        std::shared_ptr<TaskGroup> task_group = group->queue.begin()->second;
+
+        group->queue.erase(group->queue.begin());
+
+        --this->queued_count;
+
+        lock.unlock();
+
+        // the task may already be run by the thread waiting for the group
+
+        run_next(*task_group);
+
+        task_group.reset();
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,134 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EXECUTOR_H
+#define SB_EXECUTOR_H
+
+#include <sb-core/sb-coredefine.h>
+
+#include <string>
+
+namespace sb
+{
+
+/// \brief The SchedulingStatistics structure holds the counters of a
+/// scheduling group.
+///
+/// \sa get_scheduling_statistics() and AbstractBlok::set_scheduling_group().
+struct SchedulingStatistics
+{
+
+    /// Number of tasks run for the group.
+    Size
+    task_count;
+
+    /// Time spent running the tasks of the group, in microseconds.
+    Size
+    busy_time;
+
+    /// Number of times the group exhausted its quota.
+    Size
+    throttled_count;
+
+    /// Number of tasks of the group currently waiting for a thread.
+    Size
+    queued_count;
+
+};
+
+/// Default weight of a scheduling group.
+const Size DEFAULT_SCHEDULING_WEIGHT = 1;
+
+/// Constant value representing the quota of a scheduling group without
+/// quota.
+const Size NO_SCHEDULING_QUOTA = 0;
+
+/// Period over which the quota of a scheduling group is given, in
+/// milliseconds.
+const Size SCHEDULING_PERIOD = 100;
+
+/// Sets the weight of the scheduling group \a group_ to \a value_.
+///
+/// The threads of the library serve the groups with ready tasks in
+/// proportion to their weights: a group of weight 2 gets twice the time of
+/// a group of weight 1, whatever the number of tasks each one submits.
+/// A weight of 0 is replaced by 1.
+SB_CORE_API
+void
+set_scheduling_weight
+(
+    const std::string& group_,
+    Size value_
+);
+
+/// Returns the weight of the scheduling group \a group_,
+/// DEFAULT_SCHEDULING_WEIGHT if it was not set.
+SB_CORE_API
+Size
+get_scheduling_weight
+(
+    const std::string& group_
+);
+
+/// Sets the quota of the scheduling group \a group_ to \a value_
+/// milliseconds of execution per SCHEDULING_PERIOD.
+///
+/// A group exceeding its quota is throttled: the threads of the library
+/// leave its tasks waiting until the time it overspent is paid back. Tasks
+/// still run on a thread waiting for them, so that throttling never blocks
+/// a caller forever. NO_SCHEDULING_QUOTA, the default, disables the quota.
+SB_CORE_API
+void
+set_scheduling_quota
+(
+    const std::string& group_,
+    Size value_
+);
+
+/// Returns the quota of the scheduling group \a group_, in milliseconds per
+/// SCHEDULING_PERIOD.
+SB_CORE_API
+Size
+get_scheduling_quota
+(
+    const std::string& group_
+);
+
+/// Returns the counters of the scheduling group \a group_.
+///
+/// Dividing the busy time by the elapsed time gives the share of a thread
+/// the group used.
+SB_CORE_API
+SchedulingStatistics
+get_scheduling_statistics
+(
+    const std::string& group_
+);
+
+/// Returns the number of threads shared by all the scheduling groups.
+///
+/// This number depends on the hardware only: it doesn't grow with the
+/// number of bloks or executives.
+SB_CORE_API
+Size
+get_scheduling_thread_count
+(
+);
+
+}
+
+#endif // SB_EXECUTOR_H
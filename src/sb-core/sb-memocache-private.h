@@ -0,0 +1,191 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_MEMOCACHE_PRIVATE_H
+#define SB_MEMOCACHE_PRIVATE_H
+
+#include <sb-core/sb-memocache.h>
+
+#include <sb-core/sb-abstractdata.h>
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace sb
+{
+
+// identifies an execution of a memoized blok
+
+struct SB_DECL_HIDDEN MemoKey
+{
+
+    // indexes the cache
+
+    Size
+    hash;
+
+    // the type name, the properties, the inputs and the piece the hash is
+    // computed from: compared on lookup, so that colliding hashes never
+    // restore the outputs of another execution
+
+    std::shared_ptr<const std::vector<char>>
+    material;
+
+};
+
+struct SB_DECL_HIDDEN MemoEntry
+{
+
+    MemoKey
+    key;
+
+    // only persistent entries are written in the cache directory
+
+    bool
+    is_persistent;
+
+    SharedDataSequence
+    outputs;
+
+    Size
+    byte_size;
+
+};
+
+using MemoEntryList = std::list<MemoEntry>;
+
+using KeyToMemoEntryMap = std::unordered_map<
+    Size,
+    MemoEntryList::iterator
+>;
+
+class SB_DECL_HIDDEN MemoCache
+{
+
+public:
+
+    // returns the key made of material_
+
+    static
+    MemoKey
+    make_key
+    (
+        std::vector<char> material_
+    );
+
+    // looks for the outputs stored for key_, in memory then on disk if
+    // is_persistent_ is true
+
+    static
+    bool
+    find
+    (
+        const MemoKey& key_,
+        bool is_persistent_,
+        SharedDataSequence& outputs_
+    );
+
+    // stores copies of outputs_ for key_
+
+    static
+    void
+    insert
+    (
+        const MemoKey& key_,
+        bool is_persistent_,
+        const SharedDataSequence& outputs_
+    );
+
+    // writes the evicted_ entries, then trims the directory; expects the
+    // cache mutex to be unlocked
+
+    static
+    void
+    store
+    (
+        const MemoEntryList& evicted_,
+        const std::string& directory_,
+        Size disk_budget_
+    );
+
+    // the following functions expect the cache mutex to be locked
+
+    static
+    void
+    push_front
+    (
+        const MemoKey& key_,
+        bool is_persistent_,
+        const SharedDataSequence& outputs_
+    );
+
+    // moves the entries exceeding the byte budget to evicted_
+
+    static
+    void
+    evict
+    (
+        MemoEntryList& evicted_
+    );
+
+    // the following functions don't access the cache
+
+    static
+    std::string
+    get_path
+    (
+        const std::string& directory_,
+        Size hash_
+    );
+
+    static
+    bool
+    write
+    (
+        const std::string& directory_,
+        const MemoEntry& entry_
+    );
+
+    // reads the entry of path_ if it was written for key_
+
+    static
+    bool
+    read
+    (
+        const std::string& path_,
+        const MemoKey& key_,
+        SharedDataSequence& outputs_
+    );
+
+    // removes the oldest entries of directory_ until their total size is
+    // under disk_budget_
+
+    static
+    void
+    trim
+    (
+        const std::string& directory_,
+        Size disk_budget_
+    );
+
+};
+
+}
+
+#endif // SB_MEMOCACHE_PRIVATE_H
@@ -0,0 +1,684 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-memocache.h>
+
+#include <sb-core/sb-memocache-private.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if !SB_OS_IS_WIN
+#   include <dirent.h>
+#   include <sys/stat.h>
+#   include <sys/types.h>
+#endif
+
+#include <sb-core/sb-serialization.h>
+
+namespace sb
+{
+
+namespace Global
+{
+
+std::mutex
+memo_cache_mutex;
+
+Size
+memo_cache_byte_budget = DEFAULT_MEMO_CACHE_BYTE_BUDGET;
+
+std::string
+memo_cache_directory;
+
+Size
+memo_cache_disk_budget = DEFAULT_MEMO_CACHE_DISK_BUDGET;
+
+// makes the names of the files being written unique
+
+std::atomic<Size>
+memo_cache_write_count(0);
+
+MemoCacheStatistics
+memo_cache_statistics = {0, 0, 0, 0, 0, 0};
+
+MemoEntryList
+memo_entries;
+
+KeyToMemoEntryMap
+memo_index;
+
+}
+
+}
+
+using namespace sb;
+
+void
+sb::set_memo_cache_byte_budget
+(
+    Size value_
+)
+{
+    MemoEntryList evicted;
+
+    std::string directory;
+    Size disk_budget = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+        Global::memo_cache_byte_budget = value_;
+
+        MemoCache::evict(evicted);
+
+        directory = Global::memo_cache_directory;
+        disk_budget = Global::memo_cache_disk_budget;
+    }
+
+    MemoCache::store(evicted, directory, disk_budget);
+}
+
+Size
+sb::get_memo_cache_byte_budget
+(
+)
+{
+    std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+    return Global::memo_cache_byte_budget;
+}
+
+void
+sb::set_memo_cache_directory
+(
+    const std::string& path_
+)
+{
+    std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+    Global::memo_cache_directory = path_;
+}
+
+std::string
+sb::get_memo_cache_directory
+(
+)
+{
+    std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+    return Global::memo_cache_directory;
+}
+
+void
+sb::set_memo_cache_disk_budget
+(
+    Size value_
+)
+{
+    std::string directory;
+
+    {
+        std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+        Global::memo_cache_disk_budget = value_;
+
+        directory = Global::memo_cache_directory;
+    }
+
+    if(!directory.empty())
+    {
+        MemoCache::trim(directory, value_);
+    }
+}
+
+Size
+sb::get_memo_cache_disk_budget
+(
+)
+{
+    std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+    return Global::memo_cache_disk_budget;
+}
+
+MemoCacheStatistics
+sb::get_memo_cache_statistics
+(
+)
+{
+    std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+    return Global::memo_cache_statistics;
+}
+
+void
+sb::clear_memo_cache
+(
+)
+{
+    MemoEntryList entries;
+
+    {
+        std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+        entries.swap(Global::memo_entries);
+
+        Global::memo_index.clear();
+
+        Global::memo_cache_statistics = {0, 0, 0, 0, 0, 0};
+    }
+
+    // cached data may return to their pool:
+    // release them out of the lock
+}
+
+MemoKey
+MemoCache::make_key
+(
+    std::vector<char> material_
+)
+{
+    // hash the material in place with 64-bit FNV-1a
+
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for(char byte : material_)
+    {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 1099511628211ULL;
+    }
+
+    return MemoKey{
+        static_cast<Size>(hash),
+        std::make_shared<const std::vector<char>>(std::move(material_))
+    };
+}
+
+bool
+MemoCache::find
+(
+    const MemoKey& key_,
+    bool is_persistent_,
+    SharedDataSequence& outputs_
+)
+{
+    bool found = false;
+
+    std::string directory;
+
+    {
+        std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+        auto found_entry = Global::memo_index.find(key_.hash);
+
+        // an entry whose hash collides with key_ is not a match
+
+        if(
+            found_entry != Global::memo_index.end() &&
+            *found_entry->second->key.material == *key_.material
+        )
+        {
+            // move the entry to the front of the list
+
+            Global::memo_entries.splice(
+                Global::memo_entries.begin(),
+                Global::memo_entries,
+                found_entry->second
+            );
+
+            outputs_ = found_entry->second->outputs;
+
+            ++Global::memo_cache_statistics.hits;
+
+            found = true;
+        }
+        else if(is_persistent_)
+        {
+            directory = Global::memo_cache_directory;
+        }
+
+        if(!found && directory.empty())
+        {
+            ++Global::memo_cache_statistics.misses;
+        }
+    }
+
+    if(!found && !directory.empty())
+    {
+        // the file is read out of the lock
+
+        SharedDataSequence outputs;
+
+        found = MemoCache::read(
+            MemoCache::get_path(directory, key_.hash),
+            key_,
+            outputs
+        );
+
+        MemoEntryList evicted;
+
+        Size disk_budget = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+            if(found)
+            {
+                // another thread may have read the same entry meanwhile
+
+                if(Global::memo_index.count(key_.hash) == 0)
+                {
+                    MemoCache::push_front(key_, true, outputs);
+                }
+
+                ++Global::memo_cache_statistics.disk_hits;
+
+                MemoCache::evict(evicted);
+            }
+            else
+            {
+                ++Global::memo_cache_statistics.misses;
+            }
+
+            disk_budget = Global::memo_cache_disk_budget;
+        }
+
+        MemoCache::store(evicted, directory, disk_budget);
+
+        if(found)
+        {
+            outputs_ = outputs;
+        }
+    }
+
+    return found;
+}
+
+void
+MemoCache::insert
+(
+    const MemoKey& key_,
+    bool is_persistent_,
+    const SharedDataSequence& outputs_
+)
+{
+    SharedDataSequence clones;
+
+    for(auto output : outputs_)
+    {
+        SharedData clone = clone_data(output);
+
+        if(!clone)
+        {
+            // the entry can't be restored: don't store it
+
+            return;
+        }
+
+        clones.push_back(clone);
+    }
+
+    MemoEntryList evicted;
+
+    std::string directory;
+    Size disk_budget = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(Global::memo_cache_mutex);
+
+        // an entry whose hash collides with key_ stays in the cache
+
+        if(Global::memo_index.count(key_.hash) == 0)
+        {
+            MemoCache::push_front(key_, is_persistent_, clones);
+
+            MemoCache::evict(evicted);
+        }
+
+        directory = Global::memo_cache_directory;
+        disk_budget = Global::memo_cache_disk_budget;
+    }
+
+    MemoCache::store(evicted, directory, disk_budget);
+}
+
+void
+MemoCache::store
+(
+    const MemoEntryList& evicted_,
+    const std::string& directory_,
+    Size disk_budget_
+)
+{
+    if(!directory_.empty())
+    {
+        bool written = false;
+
+        for(const MemoEntry& entry : evicted_)
+        {
+            if(entry.is_persistent && MemoCache::write(directory_, entry))
+            {
+                written = true;
+            }
+        }
+
+        if(written)
+        {
+            MemoCache::trim(directory_, disk_budget_);
+        }
+    }
+
+    // evicted data may return to their pool when evicted_ is destroyed,
+    // out of the lock
+}
+
+void
+MemoCache::push_front
+(
+    const MemoKey& key_,
+    bool is_persistent_,
+    const SharedDataSequence& outputs_
+)
+{
+    Size byte_size = key_.material->size();
+
+    for(auto output : outputs_)
+    {
+        byte_size += output->get_byte_size();
+    }
+
+    Global::memo_entries.push_front(
+        MemoEntry{key_, is_persistent_, outputs_, byte_size}
+    );
+
+    Global::memo_index[key_.hash] = Global::memo_entries.begin();
+
+    ++Global::memo_cache_statistics.entries;
+    Global::memo_cache_statistics.bytes += byte_size;
+}
+
+void
+MemoCache::evict
+(
+    MemoEntryList& evicted_
+)
+{
+    while(
+        Global::memo_cache_statistics.bytes > Global::memo_cache_byte_budget
+    )
+    {
+        const MemoEntry& entry = Global::memo_entries.back();
+
+        --Global::memo_cache_statistics.entries;
+        Global::memo_cache_statistics.bytes -= entry.byte_size;
+
+        ++Global::memo_cache_statistics.evictions;
+
+        Global::memo_index.erase(entry.key.hash);
+
+        evicted_.splice(
+            evicted_.end(),
+            Global::memo_entries,
+            std::prev(Global::memo_entries.end())
+        );
+    }
+}
+
+std::string
+MemoCache::get_path
+(
+    const std::string& directory_,
+    Size hash_
+)
+{
+    std::ostringstream path;
+
+    path <<
+        directory_ <<
+        "/" <<
+        std::hex <<
+        hash_ <<
+        ".sbm";
+
+    return path.str();
+}
+
+bool
+MemoCache::write
+(
+    const std::string& directory_,
+    const MemoEntry& entry_
+)
+{
+    Writer writer;
+
+    bool written = true;
+
+    // the key material is written first, so that a reader can tell entries
+    // whose hashes collide apart
+
+    const std::vector<char>& material = *entry_.key.material;
+
+    writer.write_value(
+        static_cast<std::uint64_t>(material.size())
+    );
+    writer.write(material.data(), material.size());
+
+    writer.write_value(
+        static_cast<std::uint64_t>(entry_.outputs.size())
+    );
+
+    for(auto output : entry_.outputs)
+    {
+        // each data is preceded by its type name
+
+        writer.write_string(output->get_format().type_names[0]);
+
+        written = written && serialize(*output, writer);
+    }
+
+    if(written)
+    {
+        // write a temporary file, then rename it: readers never see a
+        // partial entry
+
+        std::string path = MemoCache::get_path(
+            directory_,
+            entry_.key.hash
+        );
+
+        std::ostringstream temporary_path;
+
+        temporary_path <<
+            path <<
+            "." <<
+            std::hash<std::thread::id>()(std::this_thread::get_id()) <<
+            "." <<
+            Global::memo_cache_write_count.fetch_add(1) <<
+            ".tmp";
+
+        {
+            std::ofstream stream(
+                temporary_path.str(),
+                std::ios::binary
+            );
+
+            const std::vector<char>& buffer = writer.get_buffer();
+
+            written = static_cast<bool>(
+                stream.write(buffer.data(), buffer.size())
+            );
+        }
+
+        // renaming over an existing file fails on some systems: the entry
+        // is already there
+
+        if(
+            !written ||
+            std::rename(temporary_path.str().c_str(), path.c_str()) != 0
+        )
+        {
+            std::remove(temporary_path.str().c_str());
+        }
+    }
+
+    return written;
+}
+
+bool
+MemoCache::read
+(
+    const std::string& path_,
+    const MemoKey& key_,
+    SharedDataSequence& outputs_
+)
+{
+    std::ifstream stream(path_, std::ios::binary);
+
+    std::vector<char> buffer(
+        (std::istreambuf_iterator<char>(stream)),
+        std::istreambuf_iterator<char>()
+    );
+
+    Reader reader(buffer);
+
+    const std::vector<char>& material = *key_.material;
+
+    std::uint64_t material_size = 0;
+
+    bool read =
+        stream.is_open() &&
+        reader.read_value(material_size) &&
+        material_size == material.size();
+
+    if(read)
+    {
+        const char* file_material = reader.view(material.size());
+
+        read =
+            file_material != SB_NULLPTR &&
+            std::equal(material.begin(), material.end(), file_material);
+    }
+
+    std::uint64_t count = 0;
+
+    read = read && reader.read_value(count);
+
+    SharedDataSequence outputs;
+
+    for(std::uint64_t i = 0; read && i < count; ++i)
+    {
+        std::string name;
+
+        SharedData output;
+
+        if(reader.read_string(name))
+        {
+            output = create_shared_data(name);
+        }
+
+        read = output && deserialize(*output, reader);
+
+        outputs.push_back(output);
+    }
+
+    if(read)
+    {
+        outputs_ = outputs;
+    }
+
+    return read;
+}
+
+void
+MemoCache::trim
+(
+    const std::string& directory_,
+    Size disk_budget_
+)
+{
+#if !SB_OS_IS_WIN
+    DIR* dir = opendir(directory_.c_str());
+
+    if(dir != SB_NULLPTR)
+    {
+        // the files of the entries, from the oldest
+
+        std::multimap<std::time_t, std::pair<std::string, Size>> files;
+
+        Size total_size = 0;
+
+        const std::string extension = ".sbm";
+
+        for(dirent* entry = readdir(dir); entry; entry = readdir(dir))
+        {
+            std::string name = entry->d_name;
+            std::string path = directory_ + "/" + name;
+
+            struct stat status;
+
+            if(
+                name.size() > extension.size() &&
+                name.compare(
+                    name.size() - extension.size(),
+                    extension.size(),
+                    extension
+                ) == 0 &&
+                stat(path.c_str(), &status) == 0
+            )
+            {
+                Size size = static_cast<Size>(status.st_size);
+
+                files.emplace(
+                    status.st_mtime,
+                    std::make_pair(path, size)
+                );
+
+                total_size += size;
+            }
+        }
+
+        closedir(dir);
+
+        for(
+            auto file = files.begin();
+            file != files.end() && total_size > disk_budget_;
+            ++file
+        )
+        {
+            if(std::remove(file->second.first.c_str()) == 0)
+            {
+                total_size -= file->second.second;
+            }
+        }
+    }
+#else
+    (void)directory_;
+    (void)disk_budget_;
+#endif
+}
@@ -0,0 +1,147 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_MEMOCACHE_H
+#define SB_MEMOCACHE_H
+
+#include <sb-core/sb-coredefine.h>
+
+#include <string>
+
+namespace sb
+{
+
+/// \brief The MemoCacheStatistics structure holds the counters of the
+/// memoization cache.
+///
+/// \sa get_memo_cache_statistics() and AbstractBlok::set_memoized().
+struct MemoCacheStatistics
+{
+
+    /// Number of executions served from memory.
+    Size
+    hits;
+
+    /// Number of executions not found in the cache.
+    Size
+    misses;
+
+    /// Number of entries removed from memory to respect the byte budget.
+    Size
+    evictions;
+
+    /// Number of executions served from the cache directory.
+    Size
+    disk_hits;
+
+    /// Number of entries currently held in memory.
+    Size
+    entries;
+
+    /// Estimation of the memory currently used by the entries, in bytes.
+    Size
+    bytes;
+
+};
+
+/// Default memory budget of the memoization cache, in bytes.
+const Size DEFAULT_MEMO_CACHE_BYTE_BUDGET = 64 * 1024 * 1024;
+
+/// Sets the memory budget of the memoization cache to \a value_ bytes.
+///
+/// Least recently used entries are evicted as soon as the budget is exceeded.
+SB_CORE_API
+void
+set_memo_cache_byte_budget
+(
+    Size value_
+);
+
+/// Returns the memory budget of the memoization cache, in bytes.
+SB_CORE_API
+Size
+get_memo_cache_byte_budget
+(
+);
+
+/// Sets the directory where evicted entries are written to \a path_.
+///
+/// Entries are written only if all their data can be serialized, and are
+/// read back when missing from memory. Entries are named after the content
+/// of the executions, so that other processes can read them; executions
+/// with inputs that can't be serialized are kept in memory only. An empty
+/// \a path_ disables the directory, which is the default.
+///
+/// \sa set_memo_cache_disk_budget().
+SB_CORE_API
+void
+set_memo_cache_directory
+(
+    const std::string& path_
+);
+
+/// Returns the directory where evicted entries are written, or an empty
+/// string if it is disabled.
+SB_CORE_API
+std::string
+get_memo_cache_directory
+(
+);
+
+/// Default disk budget of the memoization cache, in bytes.
+const Size DEFAULT_MEMO_CACHE_DISK_BUDGET = 256 * 1024 * 1024;
+
+/// Sets the disk budget of the memoization cache to \a value_ bytes.
+///
+/// Each time entries are written, the oldest files of the cache directory
+/// are removed until their total size is under the budget. The budget is
+/// not enforced on Windows.
+///
+/// \sa set_memo_cache_directory().
+SB_CORE_API
+void
+set_memo_cache_disk_budget
+(
+    Size value_
+);
+
+/// Returns the disk budget of the memoization cache, in bytes.
+SB_CORE_API
+Size
+get_memo_cache_disk_budget
+(
+);
+
+/// Returns the counters of the memoization cache.
+SB_CORE_API
+MemoCacheStatistics
+get_memo_cache_statistics
+(
+);
+
+/// Removes all the entries held in memory and resets the counters.
+///
+/// Files written in the cache directory are left untouched.
+SB_CORE_API
+void
+clear_memo_cache
+(
+);
+
+}
+
+#endif // SB_MEMOCACHE_H
@@ -0,0 +1,130 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_PIECE_H
+#define SB_PIECE_H
+
+#include <sb-core/sb-coredefine.h>
+
+#include <algorithm>
+
+namespace sb
+{
+
+/// \brief The Piece structure describes a contiguous range of elements in a
+/// data.
+///
+/// Pieces allow a pipeline to stream a dataset larger than the memory: a
+/// source announces the extent of its outputs, i.e. the number of elements
+/// in the whole dataset, and each data only holds the piece currently
+/// requested.
+///
+/// \sa AbstractBlok::pull_input() and AbstractBlok::push_output().
+struct Piece
+{
+
+    /// This attribute holds the position of the first element of the piece.
+    Index
+    offset;
+
+    /// This attribute holds the number of elements in the piece.
+    Size
+    size;
+
+};
+
+/// Constant value representing the piece covering a whole data.
+const Piece
+WHOLE_PIECE = {
+    0,
+    MAX_SIZE
+};
+
+/// Constant value representing an unknown extent.
+const Size
+UNKNOWN_EXTENT = MAX_SIZE;
+
+inline
+bool
+operator==
+(
+    const Piece& left_,
+    const Piece& right_
+)
+{
+    return (
+        left_.offset == right_.offset
+    ) && (
+        left_.size == right_.size
+    );
+}
+
+inline
+bool
+operator!=
+(
+    const Piece& left_,
+    const Piece& right_
+)
+{
+    return !(left_ == right_);
+}
+
+using PieceSequence = std::vector<Piece>;
+
+/// Splits \a extent_ elements into consecutive pieces of at most
+/// \a piece_size_ elements.
+///
+/// The function returns a sequence holding WHOLE_PIECE if \a extent_ is
+/// UNKNOWN_EXTENT or if \a piece_size_ is zero.
+inline
+PieceSequence
+split_extent
+(
+    Size extent_,
+    Size piece_size_
+)
+{
+    PieceSequence pieces;
+
+    if(extent_ == UNKNOWN_EXTENT || piece_size_ == 0)
+    {
+        pieces.push_back(WHOLE_PIECE);
+    }
+    else
+    {
+        pieces.reserve(
+            (extent_ + piece_size_ - 1) / piece_size_
+        );
+
+        for(Index offset = 0; offset < extent_; offset += piece_size_)
+        {
+            pieces.push_back(
+                {
+                    offset,
+                    std::min(piece_size_, extent_ - offset)
+                }
+            );
+        }
+    }
+
+    return pieces;
+}
+
+}
+
+#endif // SB_PIECE_H
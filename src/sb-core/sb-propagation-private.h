@@ -0,0 +1,201 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_PROPAGATION_PRIVATE_H
+#define SB_PROPAGATION_PRIVATE_H
+
+#include <sb-core/sb-abstractblok.h>
+
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace sb
+{
+
+// what a blok must be told when it is visited
+
+struct SB_DECL_HIDDEN PendingVisit
+{
+
+    bool
+    is_modified;
+
+    std::set<Index>
+    pushed_inputs;
+
+};
+
+using ScheduledBlok = std::tuple<int, Size, Size, AbstractBlok*>;
+
+// state of the propagation of a thread
+
+struct SB_DECL_HIDDEN PropagationState
+{
+
+    bool
+    is_running;
+
+    // (-priority, deadline, rank, blok) tuples, ordered as a min-heap: the
+    // most urgent bloks are visited first, each after its upstream bloks
+
+    std::vector<ScheduledBlok>
+    heap;
+
+    // (blok, input index) pairs of the bloks fed by a single pusher, visited
+    // next, before the heap
+
+    std::vector<std::pair<AbstractBlok*, Index>>
+    chained_visits;
+
+    std::map<AbstractBlok*, PendingVisit>
+    pending_visits;
+
+    std::map<AbstractBlok*, Size>
+    ranks;
+
+    std::set<AbstractBlok*>
+    visited_bloks;
+
+    // bloks executed during the propagation, by a visit or by a pull
+
+    std::set<AbstractBlok*>
+    executed_bloks;
+
+    AbstractBlok*
+    visited_blok;
+
+    bool
+    is_visited_blok_executed;
+
+    // the filter following the visited blok in a linear chain of filters:
+    // once pushed, it is executed right after the visited blok, as part of
+    // a fused run, instead of being scheduled
+
+    AbstractBlok*
+    fused_blok;
+
+    bool
+    is_fused_blok_pushed;
+
+};
+
+// Propagates the changes of a graph: the bloks reached by a change are
+// visited in topological order, each once, after all their dirty upstream
+// bloks. Changes happening during a visit are scheduled into the running
+// propagation instead of being propagated recursively.
+
+class SB_DECL_HIDDEN Propagation
+{
+
+public:
+
+    // blok_ was modified and must be updated
+
+    static
+    void
+    schedule_modified
+    (
+        AbstractBlok* blok_
+    );
+
+    // the input index_ of blok_ was pushed; is_chained_ is true if blok_
+    // has no other input and is the only follower of the pushed output, in
+    // which case blok_ is executed in the fused run of the visited blok, or
+    // visited next
+
+    static
+    void
+    schedule_pushed
+    (
+        AbstractBlok* blok_,
+        Index index_,
+        bool is_chained_
+    );
+
+    // visits the scheduled bloks, unless a propagation is already running
+
+    static
+    void
+    run
+    (
+    );
+
+    // returns false if blok_ was already executed during its visit
+
+    static
+    bool
+    begin_execution
+    (
+        AbstractBlok* blok_
+    );
+
+    // returns true if the outputs of blok_ are up to date during the
+    // running propagation: blok_ was executed by it, or it wasn't reached by
+    // it and its inputs didn't change since its last execution
+
+    static
+    bool
+    is_up_to_date
+    (
+        AbstractBlok* blok_
+    );
+
+    static
+    void
+    on_destroyed
+    (
+        AbstractBlok* blok_
+    );
+
+    static
+    PropagationState&
+    get_state
+    (
+    );
+
+private:
+
+    static
+    PendingVisit&
+    schedule
+    (
+        AbstractBlok* blok_
+    );
+
+    static
+    void
+    reset
+    (
+    );
+
+    // checked_bloks_ holds the bloks being checked, so that a cycle ends
+
+    static
+    bool
+    is_up_to_date
+    (
+        AbstractBlok* blok_,
+        std::set<AbstractBlok*>& checked_bloks_
+    );
+
+};
+
+}
+
+#endif // SB_PROPAGATION_PRIVATE_H
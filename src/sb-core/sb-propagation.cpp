@@ -0,0 +1,585 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-propagation-private.h>
+
+#include <algorithm>
+#include <functional>
+#include <typeinfo>
+
+#include <sb-core/sb-abstractblok-private.h>
+#include <sb-core/sb-abstractdata-private.h>
+#include <sb-core/sb-abstractexecutive.h>
+#include <sb-core/sb-abstractfilter.h>
+#include <sb-core/sb-executive.h>
+
+namespace sb
+{
+
+namespace
+{
+
+// returns the length of the longest path from a source to blok_
+
+inline
+Size
+compute_rank
+(
+    AbstractBlok* blok_,
+    std::map<AbstractBlok*, Size>& ranks_
+)
+{
+    auto found_rank = ranks_.find(blok_);
+
+    if(found_rank != ranks_.end())
+    {
+        return found_rank->second;
+    }
+
+    // mark the blok before visiting its inputs, so that a cycle ends
+
+    ranks_[blok_] = 0;
+
+    Size rank = 0;
+
+    for(const auto& weak_input : AbstractBlok::Private::from(blok_)->inputs)
+    {
+        auto input = weak_input.lock();
+
+        if(input)
+        {
+            AbstractBlok* source = AbstractData::Private::from(
+                input
+            )->source_blok;
+
+            if(source)
+            {
+                rank = std::max(rank, compute_rank(source, ranks_) + 1);
+            }
+        }
+    }
+
+    ranks_[blok_] = rank;
+
+    return rank;
+}
+
+// returns true if blok_ is a filter with a single input and a single output
+
+inline
+bool
+is_linear_filter
+(
+    AbstractBlok* blok_
+)
+{
+    auto blok_d_ptr = AbstractBlok::Private::from(blok_);
+
+    return
+        blok_d_ptr->inputs.size() == 1 &&
+        blok_d_ptr->outputs.size() == 1 &&
+        dynamic_cast<AbstractFilter*>(blok_) != SB_NULLPTR;
+}
+
+// returns the only follower of the output of blok_ if both are linear
+// filters and the follower executes as soon as it is pushed; returns
+// nullptr otherwise
+
+inline
+AbstractBlok*
+find_fused_follower
+(
+    AbstractBlok* blok_
+)
+{
+    if(!is_linear_filter(blok_))
+    {
+        return SB_NULLPTR;
+    }
+
+    auto output_d_ptr = AbstractData::Private::from(
+        AbstractBlok::Private::from(blok_)->outputs[0]
+    );
+
+    if(output_d_ptr->followers.size() != 1)
+    {
+        return SB_NULLPTR;
+    }
+
+    AbstractBlok* follower = Unmapper::blok(
+        *output_d_ptr->followers.begin()
+    );
+
+    if(!is_linear_filter(follower))
+    {
+        return SB_NULLPTR;
+    }
+
+    // these executives execute their blok when an input is pushed, which
+    // the fused run does directly
+
+    const AbstractExecutive& executive =
+        *AbstractBlok::Private::from(follower)->executive;
+
+    if(
+        typeid(executive) != typeid(PushExecutive) &&
+        typeid(executive) != typeid(PushPullExecutive)
+    )
+    {
+        return SB_NULLPTR;
+    }
+
+    return follower;
+}
+
+}
+
+}
+
+using namespace sb;
+
+void
+Propagation::schedule_modified
+(
+    AbstractBlok* blok_
+)
+{
+    PropagationState& state = get_state();
+
+    // a blok modifying itself while it is visited is already up to date
+
+    if(state.visited_blok != blok_)
+    {
+        schedule(blok_).is_modified = true;
+    }
+}
+
+void
+Propagation::schedule_pushed
+(
+    AbstractBlok* blok_,
+    Index index_,
+    bool is_chained_
+)
+{
+    PropagationState& state = get_state();
+
+    // a blok is visited once: a push reaching an already visited blok comes
+    // from a cycle or from the blok itself pulling its inputs
+
+    if(state.visited_bloks.count(blok_) == 0)
+    {
+        if(
+            is_chained_ &&
+            blok_ == state.fused_blok &&
+            state.pending_visits.count(blok_) == 0
+        )
+        {
+            // the fused run of the visited blok executes blok_ next
+
+            state.visited_bloks.insert(blok_);
+
+            state.is_fused_blok_pushed = true;
+        }
+        else if(is_chained_ && state.pending_visits.count(blok_) == 0)
+        {
+            // the pusher is the only upstream blok of blok_: blok_ can be
+            // visited next, bypassing the ordering
+
+            state.visited_bloks.insert(blok_);
+
+            state.chained_visits.emplace_back(blok_, index_);
+        }
+        else
+        {
+            schedule(blok_).pushed_inputs.insert(index_);
+        }
+    }
+}
+
+void
+Propagation::run
+(
+)
+{
+    PropagationState& state = get_state();
+
+    if(state.is_running)
+    {
+        // the running propagation will visit the scheduled bloks
+
+        return;
+    }
+
+    state.is_running = true;
+
+    try
+    {
+        while(!state.chained_visits.empty() || !state.heap.empty())
+        {
+            AbstractBlok* blok = SB_NULLPTR;
+
+            PendingVisit visit = {false, {}};
+
+            bool is_chained = !state.chained_visits.empty();
+
+            if(is_chained)
+            {
+                const auto& chained_visit = state.chained_visits.back();
+
+                blok = chained_visit.first;
+
+                visit.pushed_inputs.insert(chained_visit.second);
+
+                state.chained_visits.pop_back();
+            }
+            else
+            {
+                std::pop_heap(
+                    state.heap.begin(),
+                    state.heap.end(),
+                    std::greater<ScheduledBlok>()
+                );
+
+                blok = std::get<3>(state.heap.back());
+
+                state.heap.pop_back();
+
+                // the blok may have been destroyed since it was scheduled
+
+                auto found_visit = state.pending_visits.find(blok);
+
+                if(found_visit == state.pending_visits.end())
+                {
+                    continue;
+                }
+
+                visit = found_visit->second;
+
+                state.pending_visits.erase(found_visit);
+
+                state.visited_bloks.insert(blok);
+            }
+
+            auto blok_d_ptr = AbstractBlok::Private::from(blok);
+
+            if(!blok_d_ptr->is_demanded())
+            {
+                // the blok will catch up once a sink reads it again
+
+                blok_d_ptr->stale = true;
+
+                continue;
+            }
+
+            state.visited_blok = blok;
+            state.is_visited_blok_executed = false;
+            state.fused_blok = find_fused_follower(blok);
+            state.is_fused_blok_pushed = false;
+
+            // the single input of a chained blok was just pushed: pulling it
+            // again would only execute the pusher twice
+
+            blok_d_ptr->inputs_pulled = is_chained;
+
+            AbstractExecutive* executive = blok_d_ptr->executive.get();
+
+            if(visit.is_modified)
+            {
+                executive->on_modified();
+            }
+
+            for(Index index : visit.pushed_inputs)
+            {
+                // the blok may have been destroyed by its previous call
+
+                if(state.visited_blok != blok)
+                {
+                    break;
+                }
+
+                executive->on_input_pushed(index);
+            }
+
+            if(state.visited_blok == blok)
+            {
+                blok_d_ptr->inputs_pulled = false;
+            }
+
+            // the fused run: each pushed filter of a linear chain executes
+            // right after its pusher, while its input is hot, without being
+            // scheduled
+
+            while(
+                state.fused_blok != SB_NULLPTR &&
+                state.is_fused_blok_pushed
+            )
+            {
+                blok = state.fused_blok;
+                blok_d_ptr = AbstractBlok::Private::from(blok);
+
+                state.visited_blok = blok;
+                state.is_visited_blok_executed = false;
+                state.fused_blok = find_fused_follower(blok);
+                state.is_fused_blok_pushed = false;
+
+                blok_d_ptr->inputs_pulled = true;
+
+                blok_d_ptr->executive->on_input_pushed(0);
+
+                if(state.visited_blok == blok)
+                {
+                    blok_d_ptr->inputs_pulled = false;
+                }
+            }
+
+            state.visited_blok = SB_NULLPTR;
+            state.fused_blok = SB_NULLPTR;
+        }
+    }
+    catch(...)
+    {
+        reset();
+
+        throw;
+    }
+
+    reset();
+}
+
+bool
+Propagation::begin_execution
+(
+    AbstractBlok* blok_
+)
+{
+    PropagationState& state = get_state();
+
+    bool is_first = true;
+
+    if(state.visited_blok == blok_)
+    {
+        is_first = !state.is_visited_blok_executed;
+
+        state.is_visited_blok_executed = true;
+    }
+
+    if(state.is_running && is_first)
+    {
+        state.executed_bloks.insert(blok_);
+    }
+
+    return is_first;
+}
+
+bool
+Propagation::is_up_to_date
+(
+    AbstractBlok* blok_
+)
+{
+    std::set<AbstractBlok*> checked_bloks;
+
+    return Propagation::is_up_to_date(blok_, checked_bloks);
+}
+
+void
+Propagation::on_destroyed
+(
+    AbstractBlok* blok_
+)
+{
+    PropagationState& state = get_state();
+
+    // heap entries are skipped once their pending visit is gone
+
+    state.pending_visits.erase(blok_);
+    state.ranks.erase(blok_);
+
+    state.chained_visits.erase(
+        std::remove_if(
+            state.chained_visits.begin(),
+            state.chained_visits.end(),
+            [blok_]
+            (
+                const std::pair<AbstractBlok*, Index>& visit_
+            )
+            {
+                return visit_.first == blok_;
+            }
+        ),
+        state.chained_visits.end()
+    );
+
+    state.visited_bloks.erase(blok_);
+    state.executed_bloks.erase(blok_);
+
+    if(state.visited_blok == blok_)
+    {
+        state.visited_blok = SB_NULLPTR;
+    }
+
+    if(state.fused_blok == blok_)
+    {
+        state.fused_blok = SB_NULLPTR;
+    }
+}
+
+PropagationState&
+Propagation::get_state
+(
+)
+{
+    static SB_THREAD_LOCAL PropagationState state = {
+        false, {}, {}, {}, {}, {}, {}, SB_NULLPTR, false, SB_NULLPTR, false
+    };
+
+    return state;
+}
+
+PendingVisit&
+Propagation::schedule
+(
+    AbstractBlok* blok_
+)
+{
+    PropagationState& state = get_state();
+
+    auto inserted_visit = state.pending_visits.emplace(
+        blok_,
+        PendingVisit{false, {}}
+    );
+
+    if(inserted_visit.second)
+    {
+        auto blok_d_ptr = AbstractBlok::Private::from(blok_);
+
+        blok_d_ptr->update_urgency();
+
+        state.heap.emplace_back(
+            -blok_d_ptr->effective_priority,
+            blok_d_ptr->effective_deadline,
+            compute_rank(blok_, state.ranks),
+            blok_
+        );
+
+        std::push_heap(
+            state.heap.begin(),
+            state.heap.end(),
+            std::greater<ScheduledBlok>()
+        );
+    }
+
+    return inserted_visit.first->second;
+}
+
+void
+Propagation::reset
+(
+)
+{
+    PropagationState& state = get_state();
+
+    state.is_running = false;
+    state.heap.clear();
+    state.chained_visits.clear();
+    state.pending_visits.clear();
+    state.ranks.clear();
+    state.visited_bloks.clear();
+    state.executed_bloks.clear();
+    state.visited_blok = SB_NULLPTR;
+    state.fused_blok = SB_NULLPTR;
+}
+
+bool
+Propagation::is_up_to_date
+(
+    AbstractBlok* blok_,
+    std::set<AbstractBlok*>& checked_bloks_
+)
+{
+    PropagationState& state = get_state();
+
+    if(
+        !state.is_running ||
+        state.pending_visits.count(blok_) != 0 ||
+        !checked_bloks_.insert(blok_).second
+    )
+    {
+        return false;
+    }
+
+    if(state.executed_bloks.count(blok_) != 0)
+    {
+        return true;
+    }
+
+    // a blok visited without executing may hold back its outputs, e.g. to
+    // gather a batch
+
+    if(state.visited_bloks.count(blok_) != 0)
+    {
+        return false;
+    }
+
+    auto blok_d_ptr = AbstractBlok::Private::from(blok_);
+
+    if(
+        blok_d_ptr->stale ||
+        !blok_d_ptr->is_executed ||
+        blok_d_ptr->executed_input_versions.size() !=
+            blok_d_ptr->inputs.size()
+    )
+    {
+        return false;
+    }
+
+    for(Index i = 0; i < blok_d_ptr->inputs.size(); ++i)
+    {
+        auto input = blok_d_ptr->inputs[i].lock();
+
+        if(!input)
+        {
+            return false;
+        }
+
+        auto input_d_ptr = AbstractData::Private::from(input);
+
+        // the changes of data without versions can't be detected
+
+        if(
+            !input_d_ptr->is_versioned ||
+            input_d_ptr->version != blok_d_ptr->executed_input_versions[i]
+        )
+        {
+            return false;
+        }
+
+        if(
+            input_d_ptr->source_blok &&
+            !Propagation::is_up_to_date(
+                input_d_ptr->source_blok,
+                checked_bloks_
+            )
+        )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
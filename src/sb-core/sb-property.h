@@ -20,9 +20,44 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sb-core/sb-propertyformat.h>
 
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
 namespace sb
 {
 
+/// \cond INTERNAL
+namespace PropertyTraits
+{
+
+    // an incomplete class: pointers to its members have the largest size
+
+    class UnknownClass;
+
+    using MemberFunction = void (UnknownClass::*)();
+
+    // storage for a pointer to member function
+
+    struct MemberStorage
+    {
+
+        typename std::aligned_storage<
+            sizeof(MemberFunction),
+            alignof(MemberFunction)
+        >::type
+        bytes;
+
+    };
+
+    // pointer to function erasing the type of a trampoline
+
+    using ErasedFunction = void(*)();
+
+}
+/// \endcond
+
 template<typename Base>
 struct Property : PropertyFormat
 {
@@ -30,14 +65,17 @@ struct Property : PropertyFormat
     template<typename Derived, typename Type>
     using Get = std::function<Type(const Derived&)>;
 
-    Get<Base, Any>
-    get;
-
     template<typename Derived, typename Type>
     using Set = std::function<void(Derived&, const Type&)>;
 
-    Set<Base, Any>
-    set;
+    using HashFunction = std::size_t(*)(const Any&);
+
+    /// Pointer to a function hashing the values of this property, or
+    /// \b nullptr if the type of this property can't be hashed.
+    ///
+    /// \sa Hash.
+    HashFunction
+    hash;
 
     template<typename Derived, typename Type>
     Property
@@ -46,21 +84,24 @@ struct Property : PropertyFormat
         Get<Derived, Type> get_,
         Set<Derived, Type> set_ = SB_NULLPTR
     ):
-        PropertyFormat{
-            typeid(Type),
+        Property(
             name_,
-            AccessRights::NONE
-        },
-        get(Caller<Derived, Type>(get_)),
-        set(Caller<Derived, Type>(set_))
+            TypeTag<Type>()
+        )
     {
+        using Accessors = FunctionAccessors<Derived, Type>;
+
         if(get_)
         {
-            bitmask(this->access_rights).set(AccessRights::READ);
+            this->get_function = std::make_shared<Get<Derived, Type>>(get_);
+
+            this->set_getter<Accessors>();
         }
         if(set_)
         {
-            bitmask(this->access_rights).set(AccessRights::WRITE);
+            this->set_function = std::make_shared<Set<Derived, Type>>(set_);
+
+            this->set_setter<Accessors>();
         }
     }
 
@@ -73,14 +114,23 @@ struct Property : PropertyFormat
     ):
         Property(
             name_,
-            Get<Derived, Type>(
-                get_
-            ),
-            Set<Derived, Type>(
-                set_
-            )
+            TypeTag<Type>()
         )
     {
+        using Accessors = MemberAccessors<Derived, Type>;
+
+        if(get_)
+        {
+            Accessors::store(this->get_storage, get_);
+
+            this->set_getter<Accessors>();
+        }
+        if(set_)
+        {
+            Accessors::store(this->set_storage, set_);
+
+            this->set_setter<Accessors>();
+        }
     }
 
     template<typename Derived, typename Type>
@@ -91,7 +141,9 @@ struct Property : PropertyFormat
     ):
         Property(
             name_,
-            SB_NULLPTR,
+            Get<Derived, Type>(
+                SB_NULLPTR
+            ),
             set_
         )
     {
@@ -105,72 +157,371 @@ struct Property : PropertyFormat
     ):
         Property(
             name_,
-            Get<Derived, Type>(
+            static_cast<Type(Derived::*)() const>(
                 SB_NULLPTR
             ),
-            Set<Derived, Type>(
-                set_
-            )
+            set_
         )
     {
     }
 
+    /// Returns the value of this property for \a object_.
+    Any
+    get
+    (
+        const Base& object_
+    )
+    const
+    {
+        return this->get_thunk(object_, *this);
+    }
+
+    /// Sets the value of this property for \a object_ to \a value_.
+    void
+    set
+    (
+        Base& object_,
+        const Any& value_
+    )
+    const
+    {
+        this->set_thunk(object_, *this, value_);
+    }
+
+    /// Returns the value of this property for \a object_ as a \a T.
+    ///
+    /// If \a T is the type of this property, the accessor is called without
+    /// wrapping the value in an Any.
+    template<typename T>
+    T
+    get_as
+    (
+        const Base& object_
+    )
+    const
+    {
+        using TypedGet = T(*)(const Base&, const Property&);
+
+        return (
+            std::is_same<T, typename std::decay<T>::type>::value &&
+            this->type == typeid(T)
+        ) ? (
+            reinterpret_cast<TypedGet>(this->typed_get)(object_, *this)
+        ) : (
+            any_cast<T>(this->get(object_))
+        );
+    }
+
+    /// Sets the value of this property for \a object_ to the \a T
+    /// \a value_.
+    ///
+    /// If \a T is the type of this property, the accessor is called without
+    /// wrapping the value in an Any.
+    template<typename T>
+    void
+    set_as
+    (
+        Base& object_,
+        const T& value_
+    )
+    const
+    {
+        using TypedSet = void(*)(Base&, const Property&, const T&);
+
+        if(this->type == typeid(T))
+        {
+            reinterpret_cast<TypedSet>(this->typed_set)(
+                object_,
+                *this,
+                value_
+            );
+        }
+        else
+        {
+            this->set(object_, Any(value_));
+        }
+    }
+
 private:
 
+    using GetThunk = Any(*)(const Base&, const Property&);
+
+    using SetThunk = void(*)(Base&, const Property&, const Any&);
+
+    template<typename Type>
+    struct TypeTag
+    {
+    };
+
+    // common initialization of the constructors
+
+    template<typename Type>
+    Property
+    (
+        const std::string& name_,
+        TypeTag<Type>
+    ):
+        PropertyFormat{
+            typeid(Type),
+            name_,
+            AccessRights::NONE
+        },
+        hash(Hasher<Type>::get()),
+        get_thunk(SB_NULLPTR),
+        set_thunk(SB_NULLPTR),
+        typed_get(SB_NULLPTR),
+        typed_set(SB_NULLPTR)
+    {
+    }
+
+    template<typename Accessors>
+    void
+    set_getter
+    (
+    )
+    {
+        this->get_thunk = &Accessors::get;
+        this->typed_get = reinterpret_cast<PropertyTraits::ErasedFunction>(
+            &Accessors::get_typed
+        );
+
+        bitmask(this->access_rights).set(AccessRights::READ);
+    }
+
+    template<typename Accessors>
+    void
+    set_setter
+    (
+    )
+    {
+        this->set_thunk = &Accessors::set;
+        this->typed_set = reinterpret_cast<PropertyTraits::ErasedFunction>(
+            &Accessors::set_typed
+        );
+
+        bitmask(this->access_rights).set(AccessRights::WRITE);
+    }
+
+    // trampolines calling pointers to member functions, stored by value
+
     template<typename Derived, typename Type>
-    struct Caller
+    struct MemberAccessors
     {
 
-        Get<Derived, Type>
-        get;
+        using Getter = Type(Derived::*)() const;
 
-        Set<Derived, Type>
-        set;
+        using Setter = void(Derived::*)(const Type&);
 
-        Caller
+        template<typename Member>
+        static
+        void
+        store
         (
-            Get<Derived, Type> get_
-        ):
-            get(get_)
+            PropertyTraits::MemberStorage& storage_,
+            Member member_
+        )
         {
+            static_assert(
+                sizeof(Member) <= sizeof(storage_.bytes),
+                "sb::Property: pointer to member too large"
+            );
+
+            std::memcpy(&storage_.bytes, &member_, sizeof(Member));
         }
 
-        Caller
+        template<typename Member>
+        static
+        Member
+        load
         (
-            Set<Derived, Type> set_
-        ):
-            set(set_)
+            const PropertyTraits::MemberStorage& storage_
+        )
         {
+            Member member;
+
+            std::memcpy(&member, &storage_.bytes, sizeof(Member));
+
+            return member;
         }
 
+        static
+        Type
+        get_typed
+        (
+            const Base& object_,
+            const Property& property_
+        )
+        {
+            return (
+                static_cast<const Derived&>(object_).*
+                load<Getter>(property_.get_storage)
+            )();
+        }
+
+        static
         Any
-        operator()
+        get
         (
-            const Base& object_
+            const Base& object_,
+            const Property& property_
         )
         {
-            return Any(
-                this->get(
-                    static_cast<const Derived&>(object_)
-                )
-            );
+            return Any(get_typed(object_, property_));
         }
 
+        static
         void
-        operator()
+        set_typed
         (
             Base& object_,
+            const Property& property_,
+            const Type& value_
+        )
+        {
+            (
+                static_cast<Derived&>(object_).*
+                load<Setter>(property_.set_storage)
+            )(value_);
+        }
+
+        static
+        void
+        set
+        (
+            Base& object_,
+            const Property& property_,
             const Any& value_
         )
         {
-            this->set(
-                static_cast<Derived&>(object_),
-                any_cast<Type>(value_)
+            set_typed(object_, property_, any_cast<const Type&>(value_));
+        }
+
+    };
+
+    // trampolines calling any other accessors, held by std::function
+
+    template<typename Derived, typename Type>
+    struct FunctionAccessors
+    {
+
+        static
+        Type
+        get_typed
+        (
+            const Base& object_,
+            const Property& property_
+        )
+        {
+            return (*std::static_pointer_cast<Get<Derived, Type>>(
+                property_.get_function
+            ))(static_cast<const Derived&>(object_));
+        }
+
+        static
+        Any
+        get
+        (
+            const Base& object_,
+            const Property& property_
+        )
+        {
+            return Any(get_typed(object_, property_));
+        }
+
+        static
+        void
+        set_typed
+        (
+            Base& object_,
+            const Property& property_,
+            const Type& value_
+        )
+        {
+            (*std::static_pointer_cast<Set<Derived, Type>>(
+                property_.set_function
+            ))(static_cast<Derived&>(object_), value_);
+        }
+
+        static
+        void
+        set
+        (
+            Base& object_,
+            const Property& property_,
+            const Any& value_
+        )
+        {
+            set_typed(object_, property_, any_cast<const Type&>(value_));
+        }
+
+    };
+
+    template<typename Type, bool = Hash<Type>::ENABLED>
+    struct Hasher
+    {
+
+        static
+        HashFunction
+        get
+        (
+        )
+        {
+            return SB_NULLPTR;
+        }
+
+    };
+
+    template<typename Type>
+    struct Hasher<Type, true>
+    {
+
+        static
+        std::size_t
+        compute
+        (
+            const Any& value_
+        )
+        {
+            return Hash<Type>::compute(
+                any_cast<const Type&>(value_)
             );
         }
 
+        static
+        HashFunction
+        get
+        (
+        )
+        {
+            return &Hasher::compute;
+        }
+
     };
 
+    GetThunk
+    get_thunk;
+
+    SetThunk
+    set_thunk;
+
+    PropertyTraits::ErasedFunction
+    typed_get;
+
+    PropertyTraits::ErasedFunction
+    typed_set;
+
+    PropertyTraits::MemberStorage
+    get_storage;
+
+    PropertyTraits::MemberStorage
+    set_storage;
+
+    std::shared_ptr<void>
+    get_function;
+
+    std::shared_ptr<void>
+    set_function;
+
 };
 
 template<typename T>
@@ -0,0 +1,111 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_PROPERTYTRANSACTION_PRIVATE_H
+#define SB_PROPERTYTRANSACTION_PRIVATE_H
+
+#include <sb-core/sb-propertytransaction.h>
+
+#include <sb-core/sb-abstractblok.h>
+
+#include <vector>
+
+namespace sb
+{
+
+// state shared by the transactions of a thread
+
+struct SB_DECL_HIDDEN TransactionState
+{
+
+    Size
+    depth;
+
+    bool
+    is_committing;
+
+    std::vector<AbstractBlok*>
+    pending_bloks;
+
+};
+
+class SB_DECL_HIDDEN PropertyTransaction::Private
+{
+
+public:
+
+    Private
+    (
+        PropertyTransaction* q_ptr_
+    );
+
+    // returns true if the update of blok_ was deferred
+
+    static
+    bool
+    defer_update
+    (
+        AbstractBlok* blok_
+    );
+
+    static
+    void
+    on_destroyed
+    (
+        AbstractBlok* blok_
+    );
+
+    static
+    TransactionState&
+    get_state
+    (
+    );
+
+    // returns the number of exceptions being thrown in the current thread
+
+    static
+    int
+    get_uncaught_exception_count
+    (
+    );
+
+    // closes the transaction without updating the recorded bloks
+
+    void
+    discard
+    (
+    );
+
+public:
+
+    PropertyTransaction*
+    q_ptr;
+
+    bool
+    is_committed;
+
+    // exceptions being thrown when the transaction was opened: more of them
+    // on destruction mean the stack is unwinding
+
+    int
+    uncaught_exception_count;
+
+};
+
+}
+
+#endif // SB_PROPERTYTRANSACTION_PRIVATE_H
@@ -0,0 +1,216 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-propertytransaction.h>
+
+#include <sb-core/sb-propertytransaction-private.h>
+
+#include <algorithm>
+#include <exception>
+
+#include <sb-core/sb-propagation-private.h>
+
+using namespace sb;
+
+PropertyTransaction::PropertyTransaction
+(
+)
+{
+    this->d_ptr = new Private(this);
+
+    ++Private::get_state().depth;
+}
+
+PropertyTransaction::~PropertyTransaction
+(
+)
+{
+    if(
+        Private::get_uncaught_exception_count() >
+            d_ptr->uncaught_exception_count
+    )
+    {
+        // the updates were interrupted by an exception: don't run them
+
+        d_ptr->discard();
+    }
+    else
+    {
+        try
+        {
+            this->commit();
+        }
+        catch(...)
+        {
+            // a destructor must not throw: commit() reports the errors when
+            // called explicitly
+        }
+    }
+
+    delete d_ptr;
+}
+
+void
+PropertyTransaction::commit
+(
+)
+{
+    if(d_ptr->is_committed)
+    {
+        return;
+    }
+
+    d_ptr->is_committed = true;
+
+    TransactionState& state = Private::get_state();
+
+    if(--state.depth != 0)
+    {
+        // an outer transaction will commit
+
+        return;
+    }
+
+    // a single propagation updates the pending bloks and their followers,
+    // upstream first and each once
+
+    state.is_committing = true;
+
+    for(auto blok : state.pending_bloks)
+    {
+        if(blok)
+        {
+            Propagation::schedule_modified(blok);
+        }
+    }
+
+    state.pending_bloks.clear();
+
+    try
+    {
+        Propagation::run();
+    }
+    catch(...)
+    {
+        state.is_committing = false;
+
+        throw;
+    }
+
+    state.is_committing = false;
+}
+
+bool
+PropertyTransaction::is_open
+(
+)
+{
+    return Private::get_state().depth != 0;
+}
+
+PropertyTransaction::Private::Private
+(
+    PropertyTransaction* q_ptr_
+):
+    q_ptr                       (q_ptr_),
+    is_committed                (false),
+    uncaught_exception_count    (get_uncaught_exception_count())
+{
+}
+
+bool
+PropertyTransaction::Private::defer_update
+(
+    AbstractBlok* blok_
+)
+{
+    TransactionState& state = get_state();
+
+    bool deferred = state.depth != 0 && !state.is_committing;
+
+    if(
+        deferred &&
+        std::find(
+            state.pending_bloks.begin(),
+            state.pending_bloks.end(),
+            blok_
+        ) == state.pending_bloks.end()
+    )
+    {
+        state.pending_bloks.push_back(blok_);
+    }
+
+    return deferred;
+}
+
+void
+PropertyTransaction::Private::on_destroyed
+(
+    AbstractBlok* blok_
+)
+{
+    TransactionState& state = get_state();
+
+    std::replace(
+        state.pending_bloks.begin(),
+        state.pending_bloks.end(),
+        blok_,
+        static_cast<AbstractBlok*>(SB_NULLPTR)
+    );
+}
+
+TransactionState&
+PropertyTransaction::Private::get_state
+(
+)
+{
+    static SB_THREAD_LOCAL TransactionState state = {0, false, {}};
+
+    return state;
+}
+
+int
+PropertyTransaction::Private::get_uncaught_exception_count
+(
+)
+{
+#if defined(__cpp_lib_uncaught_exceptions)
+    return std::uncaught_exceptions();
+#else
+    return std::uncaught_exception() ? 1 : 0;
+#endif
+}
+
+void
+PropertyTransaction::Private::discard
+(
+)
+{
+    if(!this->is_committed)
+    {
+        this->is_committed = true;
+
+        TransactionState& state = get_state();
+
+        // the bloks recorded by inner transactions are discarded as well
+
+        if(--state.depth == 0)
+        {
+            state.pending_bloks.clear();
+        }
+    }
+}
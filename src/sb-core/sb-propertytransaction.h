@@ -0,0 +1,107 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_PROPERTYTRANSACTION_H
+#define SB_PROPERTYTRANSACTION_H
+
+#include <sb-core/sb-coredefine.h>
+
+namespace sb
+{
+
+/// \brief The PropertyTransaction class groups property updates so that the
+/// modified bloks are updated once.
+///
+/// While a transaction is open in a thread, AbstractBlok::update() only
+/// records the blok. On commit, the recorded bloks are updated from upstream
+/// to downstream, and a blok already executed by the propagation of an
+/// upstream one is not updated again: reconfiguring several bloks of a
+/// pipeline triggers a single propagation.
+///
+/// Transactions can be nested: only the outermost one commits.
+///
+/// \code{cpp}
+/// {
+///     sb::PropertyTransaction transaction;
+///
+///     source->set("text", std::string("Hello"));
+///     filter->set("multiplier", 3);
+/// } // the pipeline runs once here
+/// \endcode
+///
+/// \sa AbstractObject::set_many().
+class SB_CORE_API PropertyTransaction
+{
+
+public:
+
+    class Private;
+
+    /// Opens a transaction in the current thread.
+    PropertyTransaction
+    (
+    );
+
+    /// Commits the transaction if commit() was not called.
+    ///
+    /// The destructor never throws: errors of the update are only reported
+    /// by commit(). If the transaction is destroyed by an exception, the
+    /// recorded bloks are not updated.
+    ~PropertyTransaction
+    (
+    );
+
+    PropertyTransaction
+    (
+        const PropertyTransaction& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    PropertyTransaction&
+    operator=
+    (
+        const PropertyTransaction& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    /// Closes the transaction and, if it is the outermost one, updates the
+    /// recorded bloks.
+    void
+    commit
+    (
+    );
+
+    /// Returns \b true if a transaction is open in the current thread;
+    /// returns \b false otherwise.
+    static
+    bool
+    is_open
+    (
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+}
+
+#endif // SB_PROPERTYTRANSACTION_H
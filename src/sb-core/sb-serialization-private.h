@@ -0,0 +1,106 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_SERIALIZATION_PRIVATE_H
+#define SB_SERIALIZATION_PRIVATE_H
+
+#include <sb-core/sb-serialization.h>
+
+#include <map>
+
+namespace sb
+{
+
+using TypeToCodecMap = std::map<std::type_index, Codec>;
+
+class SB_DECL_HIDDEN CodecRegistry
+{
+
+public:
+
+    // returns the codec registered for type_, or nullptr
+
+    static
+    const Codec*
+    find
+    (
+        const std::type_index& type_
+    );
+
+};
+
+class SB_DECL_HIDDEN Writer::Private
+{
+
+public:
+
+    Private
+    (
+        Writer* q_ptr_
+    );
+
+    static
+    Private*
+    from
+    (
+        const Writer* this_
+    );
+
+public:
+
+    Writer*
+    q_ptr;
+
+    std::vector<char>
+    buffer;
+
+};
+
+class SB_DECL_HIDDEN Reader::Private
+{
+
+public:
+
+    Private
+    (
+        Reader* q_ptr_,
+        const char* data_,
+        Size size_
+    );
+
+public:
+
+    Reader*
+    q_ptr;
+
+    const char*
+    data;
+
+    Size
+    size;
+
+    Index
+    position;
+
+    bool
+    is_valid;
+
+};
+
+}
+
+#endif // SB_SERIALIZATION_PRIVATE_H
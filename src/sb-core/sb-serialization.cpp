@@ -0,0 +1,542 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-serialization.h>
+
+#include <sb-core/sb-serialization-private.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#include <sb-core/sb-abstractobject-private.h>
+
+namespace sb
+{
+
+namespace Global
+{
+
+// the header of a serialized object starts with "SBOB"
+
+const std::uint32_t
+serialization_magic = 0x424f4253;
+
+TypeToCodecMap
+codecs;
+
+// register the codecs of the fundamental types and std::string
+
+bool
+default_codecs_registered = (
+    register_codec<bool>(),
+    register_codec<char>(),
+    register_codec<signed char>(),
+    register_codec<unsigned char>(),
+    register_codec<short>(),
+    register_codec<unsigned short>(),
+    register_codec<int>(),
+    register_codec<unsigned int>(),
+    register_codec<long>(),
+    register_codec<unsigned long>(),
+    register_codec<long long>(),
+    register_codec<unsigned long long>(),
+    register_codec<float>(),
+    register_codec<double>(),
+    register_codec<long double>(),
+    register_codec<std::string>()
+);
+
+}
+
+namespace Unmapper
+{
+
+inline
+const Codec*
+codec
+(
+    const std::type_index& type_
+)
+{
+    auto found_codec = Global::codecs.find(type_);
+
+    return found_codec != Global::codecs.end() ?
+        &found_codec->second :
+        SB_NULLPTR;
+}
+
+}
+
+}
+
+using namespace sb;
+
+Writer::Writer
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+Writer::~Writer
+(
+)
+{
+    delete d_ptr;
+}
+
+void
+Writer::write
+(
+    const void* data_,
+    Size size_,
+    Size alignment_
+)
+{
+    std::vector<char>& buffer = d_ptr->buffer;
+
+    // pad with zeros up to the next multiple of alignment_
+
+    Size padding = (alignment_ - buffer.size() % alignment_) % alignment_;
+
+    buffer.resize(buffer.size() + padding, '\0');
+
+    const char* data = static_cast<const char*>(data_);
+
+    buffer.insert(buffer.end(), data, data + size_);
+}
+
+void
+Writer::write_at
+(
+    Index position_,
+    const void* data_,
+    Size size_
+)
+{
+    if(position_ + size_ > d_ptr->buffer.size())
+    {
+        throw std::out_of_range(
+            std::string() +
+            "sb::Writer::write_at: " +
+            "writing past the end of the buffer"
+        );
+    }
+
+    std::memcpy(
+        d_ptr->buffer.data() + position_,
+        data_,
+        size_
+    );
+}
+
+void
+Writer::write_string
+(
+    const std::string& value_
+)
+{
+    this->write_value(
+        static_cast<std::uint64_t>(value_.size())
+    );
+    this->write(
+        value_.data(),
+        value_.size()
+    );
+}
+
+void
+Writer::clear
+(
+)
+{
+    d_ptr->buffer.clear();
+}
+
+Size
+Writer::get_size
+(
+)
+const
+{
+    return d_ptr->buffer.size();
+}
+
+const std::vector<char>&
+Writer::get_buffer
+(
+)
+const
+{
+    return d_ptr->buffer;
+}
+
+Writer::Private::Private
+(
+    Writer* q_ptr_
+):
+    q_ptr(q_ptr_)
+{
+}
+
+Writer::Private*
+Writer::Private::from
+(
+    const Writer* this_
+)
+{
+    return this_->d_ptr;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Reader::Reader
+(
+    const char* data_,
+    Size size_
+)
+{
+    this->d_ptr = new Private(this, data_, size_);
+}
+
+Reader::Reader
+(
+    const std::vector<char>& buffer_
+):
+    Reader(
+        buffer_.data(),
+        buffer_.size()
+    )
+{
+}
+
+Reader::~Reader
+(
+)
+{
+    delete d_ptr;
+}
+
+const char*
+Reader::view
+(
+    Size size_,
+    Size alignment_
+)
+{
+    const char* data = SB_NULLPTR;
+
+    Index position = d_ptr->position;
+
+    // skip the padding
+
+    position += (alignment_ - position % alignment_) % alignment_;
+
+    if(
+        d_ptr->is_valid &&
+        position <= d_ptr->size &&
+        size_ <= d_ptr->size - position
+    )
+    {
+        data = d_ptr->data + position;
+
+        d_ptr->position = position + size_;
+    }
+    else
+    {
+        d_ptr->is_valid = false;
+    }
+
+    return data;
+}
+
+const char*
+Reader::view_array
+(
+    Size count_,
+    Size element_size_,
+    Size alignment_
+)
+{
+    const char* data = SB_NULLPTR;
+
+    // count_ comes from the buffer: check it before multiplying, so that a
+    // corrupted count can't wrap around
+
+    Size remaining =
+        d_ptr->position <= d_ptr->size ? d_ptr->size - d_ptr->position : 0;
+
+    if(count_ <= remaining / element_size_)
+    {
+        data = this->view(count_ * element_size_, alignment_);
+    }
+    else
+    {
+        d_ptr->is_valid = false;
+    }
+
+    return data;
+}
+
+bool
+Reader::read_string
+(
+    std::string& value_
+)
+{
+    std::uint64_t size = 0;
+
+    const char* data = SB_NULLPTR;
+
+    if(this->read_value(size))
+    {
+        data = this->view(static_cast<Size>(size));
+    }
+
+    if(data)
+    {
+        value_.assign(data, static_cast<Size>(size));
+    }
+
+    return data != SB_NULLPTR;
+}
+
+Index
+Reader::get_position
+(
+)
+const
+{
+    return d_ptr->position;
+}
+
+bool
+Reader::is_valid
+(
+)
+const
+{
+    return d_ptr->is_valid;
+}
+
+Reader::Private::Private
+(
+    Reader* q_ptr_,
+    const char* data_,
+    Size size_
+):
+    q_ptr       (q_ptr_),
+    data        (data_),
+    size        (size_),
+    position    (0),
+    is_valid    (true)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool
+sb::register_codec
+(
+    const std::type_index& type_,
+    const Codec& codec_
+)
+{
+    return Global::codecs.insert(
+        std::make_pair(type_, codec_)
+    ).second;
+}
+
+bool
+sb::serialize
+(
+    const AbstractObject& object_,
+    Writer& writer_
+)
+{
+    auto object_d_ptr = AbstractObject::Private::from(&object_);
+
+    // keep the properties in read-write mode with a codec
+
+    std::vector<
+        std::pair<const ObjectProperty*, const Codec*>
+    > properties;
+
+    bool complete = true;
+
+    for(const auto& name_property : *object_d_ptr->properties)
+    {
+        const ObjectProperty& property = name_property.second;
+
+        auto access_rights = bitmask(property.access_rights);
+
+        if(
+            access_rights.is_set(AccessRights::READ) &&
+            access_rights.is_set(AccessRights::WRITE)
+        )
+        {
+            const Codec* codec = Unmapper::codec(property.type);
+
+            if(codec)
+            {
+                properties.push_back(std::make_pair(&property, codec));
+            }
+            else
+            {
+                complete = false;
+            }
+        }
+    }
+
+    // write the header
+
+    writer_.write_value(Global::serialization_magic);
+    writer_.write_value(SERIALIZATION_FORMAT_VERSION);
+    writer_.write_string(object_d_ptr->type_names[0]);
+    writer_.write_value(
+        static_cast<std::uint64_t>(properties.size())
+    );
+
+    // write the properties, each preceded by its name and the size of its
+    // value so that a reader can skip it
+
+    for(const auto& property_codec : properties)
+    {
+        const ObjectProperty& property = *property_codec.first;
+
+        writer_.write_string(property.name);
+
+        std::uint64_t size = 0;
+
+        writer_.write_value(size);
+
+        Index position = writer_.get_size();
+
+        property_codec.second->encode(
+            property.get(object_),
+            writer_
+        );
+
+        size = writer_.get_size() - position;
+
+        writer_.write_at(
+            position - sizeof(size),
+            &size,
+            sizeof(size)
+        );
+    }
+
+    return complete;
+}
+
+bool
+sb::deserialize
+(
+    AbstractObject& object_,
+    Reader& reader_
+)
+{
+    auto object_d_ptr = AbstractObject::Private::from(&object_);
+
+    // read the header
+
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::string type_name;
+    std::uint64_t count = 0;
+
+    bool ok = (
+        reader_.read_value(magic) &&
+        reader_.read_value(version) &&
+        reader_.read_string(type_name) &&
+        reader_.read_value(count)
+    );
+
+    ok = (
+        ok &&
+        magic == Global::serialization_magic &&
+        version <= SERIALIZATION_FORMAT_VERSION &&
+        type_name == object_d_ptr->type_names[0]
+    );
+
+    // read the properties
+
+    for(std::uint64_t i = 0; ok && i < count; ++i)
+    {
+        std::string name;
+        std::uint64_t size = 0;
+
+        ok = reader_.read_string(name) && reader_.read_value(size);
+
+        if(!ok)
+        {
+            break;
+        }
+
+        Index end = reader_.get_position() + static_cast<Size>(size);
+
+        auto found_property = object_d_ptr->properties->find(name);
+
+        const Codec* codec = SB_NULLPTR;
+
+        if(
+            found_property != object_d_ptr->properties->end() &&
+            bitmask(
+                found_property->second.access_rights
+            ).is_set(
+                AccessRights::WRITE
+            )
+        )
+        {
+            codec = Unmapper::codec(found_property->second.type);
+        }
+
+        if(codec)
+        {
+            Any value;
+
+            ok = (
+                codec->decode(reader_, value) &&
+                reader_.get_position() == end
+            );
+
+            if(ok)
+            {
+                found_property->second.set(object_, value);
+            }
+        }
+        else
+        {
+            // skip the value
+
+            ok = reader_.view(static_cast<Size>(size)) != SB_NULLPTR;
+        }
+    }
+
+    return ok;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+const Codec*
+CodecRegistry::find
+(
+    const std::type_index& type_
+)
+{
+    return Unmapper::codec(type_);
+}
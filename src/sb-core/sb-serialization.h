@@ -0,0 +1,552 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_SERIALIZATION_H
+#define SB_SERIALIZATION_H
+
+#include <sb-core/sb-abstractobject.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+namespace sb
+{
+
+/// Version of the binary format written by serialize().
+///
+/// deserialize() reads any version up to this one.
+const std::uint32_t SERIALIZATION_FORMAT_VERSION = 1;
+
+/// \brief The Writer class appends binary values to a memory buffer.
+///
+/// Values can be aligned: padding is inserted so that their offset in the
+/// buffer is a multiple of their alignment. A Reader of the same buffer can
+/// then view them in place.
+///
+/// \sa Reader and serialize().
+class SB_CORE_API Writer
+{
+
+public:
+
+    class Private;
+
+    /// Constructs a writer with an empty buffer.
+    Writer
+    (
+    );
+
+    /// Destroys this object.
+    ~Writer
+    (
+    );
+
+    Writer
+    (
+        const Writer& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    Writer&
+    operator=
+    (
+        const Writer& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    /// Appends \a size_ bytes from \a data_, at an offset multiple of
+    /// \a alignment_.
+    void
+    write
+    (
+        const void* data_,
+        Size size_,
+        Size alignment_ = 1
+    );
+
+    /// Writes \a size_ bytes from \a data_ at the offset \a position_,
+    /// overwriting the bytes already written there.
+    void
+    write_at
+    (
+        Index position_,
+        const void* data_,
+        Size size_
+    );
+
+    /// Appends the trivially copyable \a value_, aligned on its type.
+    template<typename T>
+    void
+    write_value
+    (
+        const T& value_
+    )
+    {
+        static_assert(
+            std::is_trivially_copyable<T>::value,
+            "sb::Writer::write_value: T must be trivially copyable"
+        );
+
+        this->write(&value_, sizeof(T), alignof(T));
+    }
+
+    /// Appends the string \a value_, preceded by its length.
+    void
+    write_string
+    (
+        const std::string& value_
+    );
+
+    /// Removes all the written bytes, keeping the memory allocated for the
+    /// buffer so that the writer can be reused.
+    void
+    clear
+    (
+    );
+
+    /// Returns the number of bytes written.
+    Size
+    get_size
+    (
+    )
+    const;
+
+    /// Returns the buffer holding the written bytes.
+    const std::vector<char>&
+    get_buffer
+    (
+    )
+    const;
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The Reader class reads binary values from a memory buffer.
+///
+/// A reader doesn't own its buffer, which must outlive it. Values written
+/// aligned by a Writer can be viewed in place with view(), without copy,
+/// provided the buffer starts at an address suitably aligned (e.g. the data
+/// of a std::vector).
+///
+/// Reading past the end of the buffer fails: the functions then return
+/// \b false (or \b nullptr) and the reader stays invalid.
+///
+/// \sa Writer and deserialize().
+class SB_CORE_API Reader
+{
+
+public:
+
+    class Private;
+
+    /// Constructs a reader of the \a size_ bytes pointed to by \a data_.
+    Reader
+    (
+        const char* data_,
+        Size size_
+    );
+
+    /// Constructs a reader of \a buffer_.
+    explicit
+    Reader
+    (
+        const std::vector<char>& buffer_
+    );
+
+    /// Destroys this object.
+    ~Reader
+    (
+    );
+
+    Reader
+    (
+        const Reader& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    Reader&
+    operator=
+    (
+        const Reader& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    /// Returns a pointer to the next \a size_ bytes, skipping the padding
+    /// inserted to align them on \a alignment_, and moves past them.
+    ///
+    /// The function returns \b nullptr if the buffer is too short.
+    const char*
+    view
+    (
+        Size size_,
+        Size alignment_ = 1
+    );
+
+    /// Returns a pointer to the next \a count_ values of type \a T, viewed
+    /// in place, and moves past them.
+    ///
+    /// The function returns \b nullptr if the buffer is too short, including
+    /// when \a count_ values of type \a T exceed the addressable size.
+    ///
+    /// \sa Writer::write_value().
+    template<typename T>
+    const T*
+    view
+    (
+        Size count_ = 1
+    )
+    {
+        static_assert(
+            std::is_trivially_copyable<T>::value,
+            "sb::Reader::view: T must be trivially copyable"
+        );
+
+        return reinterpret_cast<const T*>(
+            this->view_array(count_, sizeof(T), alignof(T))
+        );
+    }
+
+    /// Copies the next trivially copyable value into \a value_.
+    template<typename T>
+    bool
+    read_value
+    (
+        T& value_
+    )
+    {
+        const T* value = this->view<T>();
+
+        if(value)
+        {
+            value_ = *value;
+        }
+
+        return value != SB_NULLPTR;
+    }
+
+    /// Reads a string written by Writer::write_string() into \a value_.
+    bool
+    read_string
+    (
+        std::string& value_
+    );
+
+    /// Returns the number of bytes already read.
+    Index
+    get_position
+    (
+    )
+    const;
+
+    /// Returns \b true if no read failed; returns \b false otherwise.
+    bool
+    is_valid
+    (
+    )
+    const;
+
+private:
+
+    /// \cond INTERNAL
+    const char*
+    view_array
+    (
+        Size count_,
+        Size element_size_,
+        Size alignment_
+    );
+    /// \endcond
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The Codec structure holds the functions encoding and decoding the
+/// values of a type.
+///
+/// \sa register_codec().
+struct Codec
+{
+
+    using Encode = void(*)(const Any&, Writer&);
+
+    using Decode = bool(*)(Reader&, Any&);
+
+    Encode
+    encode;
+
+    Decode
+    decode;
+
+};
+
+/// \cond INTERNAL
+namespace CodecTraits
+{
+
+    // contiguous containers constructible from a range of trivially
+    // copyable elements (e.g. std::vector, std::string)
+
+    template<typename T, typename = void>
+    struct IsContiguous : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct IsContiguous<
+        T,
+        decltype(
+            void(std::declval<const T&>().size()),
+            void(
+                T(
+                    std::declval<const T&>().data(),
+                    std::declval<const T&>().data()
+                )
+            )
+        )
+    > : std::is_trivially_copyable<
+        typename std::decay<
+            decltype(*std::declval<const T&>().data())
+        >::type
+    >
+    {
+    };
+
+}
+/// \endcond
+
+/// \brief The ValueCodec template class encodes and decodes the values of
+/// the type \a T.
+///
+/// Trivially copyable values and contiguous containers of trivially copyable
+/// elements are supported; the constant ValueCodec<T>::ENABLED is \b false
+/// for other types.
+template<
+    typename T,
+    bool = std::is_trivially_copyable<T>::value,
+    bool = CodecTraits::IsContiguous<T>::value
+>
+struct ValueCodec
+{
+
+    static
+    SB_CONSTEXPR_OBJECT
+    bool
+    ENABLED = false;
+
+};
+
+/// \cond INTERNAL
+template<typename T, bool IsContiguous>
+struct ValueCodec<T, true, IsContiguous>
+{
+
+    static
+    SB_CONSTEXPR_OBJECT
+    bool
+    ENABLED = true;
+
+    static
+    void
+    encode
+    (
+        const Any& value_,
+        Writer& writer_
+    )
+    {
+        writer_.write_value(
+            any_cast<const T&>(value_)
+        );
+    }
+
+    static
+    bool
+    decode
+    (
+        Reader& reader_,
+        Any& value_
+    )
+    {
+        const T* value = reader_.view<T>();
+
+        if(value)
+        {
+            value_ = *value;
+        }
+
+        return value != SB_NULLPTR;
+    }
+
+};
+/// \endcond
+
+/// \cond INTERNAL
+template<typename T>
+struct ValueCodec<T, false, true>
+{
+
+    using Element = typename std::decay<
+        decltype(*std::declval<const T&>().data())
+    >::type;
+
+    static
+    SB_CONSTEXPR_OBJECT
+    bool
+    ENABLED = true;
+
+    static
+    void
+    encode
+    (
+        const Any& value_,
+        Writer& writer_
+    )
+    {
+        const T& value = any_cast<const T&>(value_);
+
+        writer_.write_value(
+            static_cast<std::uint64_t>(value.size())
+        );
+        writer_.write(
+            value.data(),
+            value.size() * sizeof(Element),
+            alignof(Element)
+        );
+    }
+
+    static
+    bool
+    decode
+    (
+        Reader& reader_,
+        Any& value_
+    )
+    {
+        std::uint64_t size = 0;
+
+        const Element* elements = SB_NULLPTR;
+
+        if(reader_.read_value(size))
+        {
+            elements = reader_.view<Element>(static_cast<Size>(size));
+        }
+
+        if(elements)
+        {
+            value_ = T(elements, elements + size);
+        }
+
+        return elements != SB_NULLPTR;
+    }
+
+};
+/// \endcond
+
+/// Registers \a codec_ to encode and decode the values of the type
+/// \a type_.
+///
+/// The function returns \b true if there was no previously registered codec
+/// for \a type_; it returns \b false otherwise.
+///
+/// Codecs are registered for the fundamental types and std::string by
+/// default.
+SB_CORE_API
+bool
+register_codec
+(
+    const std::type_index& type_,
+    const Codec& codec_
+);
+
+/// Registers the codec of the type \a T provided by ValueCodec.
+///
+/// The function returns \b false if ValueCodec<T> is not enabled or if a
+/// codec was already registered for \a T.
+///
+/// \sa register_data().
+template<typename T>
+typename std::enable_if<ValueCodec<T>::ENABLED, bool>::type
+register_codec
+(
+)
+{
+    return register_codec(
+        typeid(T),
+        Codec{
+            &ValueCodec<T>::encode,
+            &ValueCodec<T>::decode
+        }
+    );
+}
+
+/// \cond INTERNAL
+template<typename T>
+typename std::enable_if<!ValueCodec<T>::ENABLED, bool>::type
+register_codec
+(
+)
+{
+    return false;
+}
+/// \endcond
+
+/// Writes the state of \a object_ with \a writer_.
+///
+/// The state is made of the values of the properties declared in read-write
+/// mode, preceded by a header holding the format version and the type name
+/// of \a object_. Properties of a type without registered codec are skipped:
+/// the function returns \b false if any property was skipped; it returns
+/// \b true otherwise.
+///
+/// \sa deserialize() and register_codec().
+SB_CORE_API
+bool
+serialize
+(
+    const AbstractObject& object_,
+    Writer& writer_
+);
+
+/// Reads the state of \a object_ with \a reader_.
+///
+/// The function returns \b false if the header doesn't match \a object_ or
+/// if the state is truncated; it returns \b true otherwise. Properties
+/// unknown to \a object_ are skipped.
+///
+/// \sa serialize().
+SB_CORE_API
+bool
+deserialize
+(
+    AbstractObject& object_,
+    Reader& reader_
+);
+
+}
+
+#endif // SB_SERIALIZATION_H
@@ -0,0 +1,143 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_SHAREDMEMORY_PRIVATE_H
+#define SB_SHAREDMEMORY_PRIVATE_H
+
+#include <sb-core/sb-sharedmemory.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace sb
+{
+
+// header placed at the beginning of a segment: head and tail count the
+// bytes pushed and popped since the creation of the segment, and are kept on
+// distinct cache lines so that the producer and the consumer don't contend
+
+struct SB_DECL_HIDDEN SharedMemoryHeader
+{
+
+    std::atomic<std::uint32_t>
+    magic;
+
+    std::atomic<std::uint32_t>
+    attachments;
+
+    std::uint64_t
+    capacity;
+
+    alignas(64)
+    std::atomic<std::uint64_t>
+    head;
+
+    alignas(64)
+    std::atomic<std::uint64_t>
+    tail;
+
+};
+
+class SB_DECL_HIDDEN SharedMemoryRing::Private
+{
+
+public:
+
+    Private
+    (
+        SharedMemoryRing* q_ptr_
+    );
+
+    bool
+    attach
+    (
+        const std::string& name_,
+        Size capacity_
+    );
+
+    void
+    detach
+    (
+    );
+
+public:
+
+    SharedMemoryRing*
+    q_ptr;
+
+    std::string
+    name;
+
+    void*
+    mapping;
+
+    Size
+    mapping_size;
+
+    SharedMemoryHeader*
+    header;
+
+    char*
+    data;
+
+    // size of the message returned by try_peek, padding included
+
+    Size
+    peeked_size;
+
+};
+
+class SB_DECL_HIDDEN SharedMemorySink::Private
+{
+
+public:
+
+    Private
+    (
+        SharedMemorySink* q_ptr_
+    );
+
+public:
+
+    SharedMemorySink*
+    q_ptr;
+
+    std::string
+    segment;
+
+    Size
+    capacity;
+
+    Size
+    timeout;
+
+    Size
+    dropped_count;
+
+    std::unique_ptr<SharedMemoryRing>
+    ring;
+
+    // reused between messages to keep its memory
+
+    Writer
+    writer;
+
+};
+
+}
+
+#endif // SB_SHAREDMEMORY_PRIVATE_H
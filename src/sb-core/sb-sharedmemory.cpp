@@ -0,0 +1,612 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <sb-core/sb-sharedmemory.h>
+
+#include <sb-core/sb-sharedmemory-private.h>
+
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if !SB_OS_IS_WIN
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace sb
+{
+
+namespace Global
+{
+
+// a segment is initialized once its magic number is set
+
+const std::uint32_t
+shared_memory_magic = 0x4d485342;
+
+// messages are preceded by their size and aligned on this value
+
+const Size
+shared_memory_alignment = 16;
+
+// a size marking the end of a lap: the next message is at the beginning of
+// the ring
+
+const std::uint64_t
+shared_memory_wrap = ~std::uint64_t(0);
+
+}
+
+namespace
+{
+
+inline
+Size
+align
+(
+    Size size_
+)
+{
+    return (
+        (size_ + Global::shared_memory_alignment - 1) /
+        Global::shared_memory_alignment *
+        Global::shared_memory_alignment
+    );
+}
+
+}
+
+}
+
+using namespace sb;
+
+SharedMemoryRing::SharedMemoryRing
+(
+    const std::string& name_,
+    Size capacity_
+)
+{
+    this->d_ptr = new Private(this);
+
+    d_ptr->attach(name_, capacity_);
+}
+
+SharedMemoryRing::~SharedMemoryRing
+(
+)
+{
+    d_ptr->detach();
+
+    delete d_ptr;
+}
+
+bool
+SharedMemoryRing::is_attached
+(
+)
+const
+{
+    return d_ptr->header != SB_NULLPTR;
+}
+
+Size
+SharedMemoryRing::get_capacity
+(
+)
+const
+{
+    return d_ptr->header ? d_ptr->header->capacity : 0;
+}
+
+Size
+SharedMemoryRing::get_attachment_count
+(
+)
+const
+{
+    return d_ptr->header ? d_ptr->header->attachments.load() : 0;
+}
+
+bool
+SharedMemoryRing::try_push
+(
+    const char* data_,
+    Size size_
+)
+{
+    SharedMemoryHeader* header = d_ptr->header;
+
+    if(!header)
+    {
+        return false;
+    }
+
+    Size capacity = header->capacity;
+
+    Size message_size = (
+        Global::shared_memory_alignment + align(size_)
+    );
+
+    if(message_size > capacity)
+    {
+        return false;
+    }
+
+    // only this thread writes head
+
+    std::uint64_t head = header->head.load(std::memory_order_relaxed);
+    std::uint64_t tail = header->tail.load(std::memory_order_acquire);
+
+    Size offset = head % capacity;
+
+    // a message is never split: skip the end of the ring if it is too short
+
+    Size padding = capacity - offset < message_size ? capacity - offset : 0;
+
+    if(capacity - (head - tail) < padding + message_size)
+    {
+        return false;
+    }
+
+    if(padding != 0)
+    {
+        std::memcpy(
+            d_ptr->data + offset,
+            &Global::shared_memory_wrap,
+            sizeof(Global::shared_memory_wrap)
+        );
+
+        head += padding;
+        offset = 0;
+    }
+
+    std::uint64_t size = size_;
+
+    std::memcpy(
+        d_ptr->data + offset,
+        &size,
+        sizeof(size)
+    );
+    std::memcpy(
+        d_ptr->data + offset + Global::shared_memory_alignment,
+        data_,
+        size_
+    );
+
+    // publish the message
+
+    header->head.store(head + message_size, std::memory_order_release);
+
+    return true;
+}
+
+bool
+SharedMemoryRing::try_peek
+(
+    const char*& data_,
+    Size& size_
+)
+{
+    SharedMemoryHeader* header = d_ptr->header;
+
+    bool peeked = false;
+
+    if(header)
+    {
+        Size capacity = header->capacity;
+
+        // only this thread writes tail
+
+        std::uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        std::uint64_t head = header->head.load(std::memory_order_acquire);
+
+        if(tail != head)
+        {
+            Size offset = tail % capacity;
+
+            std::uint64_t size = 0;
+
+            std::memcpy(&size, d_ptr->data + offset, sizeof(size));
+
+            if(size == Global::shared_memory_wrap)
+            {
+                // the message is at the beginning of the ring
+
+                tail += capacity - offset;
+                offset = 0;
+
+                header->tail.store(tail, std::memory_order_release);
+
+                std::memcpy(&size, d_ptr->data, sizeof(size));
+            }
+
+            data_ = d_ptr->data + offset + Global::shared_memory_alignment;
+            size_ = static_cast<Size>(size);
+
+            d_ptr->peeked_size = (
+                Global::shared_memory_alignment + align(size_)
+            );
+
+            peeked = true;
+        }
+    }
+
+    return peeked;
+}
+
+void
+SharedMemoryRing::pop
+(
+)
+{
+    if(d_ptr->header && d_ptr->peeked_size != 0)
+    {
+        d_ptr->header->tail.fetch_add(
+            d_ptr->peeked_size,
+            std::memory_order_release
+        );
+
+        d_ptr->peeked_size = 0;
+    }
+}
+
+SharedMemoryRing::Private::Private
+(
+    SharedMemoryRing* q_ptr_
+):
+    q_ptr           (q_ptr_),
+    mapping         (SB_NULLPTR),
+    mapping_size    (0),
+    header          (SB_NULLPTR),
+    data            (SB_NULLPTR),
+    peeked_size     (0)
+{
+}
+
+bool
+SharedMemoryRing::Private::attach
+(
+    const std::string& name_,
+    Size capacity_
+)
+{
+#if !SB_OS_IS_WIN
+    // POSIX names start with a slash
+
+    this->name = (name_.empty() || name_[0] != '/') ? "/" + name_ : name_;
+
+    Size data_offset = align(sizeof(SharedMemoryHeader));
+
+    bool created = true;
+
+    int fd = shm_open(
+        this->name.c_str(),
+        O_RDWR | O_CREAT | O_EXCL,
+        0600
+    );
+
+    if(fd >= 0)
+    {
+        this->mapping_size = data_offset + align(capacity_);
+
+        if(ftruncate(fd, this->mapping_size) != 0)
+        {
+            close(fd);
+
+            shm_unlink(this->name.c_str());
+
+            return false;
+        }
+    }
+    else
+    {
+        created = false;
+
+        fd = shm_open(this->name.c_str(), O_RDWR, 0600);
+
+        if(fd < 0)
+        {
+            return false;
+        }
+
+        // wait for the creator to size the segment
+
+        struct stat status;
+
+        for(int i = 0; i < 1000 && this->mapping_size <= data_offset; ++i)
+        {
+            if(fstat(fd, &status) == 0)
+            {
+                this->mapping_size = static_cast<Size>(status.st_size);
+            }
+
+            if(this->mapping_size <= data_offset)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    void* mapping = SB_NULLPTR;
+
+    if(this->mapping_size > data_offset)
+    {
+        mapping = mmap(
+            SB_NULLPTR,
+            this->mapping_size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            fd,
+            0
+        );
+    }
+
+    close(fd);
+
+    if(mapping == SB_NULLPTR || mapping == MAP_FAILED)
+    {
+        if(created)
+        {
+            shm_unlink(this->name.c_str());
+        }
+
+        return false;
+    }
+
+    this->mapping = mapping;
+
+    SharedMemoryHeader* header = static_cast<SharedMemoryHeader*>(mapping);
+
+    if(created)
+    {
+        header = new(mapping) SharedMemoryHeader();
+
+        header->capacity = this->mapping_size - data_offset;
+        header->attachments.store(0);
+        header->head.store(0);
+        header->tail.store(0);
+
+        header->magic.store(
+            Global::shared_memory_magic,
+            std::memory_order_release
+        );
+    }
+    else
+    {
+        // wait for the creator to initialize the header
+
+        for(
+            int i = 0;
+            i < 1000 &&
+            header->magic.load(std::memory_order_acquire) !=
+                Global::shared_memory_magic;
+            ++i
+        )
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if(
+            header->magic.load(std::memory_order_acquire) !=
+                Global::shared_memory_magic
+        )
+        {
+            munmap(this->mapping, this->mapping_size);
+
+            this->mapping = SB_NULLPTR;
+
+            return false;
+        }
+    }
+
+    header->attachments.fetch_add(1);
+
+    this->header = header;
+    this->data = static_cast<char*>(mapping) + data_offset;
+
+    return true;
+#else
+    (void)name_;
+    (void)capacity_;
+
+    return false;
+#endif
+}
+
+void
+SharedMemoryRing::Private::detach
+(
+)
+{
+#if !SB_OS_IS_WIN
+    if(this->header)
+    {
+        // the last ring removes the segment
+
+        if(this->header->attachments.fetch_sub(1) == 1)
+        {
+            shm_unlink(this->name.c_str());
+        }
+
+        munmap(this->mapping, this->mapping_size);
+
+        this->mapping = SB_NULLPTR;
+        this->header = SB_NULLPTR;
+        this->data = SB_NULLPTR;
+    }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+SharedMemorySink::SharedMemorySink
+(
+)
+{
+    this->d_ptr = new Private(this);
+}
+
+SharedMemorySink::~SharedMemorySink
+(
+)
+{
+    delete d_ptr;
+}
+
+std::string
+SharedMemorySink::get_segment
+(
+)
+const
+{
+    return d_ptr->segment;
+}
+
+void
+SharedMemorySink::set_segment
+(
+    const std::string& value_
+)
+{
+    d_ptr->segment = value_;
+
+    d_ptr->ring.reset();
+}
+
+Size
+SharedMemorySink::get_capacity
+(
+)
+const
+{
+    return d_ptr->capacity;
+}
+
+void
+SharedMemorySink::set_capacity
+(
+    const Size& value_
+)
+{
+    d_ptr->capacity = value_;
+}
+
+Size
+SharedMemorySink::get_timeout
+(
+)
+const
+{
+    return d_ptr->timeout;
+}
+
+void
+SharedMemorySink::set_timeout
+(
+    const Size& value_
+)
+{
+    d_ptr->timeout = value_;
+}
+
+Size
+SharedMemorySink::get_dropped_count
+(
+)
+const
+{
+    return d_ptr->dropped_count;
+}
+
+void
+SharedMemorySink::process
+(
+)
+{
+    if(!d_ptr->ring && !d_ptr->segment.empty())
+    {
+        d_ptr->ring.reset(
+            new SharedMemoryRing(d_ptr->segment, d_ptr->capacity)
+        );
+    }
+
+    SharedData input = this->lock_input();
+
+    if(d_ptr->ring && d_ptr->ring->is_attached() && input)
+    {
+        Writer& writer = d_ptr->writer;
+
+        writer.clear();
+
+        writer.write_string(input->get_format().type_names[0]);
+
+        serialize(*input, writer);
+
+        const std::vector<char>& buffer = writer.get_buffer();
+
+        SharedMemoryRing& ring = *d_ptr->ring;
+
+        bool pushed = false;
+
+        // messages larger than the segment are dropped
+
+        if(
+            Global::shared_memory_alignment + align(buffer.size()) <=
+                ring.get_capacity()
+        )
+        {
+            auto deadline =
+                std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(d_ptr->timeout);
+
+            pushed = ring.try_push(buffer.data(), buffer.size());
+
+            // wait for the peer to pop messages, unless it is gone
+
+            while(
+                !pushed &&
+                ring.get_attachment_count() > 1 &&
+                std::chrono::steady_clock::now() < deadline
+            )
+            {
+                std::this_thread::yield();
+
+                pushed = ring.try_push(buffer.data(), buffer.size());
+            }
+        }
+
+        if(!pushed)
+        {
+            ++d_ptr->dropped_count;
+        }
+    }
+}
+
+SharedMemorySink::Private::Private
+(
+    SharedMemorySink* q_ptr_
+):
+    q_ptr           (q_ptr_),
+    capacity        (DEFAULT_SHARED_MEMORY_CAPACITY),
+    timeout         (DEFAULT_SHARED_MEMORY_TIMEOUT),
+    dropped_count   (0)
+{
+}
@@ -0,0 +1,382 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_SHAREDMEMORY_H
+#define SB_SHAREDMEMORY_H
+
+#include <sb-core/sb-abstractfilter.h>
+#include <sb-core/sb-abstractsink.h>
+#include <sb-core/sb-abstractsource.h>
+#include <sb-core/sb-serialization.h>
+
+namespace sb
+{
+
+/// Default capacity of a shared memory segment, in bytes.
+const Size DEFAULT_SHARED_MEMORY_CAPACITY = 1024 * 1024;
+
+/// Default time a SharedMemorySink waits for room in a full segment, in
+/// milliseconds.
+const Size DEFAULT_SHARED_MEMORY_TIMEOUT = 1000;
+
+/// \brief The SharedMemoryRing class is a ring buffer of messages in a named
+/// shared memory segment.
+///
+/// The ring follows a lock-free single-producer single-consumer protocol:
+/// one process pushes messages while another one pops them. The first ring
+/// attached to a name creates the segment with its capacity; the following
+/// ones attach to it. The segment is removed when the last ring detaches.
+///
+/// Messages are aligned in the segment, so that values written aligned by a
+/// Writer can be viewed in place by a Reader of the popped message.
+///
+/// Shared memory segments are only supported on POSIX systems.
+class SB_CORE_API SharedMemoryRing
+{
+
+public:
+
+    class Private;
+
+    /// Attaches to the segment \a name_, creating it with \a capacity_
+    /// bytes if it doesn't exist.
+    SharedMemoryRing
+    (
+        const std::string& name_,
+        Size capacity_ = DEFAULT_SHARED_MEMORY_CAPACITY
+    );
+
+    /// Detaches from the segment.
+    ~SharedMemoryRing
+    (
+    );
+
+    SharedMemoryRing
+    (
+        const SharedMemoryRing& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    SharedMemoryRing&
+    operator=
+    (
+        const SharedMemoryRing& other_
+    )
+    SB_DELETED_FUNCTION;
+
+    /// Returns \b true if the segment was attached; returns \b false
+    /// otherwise.
+    bool
+    is_attached
+    (
+    )
+    const;
+
+    /// Returns the capacity of the segment, in bytes.
+    Size
+    get_capacity
+    (
+    )
+    const;
+
+    /// Returns the number of rings attached to the segment, this one
+    /// included, or 0 if the segment was not attached.
+    ///
+    /// A ring of a process that exited without detaching is still counted.
+    Size
+    get_attachment_count
+    (
+    )
+    const;
+
+    /// Pushes a message holding the \a size_ bytes pointed to by \a data_.
+    ///
+    /// The function returns \b false if the ring is full or if the message
+    /// can't fit in the segment; it returns \b true otherwise.
+    bool
+    try_push
+    (
+        const char* data_,
+        Size size_
+    );
+
+    /// Returns the next message in \a data_ and \a size_, without popping
+    /// it: \a data_ points into the segment and stays valid until pop() is
+    /// called.
+    ///
+    /// The function returns \b false if the ring is empty.
+    bool
+    try_peek
+    (
+        const char*& data_,
+        Size& size_
+    );
+
+    /// Pops the message returned by try_peek().
+    void
+    pop
+    (
+    );
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The SharedMemorySink class sends its input to another process
+/// through a SharedMemoryRing.
+///
+/// Each processed input is serialized, preceded by its type name, into a
+/// message of the segment named by the property "segment". When the ring is
+/// full, the sink waits for the peer to pop messages, for at most the
+/// property "timeout" in milliseconds; the message is dropped after the
+/// timeout, or at once if no other ring is attached to the segment.
+///
+/// \sa SharedMemorySource.
+class SB_CORE_API SharedMemorySink : public AbstractSink
+{
+
+    SB_SELF(sb::SharedMemorySink)
+
+    SB_NAME("sb.SharedMemorySink")
+
+    SB_PROPERTIES({
+        "segment",
+        &SharedMemorySink::get_segment,
+        &SharedMemorySink::set_segment
+    }, {
+        "capacity",
+        &SharedMemorySink::get_capacity,
+        &SharedMemorySink::set_capacity
+    }, {
+        "timeout",
+        &SharedMemorySink::get_timeout,
+        &SharedMemorySink::set_timeout
+    })
+
+    SB_INPUTS_FORMATS(
+        ANY_DATA_FORMAT
+    )
+
+public:
+
+    class Private;
+
+    /// Constructs a sink.
+    SharedMemorySink
+    (
+    );
+
+    /// Destroys this object.
+    virtual
+    ~SharedMemorySink
+    (
+    );
+
+    std::string
+    get_segment
+    (
+    )
+    const;
+
+    /// Sets the name of the segment to \a value_, detaching from the
+    /// previous one.
+    void
+    set_segment
+    (
+        const std::string& value_
+    );
+
+    Size
+    get_capacity
+    (
+    )
+    const;
+
+    /// Sets the capacity used if the sink creates the segment.
+    void
+    set_capacity
+    (
+        const Size& value_
+    );
+
+    Size
+    get_timeout
+    (
+    )
+    const;
+
+    /// Sets the time waited for room in a full segment to \a value_
+    /// milliseconds.
+    void
+    set_timeout
+    (
+        const Size& value_
+    );
+
+    /// Returns the number of messages dropped since the construction of the
+    /// sink, either because they couldn't fit in the segment or because the
+    /// segment stayed full.
+    Size
+    get_dropped_count
+    (
+    )
+    const;
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE;
+
+private:
+
+    /// \cond INTERNAL
+    Private*
+    d_ptr;
+    /// \endcond
+
+};
+
+/// \brief The SharedMemorySource class receives data of type \a T from
+/// another process through a SharedMemoryRing.
+///
+/// Each process pops a message from the segment named by the property
+/// "segment" and deserializes it into the output. The message is read
+/// directly from the segment, without being copied into a buffer first:
+/// the values are copied once, into the output. The output is left
+/// untouched if no message is available, or if the message holds another
+/// type of data.
+///
+/// \sa SharedMemorySink.
+template<typename T>
+class SharedMemorySource : public AbstractSource
+{
+
+    SB_SELF(SharedMemorySource)
+
+    SB_NAME(
+        "sb.SharedMemorySource<" + get_type_name<Data<T>>() + ">"
+    )
+
+    SB_PROPERTIES({
+        "segment",
+        &SharedMemorySource::get_segment,
+        &SharedMemorySource::set_segment
+    })
+
+    SB_OUTPUTS_TYPES(
+        T
+    )
+
+public:
+
+    std::string
+    get_segment
+    (
+    )
+    const
+    {
+        return this->segment;
+    }
+
+    /// Sets the name of the segment to \a value_, detaching from the
+    /// previous one.
+    void
+    set_segment
+    (
+        const std::string& value_
+    )
+    {
+        this->segment = value_;
+
+        this->ring.reset();
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        if(!this->ring && !this->segment.empty())
+        {
+            this->ring.reset(
+                new SharedMemoryRing(this->segment)
+            );
+        }
+
+        const char* data = SB_NULLPTR;
+        Size size = 0;
+
+        if(this->ring && this->ring->try_peek(data, size))
+        {
+            Reader reader(data, size);
+
+            std::string type_name;
+
+            SharedData output = this->get_output();
+
+            if(
+                reader.read_string(type_name) &&
+                type_name == get_type_name<Data<T>>()
+            )
+            {
+                deserialize(*output, reader);
+            }
+
+            this->ring->pop();
+        }
+    }
+
+private:
+
+    std::string
+    segment;
+
+    std::unique_ptr<SharedMemoryRing>
+    ring;
+
+};
+
+/// Registers SharedMemorySource<T> as an instantiable source, along with
+/// Data<T>.
+///
+/// The function returns \b true if there was no previously registered
+/// source for the type \a T; it returns \b false otherwise.
+///
+/// \sa register_data().
+template<typename T>
+bool
+register_shared_memory_source
+(
+)
+{
+    register_data<T>();
+
+    return register_object<SharedMemorySource<T>>();
+}
+
+}
+
+#endif // SB_SHAREDMEMORY_H
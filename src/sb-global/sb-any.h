@@ -90,12 +90,20 @@ public:
     /// Note that \a std::decay_t<ValueType> must be copy-constructible.
     ///
     /// \sa operator=, get_type_info() and any_cast().
-    template<typename T>
+    template<
+        typename T,
+        // T should not be Any, use the copy/move constructors otherwise
+        typename = typename std::enable_if<
+            !std::is_same<Any, typename std::decay<T>::type>::value
+        >::type
+    >
     Any
     (
         T&& value_
     ):
-        content(new Holder<T>(std::forward<T>(value_)))
+        content(
+            new Holder<typename std::decay<T>::type>(std::forward<T>(value_))
+        )
     {
         SB_STATIC_ASSERT(
             std::is_copy_constructible<std::decay<T>::type>::value
@@ -169,7 +177,13 @@ public:
     /// Note that \a std::decay_t<ValueType> must be copy-constructible.
     ///
     /// \sa Any(), get_type_info() and any_cast().
-    template<typename T>
+    template<
+        typename T,
+        // T should not be Any, use the copy/move assignments otherwise
+        typename = typename std::enable_if<
+            !std::is_same<Any, typename std::decay<T>::type>::value
+        >::type
+    >
     Any&
     operator=
     (
@@ -182,7 +196,9 @@ public:
 
         delete this->content;
 
-        this->content = new Holder<T>(std::forward<T>(value_));
+        this->content = new Holder<typename std::decay<T>::type>(
+            std::forward<T>(value_)
+        );
 
         return (*this);
     }
@@ -22,6 +22,7 @@ along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 #include <sb-global/sb-bitmask.h>
 #include <sb-global/sb-compilerdetection.h>
 #include <sb-global/sb-globaldefine.h>
+#include <sb-global/sb-hash.h>
 #include <sb-global/sb-version.h>
 
 #endif // SB_GLOBAL_H
@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_HASH_H
+#define SB_HASH_H
+
+#include <sb-global/sb-globaldefine.h>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace sb
+{
+
+/// Returns the combination of the hash value \a seed_ with the hash value
+/// \a value_.
+///
+/// The combination is not commutative: combining a sequence of hash values
+/// takes their order into account.
+inline
+std::size_t
+hash_combine
+(
+    std::size_t seed_,
+    std::size_t value_
+)
+{
+    return seed_ ^ (value_ + 0x9e3779b9 + (seed_ << 6) + (seed_ >> 2));
+}
+
+/// \cond INTERNAL
+namespace HashTraits
+{
+
+    // types hashable with std::hash
+
+    template<typename T, typename = void>
+    struct HasStandardHash : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct HasStandardHash<
+        T,
+        decltype(
+            void(std::hash<T>()(std::declval<const T&>()))
+        )
+    > : std::true_type
+    {
+    };
+
+    // ranges, i.e. types providing begin() and end()
+
+    template<typename T, typename = void>
+    struct IsRange : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct IsRange<
+        T,
+        decltype(
+            void(std::begin(std::declval<const T&>())),
+            void(std::end(std::declval<const T&>()))
+        )
+    > : std::true_type
+    {
+    };
+
+}
+/// \endcond
+
+/// \brief The Hash template class computes hash values for the type \a T.
+///
+/// Values are hashed with std::hash if it is enabled for \a T; ranges
+/// (e.g. containers) are hashed element by element. The constant
+/// Hash<T>::ENABLED is \b false if \a T is neither hashable nor a range of
+/// hashable elements.
+template<
+    typename T,
+    bool = HashTraits::HasStandardHash<T>::value,
+    bool = HashTraits::IsRange<T>::value
+>
+struct Hash
+{
+
+    static
+    SB_CONSTEXPR_OBJECT
+    bool
+    ENABLED = false;
+
+};
+
+/// \cond INTERNAL
+template<typename T, bool IsRange>
+struct Hash<T, true, IsRange>
+{
+
+    static
+    SB_CONSTEXPR_OBJECT
+    bool
+    ENABLED = true;
+
+    static
+    std::size_t
+    compute
+    (
+        const T& value_
+    )
+    {
+        return std::hash<T>()(value_);
+    }
+
+};
+/// \endcond
+
+/// \cond INTERNAL
+template<typename T>
+struct Hash<T, false, true>
+{
+
+    using Element = typename std::decay<
+        decltype(*std::begin(std::declval<const T&>()))
+    >::type;
+
+    static
+    SB_CONSTEXPR_OBJECT
+    bool
+    ENABLED = Hash<Element>::ENABLED;
+
+    static
+    std::size_t
+    compute
+    (
+        const T& value_
+    )
+    {
+        std::size_t seed = 0;
+
+        for(const auto& element : value_)
+        {
+            seed = hash_combine(
+                seed,
+                Hash<Element>::compute(element)
+            );
+        }
+
+        return seed;
+    }
+
+};
+/// \endcond
+
+}
+
+#endif // SB_HASH_H
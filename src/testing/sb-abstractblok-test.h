@@ -0,0 +1,3315 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_ABSTRACTBLOK_TEST_H
+#define SB_ABSTRACTBLOK_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-core.h>
+
+#include <testing/sb-fixtures.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if SB_OS_IS_LINUX
+#   include <dirent.h>
+#   include <unistd.h>
+#endif
+
+namespace sb
+{
+
+namespace AbstractBlokTest
+{
+
+using Values = std::vector<Size>;
+
+// a source producing the indices of the requested piece
+
+class RangeSource : public AbstractSource
+{
+
+    SB_NAME("RangeSource")
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    virtual
+    void
+    init
+    (
+    )
+    SB_OVERRIDE
+    {
+        this->set_output_extent(0, 10);
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        Piece piece = this->get_requested_piece();
+
+        Size end = std::min<Size>(
+            this->get_output()->get_extent(),
+            piece.size == MAX_SIZE ? MAX_SIZE : piece.offset + piece.size
+        );
+
+        Values values;
+
+        for(Index i = piece.offset; i < end; ++i)
+        {
+            values.push_back(i);
+        }
+
+        this->get_output()->set("value", values);
+    }
+
+};
+
+// a filter doubling its input values
+
+class DoubleFilter : public AbstractFilter
+{
+
+    SB_NAME("DoubleFilter")
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        Values values = this->lock_input()->get<Values>("value");
+
+        for(auto& value : values)
+        {
+            value *= 2;
+        }
+
+        this->get_output()->set("value", values);
+    }
+
+};
+
+// a sink reading its input
+
+class ValuesSink : public AbstractSink
+{
+
+    SB_NAME("ValuesSink")
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+};
+
+// a source with two outputs: "offset" changes both, "factor" changes the
+// second one only
+
+class SplitSource : public AbstractSource
+{
+
+    SB_NAME("SplitSource")
+
+    SB_PROPERTIES({
+        "offset",
+        &SplitSource::get_offset,
+        &SplitSource::set_offset
+    }, {
+        "factor",
+        &SplitSource::get_factor,
+        &SplitSource::set_factor
+    })
+
+    SB_OUTPUTS_TYPES(
+        Values,
+        Values
+    )
+
+public:
+
+    SplitSource
+    (
+    ):
+        execution_count(0),
+        offset(0),
+        factor(1),
+        is_offset_changed(true)
+    {
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        ++this->execution_count;
+
+        Values values = {this->offset, this->offset + 1};
+
+        if(this->is_offset_changed)
+        {
+            this->get_output(0)->set("value", values);
+        }
+
+        for(auto& value : values)
+        {
+            value *= this->factor;
+        }
+
+        this->get_output(1)->set("value", values);
+
+        this->is_offset_changed = false;
+
+        this->push_output(0);
+        this->push_output(1);
+    }
+
+    Size
+    get_offset
+    (
+    )
+    const
+    {
+        return this->offset;
+    }
+
+    void
+    set_offset
+    (
+        const Size& value_
+    )
+    {
+        this->offset = value_;
+        this->is_offset_changed = true;
+
+        this->update();
+    }
+
+    Size
+    get_factor
+    (
+    )
+    const
+    {
+        return this->factor;
+    }
+
+    void
+    set_factor
+    (
+        const Size& value_
+    )
+    {
+        this->factor = value_;
+
+        this->update();
+    }
+
+    Size
+    execution_count;
+
+private:
+
+    Size
+    offset;
+
+    Size
+    factor;
+
+    bool
+    is_offset_changed;
+
+};
+
+// a filter adding "increment" to its input and counting its executions
+
+class CountingFilter : public AbstractFilter
+{
+
+    SB_NAME("CountingFilter")
+
+    SB_PROPERTIES({
+        "increment",
+        &CountingFilter::get_increment,
+        &CountingFilter::set_increment
+    })
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    CountingFilter
+    (
+    ):
+        execution_count(0),
+        increment(0)
+    {
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        ++this->execution_count;
+
+        Values values = this->lock_input()->get<Values>("value");
+
+        for(auto& value : values)
+        {
+            value += this->increment;
+        }
+
+        this->get_output()->set("value", values);
+
+        this->push_output();
+    }
+
+    Size
+    get_increment
+    (
+    )
+    const
+    {
+        return this->increment;
+    }
+
+    void
+    set_increment
+    (
+        const Size& value_
+    )
+    {
+        this->increment = value_;
+
+        this->update();
+    }
+
+    Size
+    execution_count;
+
+private:
+
+    Size
+    increment;
+
+};
+
+// a filter adding its two inputs and counting its executions
+
+class SumFilter : public AbstractFilter
+{
+
+    SB_NAME("SumFilter")
+
+    SB_INPUTS_TYPES(
+        Values,
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    SumFilter
+    (
+    ):
+        execution_count(0)
+    {
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        ++this->execution_count;
+
+        Values values = this->lock_input(0)->get<Values>("value");
+        Values other_values = this->lock_input(1)->get<Values>("value");
+
+        for(Index i = 0; i < values.size() && i < other_values.size(); ++i)
+        {
+            values[i] += other_values[i];
+        }
+
+        this->get_output()->set("value", values);
+
+        this->push_output();
+    }
+
+    Size
+    execution_count;
+
+};
+
+// a filter summing the first value of the items of its batches
+
+class BatchFilter : public AbstractFilter
+{
+
+    SB_NAME("BatchFilter")
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    BatchFilter
+    (
+    ):
+        batch_count(0),
+        sum(0),
+        is_throwing(false)
+    {
+    }
+
+    virtual
+    void
+    process_batch
+    (
+        const DataBatch& items_
+    )
+    SB_OVERRIDE
+    {
+        if(this->is_throwing)
+        {
+            this->is_throwing = false;
+
+            throw std::runtime_error("BatchFilter::process_batch");
+        }
+
+        ++this->batch_count;
+
+        for(const auto& item : items_)
+        {
+            this->sum += item[0]->get<Values>("value")[0];
+        }
+    }
+
+    Size
+    batch_count;
+
+    Size
+    sum;
+
+    // makes the next batch throw
+
+    bool
+    is_throwing;
+
+};
+
+// number of SleepingSource processing at the same time, and its maximum
+
+std::atomic<Size> running_source_count(0);
+std::atomic<Size> max_running_source_count(0);
+
+// a source taking some time to produce {1}
+
+class SleepingSource : public AbstractSource
+{
+
+    SB_NAME("SleepingSource")
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        Size running_count = ++running_source_count;
+
+        Size max_running_count = max_running_source_count;
+
+        while(
+            running_count > max_running_count &&
+            !max_running_source_count.compare_exchange_weak(
+                max_running_count,
+                running_count
+            )
+        )
+        {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        this->get_output()->set("value", Values({1}));
+
+        --running_source_count;
+    }
+
+};
+
+// a filter pulling its three inputs at once and adding their first values
+
+class WideFilter : public AbstractFilter
+{
+
+    SB_NAME("WideFilter")
+
+    SB_INPUTS_TYPES(
+        Values,
+        Values,
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        Size sum = 0;
+
+        for(auto input : this->lock_inputs({0, 1, 2}))
+        {
+            sum += input->get<Values>("value")[0];
+        }
+
+        this->get_output()->set("value", Values({sum}));
+    }
+
+};
+
+// a filter copying its input slowly, unless cancelled
+
+class SlowFilter : public AbstractFilter
+{
+
+    SB_NAME("SlowFilter")
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        for(Index i = 0; i < 50; ++i)
+        {
+            if(this->is_cancellation_requested())
+            {
+                return;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        this->get_output()->set(
+            "value",
+            this->lock_input()->get<Values>("value")
+        );
+    }
+
+};
+
+// GateFilter instances wait for the gate to open
+
+std::atomic<bool> is_gate_open(false);
+std::atomic<Size> gate_started_count(0);
+
+// a filter copying its input once the gate is open
+
+class GateFilter : public AbstractFilter
+{
+
+    SB_NAME("GateFilter")
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        ++gate_started_count;
+
+        while(!is_gate_open)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        this->get_output()->set(
+            "value",
+            this->lock_input()->get<Values>("value")
+        );
+    }
+
+};
+
+// bloks executed by the LoggingFilter instances, in order
+
+std::vector<const AbstractBlok*> execution_log;
+
+// a filter copying its input and logging its executions
+
+class LoggingFilter : public AbstractFilter
+{
+
+    SB_NAME("LoggingFilter")
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+    SB_OUTPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        execution_log.push_back(this);
+
+        this->get_output()->set(
+            "value",
+            this->lock_input()->get<Values>("value")
+        );
+
+        this->push_output();
+    }
+
+};
+
+// a sink counting its executions and recording the first value of its input
+
+class CountingSink : public AbstractSink
+{
+
+    SB_NAME("CountingSink")
+
+    SB_INPUTS_TYPES(
+        Values
+    )
+
+public:
+
+    CountingSink
+    (
+    ):
+        execution_count(0)
+    {
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        ++this->execution_count;
+
+        Values values = this->lock_input()->get<Values>("value");
+
+        if(!values.empty())
+        {
+            this->first_values.push_back(values[0]);
+        }
+    }
+
+    Size
+    execution_count;
+
+    Values
+    first_values;
+
+};
+
+// a data that never updates its version
+
+class CountData : public AbstractData
+{
+
+    SB_SELF(CountData)
+
+    SB_NAME("CountData")
+
+    SB_PROPERTIES({
+        "count",
+        &CountData::get_count,
+        &CountData::set_count
+    })
+
+public:
+
+    CountData
+    (
+    ):
+        count(0)
+    {
+    }
+
+    Size
+    get_count
+    (
+    )
+    const
+    {
+        return this->count;
+    }
+
+    void
+    set_count
+    (
+        const Size& value_
+    )
+    {
+        this->count = value_;
+    }
+
+private:
+
+    Size
+    count;
+
+};
+
+// a source incrementing its CountData on each execution
+
+class CountSource : public AbstractSource
+{
+
+    SB_NAME("CountSource")
+
+    SB_OUTPUTS_TYPES(
+        CountData
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        SharedData output = this->get_output();
+
+        output->set("count", output->get<Size>("count") + 1);
+
+        this->push_output();
+    }
+
+};
+
+// a sink recording the counts it reads
+
+class CountSink : public AbstractSink
+{
+
+    SB_NAME("CountSink")
+
+    SB_INPUTS_TYPES(
+        CountData
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        this->counts.push_back(this->lock_input()->get<Size>("count"));
+    }
+
+    Values
+    counts;
+
+};
+
+class Pipeline : public ::testing::Test
+{
+
+public:
+
+    virtual
+    void
+    SetUp
+    (
+    )
+    SB_OVERRIDE
+    {
+        unregister_all_objects();
+
+        register_data<Values>();
+
+        register_object<RangeSource>();
+        register_object<DoubleFilter>();
+        register_object<ValuesSink>();
+
+        this->source = create_unique_source("RangeSource");
+        this->filter = create_unique_filter("DoubleFilter");
+        this->sink = create_unique_sink("ValuesSink");
+
+        connect(this->source, this->filter);
+        connect(this->filter, this->sink);
+    }
+
+    //virtual
+    //void
+    //TearDown
+    //(
+    //)
+    //SB_OVERRIDE
+    //{
+    //}
+
+    UniqueSource
+    source;
+
+    UniqueFilter
+    filter;
+
+    UniqueSink
+    sink;
+
+};
+
+// a diamond graph: each output of a SplitSource feeds a CountingFilter, both
+// feed a SumFilter, read by a CountingSink
+
+class Diamond : public ::testing::Test
+{
+
+public:
+
+    virtual
+    void
+    SetUp
+    (
+    )
+    SB_OVERRIDE
+    {
+        unregister_all_objects();
+
+        register_data<Values>();
+
+        register_object<SplitSource>();
+        register_object<CountingFilter>();
+        register_object<SumFilter>();
+        register_object<CountingSink>();
+
+        // the bloks keep their default push/pull executive: the pulls of a
+        // visited blok must not execute its upstream bloks again
+
+        this->source = create_unique_source("SplitSource");
+        this->left = create_unique_filter("CountingFilter");
+        this->right = create_unique_filter("CountingFilter");
+        this->sum = create_unique_filter("SumFilter");
+        this->sink = create_unique_sink("CountingSink");
+
+        connect(this->source, 0, this->left, 0);
+        connect(this->source, 1, this->right, 0);
+        connect(this->left, 0, this->sum, 0);
+        connect(this->right, 0, this->sum, 1);
+        connect(this->sum, this->sink);
+    }
+
+    //virtual
+    //void
+    //TearDown
+    //(
+    //)
+    //SB_OVERRIDE
+    //{
+    //}
+
+    Size
+    get_execution_count
+    (
+        const UniqueFilter& filter_
+    )
+    {
+        return static_cast<CountingFilter*>(filter_.get())->execution_count;
+    }
+
+    UniqueSource
+    source;
+
+    UniqueFilter
+    left;
+
+    UniqueFilter
+    right;
+
+    UniqueFilter
+    sum;
+
+    UniqueSink
+    sink;
+
+};
+
+// split_extent
+
+TEST(
+    PieceTest,
+    split_extent
+)
+{
+    PieceSequence pieces = split_extent(10, 4);
+
+    ASSERT_EQ(
+        Size(3),
+        pieces.size()
+    );
+
+    EXPECT_TRUE(pieces[0] == Piece({0, 4}));
+    EXPECT_TRUE(pieces[1] == Piece({4, 4}));
+    EXPECT_TRUE(pieces[2] == Piece({8, 2}));
+
+    pieces = split_extent(UNKNOWN_EXTENT, 4);
+
+    ASSERT_EQ(
+        Size(1),
+        pieces.size()
+    );
+
+    EXPECT_TRUE(pieces[0] == WHOLE_PIECE);
+}
+
+// pull_input
+
+TEST_F(
+    Pipeline,
+    pull_input_by_piece
+)
+{
+    EXPECT_EQ(
+        Size(10),
+        this->sink->get_input_extent()
+    ) << (
+        "The extent of the source was not propagated by the filter"
+    );
+
+    Values gathered_values;
+
+    for(auto piece : split_extent(this->sink->get_input_extent(), 4))
+    {
+        SharedData input = this->sink->lock_input(0, piece);
+
+        Values values = input->get<Values>("value");
+
+        EXPECT_TRUE(
+            input->get_piece() == piece
+        );
+        EXPECT_EQ(
+            piece.size,
+            values.size()
+        ) << (
+            "A data holds more than the requested piece"
+        );
+
+        gathered_values.insert(
+            gathered_values.end(),
+            values.begin(),
+            values.end()
+        );
+    }
+
+    ASSERT_EQ(
+        Size(10),
+        gathered_values.size()
+    );
+
+    for(Index i = 0; i < gathered_values.size(); ++i)
+    {
+        EXPECT_EQ(
+            2 * i,
+            gathered_values[i]
+        );
+    }
+}
+
+// AbstractData::get_sequence
+
+TEST_F(
+    Pipeline,
+    get_sequence
+)
+{
+    SharedData input = this->sink->lock_input(0, WHOLE_PIECE);
+
+    EXPECT_EQ(
+        Size(1),
+        input->get_sequence()
+    ) << (
+        "The sequence number of the source was not propagated by the filter"
+    );
+
+    Timestamp timestamp = input->get_timestamp();
+
+    EXPECT_TRUE(
+        timestamp != UNKNOWN_TIMESTAMP
+    );
+
+    Size sequence = 1;
+
+    for(auto piece : split_extent(this->sink->get_input_extent(), 4))
+    {
+        input = this->sink->lock_input(0, piece);
+
+        EXPECT_EQ(
+            ++sequence,
+            input->get_sequence()
+        ) << (
+            "An execution of the source didn't publish a new item"
+        );
+        EXPECT_TRUE(
+            input->get_timestamp() >= timestamp
+        );
+
+        timestamp = input->get_timestamp();
+    }
+
+    SharedData clone = clone_data(input);
+
+    EXPECT_EQ(
+        input->get_sequence(),
+        clone->get_sequence()
+    );
+    EXPECT_TRUE(
+        input->get_timestamp() == clone->get_timestamp()
+    );
+}
+
+// lock_inputs
+
+TEST_F(
+    NoRegisteredObject,
+    lock_inputs
+)
+{
+    register_data<Values>();
+
+    register_object<SleepingSource>();
+    register_object<WideFilter>();
+    register_object<ValuesSink>();
+
+    std::vector<UniqueSource> sources;
+
+    auto filter = create_unique_filter("WideFilter");
+    auto sink = create_unique_sink("ValuesSink");
+
+    for(Index i = 0; i < 3; ++i)
+    {
+        sources.push_back(create_unique_source("SleepingSource"));
+
+        connect(sources.back(), 0, filter, i);
+    }
+
+    connect(filter, sink);
+
+    max_running_source_count = 0;
+
+    Values values = sink->lock_input()->get<Values>("value");
+
+    ASSERT_EQ(
+        Size(1),
+        values.size()
+    );
+
+    EXPECT_EQ(
+        Size(3),
+        values[0]
+    );
+    EXPECT_LE(
+        Size(2),
+        max_running_source_count
+    ) << (
+        "The inputs were pulled one after the other"
+    );
+}
+
+// set_memoized
+
+TEST_F(
+    Pipeline,
+    set_memoized
+)
+{
+    clear_memo_cache();
+
+    this->source->set_memoized(true);
+    this->filter->set_memoized(true);
+
+    SharedData input = this->sink->lock_input(0, WHOLE_PIECE);
+
+    Size version = input->get_version();
+
+    MemoCacheStatistics statistics = get_memo_cache_statistics();
+
+    EXPECT_EQ(
+        Size(0),
+        statistics.hits
+    );
+    EXPECT_EQ(
+        Size(2),
+        statistics.misses
+    );
+
+    input = this->sink->lock_input(0, WHOLE_PIECE);
+
+    statistics = get_memo_cache_statistics();
+
+    EXPECT_EQ(
+        Size(2),
+        statistics.hits
+    ) << (
+        "A memoized blok was processed again with the same inputs"
+    );
+    EXPECT_EQ(
+        version,
+        input->get_version()
+    ) << (
+        "An output already holding the memoized content was copied"
+    );
+
+    input = this->sink->lock_input(0, Piece({2, 3}));
+
+    statistics = get_memo_cache_statistics();
+
+    EXPECT_EQ(
+        Size(4),
+        statistics.misses
+    ) << (
+        "A different piece was served from the cache"
+    );
+
+    Values values = input->get<Values>("value");
+
+    ASSERT_EQ(
+        Size(3),
+        values.size()
+    );
+
+    EXPECT_EQ(
+        Size(4),
+        values[0]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    set_memoized_push
+)
+{
+    clear_memo_cache();
+
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    source->set_memoized(true);
+
+    connect(source, 0, sink, 0);
+
+    auto split_source = static_cast<SplitSource*>(source.get());
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    source->set("offset", Size(1));
+    source->set("offset", Size(2));
+
+    Size execution_count = split_source->execution_count;
+
+    source->set("offset", Size(1));
+
+    EXPECT_EQ(
+        execution_count,
+        split_source->execution_count
+    ) << (
+        "A memoized source was processed again with the same properties"
+    );
+
+    ASSERT_FALSE(
+        counting_sink->first_values.empty()
+    );
+
+    EXPECT_EQ(
+        Size(1),
+        counting_sink->first_values.back()
+    ) << (
+        "The outputs restored from the memo cache were not pushed"
+    );
+}
+
+#if SB_OS_IS_LINUX
+
+TEST_F(
+    NoRegisteredObject,
+    set_memo_cache_directory
+)
+{
+    char directory[] = "/tmp/sb-memocache-XXXXXX";
+
+    ASSERT_NE(
+        SB_NULLPTR,
+        mkdtemp(directory)
+    );
+
+    clear_memo_cache();
+
+    // every entry is written in the directory as soon as it is inserted
+
+    set_memo_cache_directory(directory);
+    set_memo_cache_byte_budget(0);
+
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("CountingFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.PushExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    filter->set_memoized(true);
+
+    connect(source, 0, filter, 0);
+    connect(filter, sink);
+
+    auto counting_filter = static_cast<CountingFilter*>(filter.get());
+
+    source->set("offset", Size(1));
+    source->set("offset", Size(2));
+
+    Size execution_count = counting_filter->execution_count;
+
+    // the input of the filter holds the same content with a new version
+
+    source->set("offset", Size(1));
+
+    MemoCacheStatistics statistics = get_memo_cache_statistics();
+
+    EXPECT_EQ(
+        execution_count,
+        counting_filter->execution_count
+    );
+    EXPECT_EQ(
+        Size(1),
+        statistics.disk_hits
+    ) << (
+        "An entry was not found in the directory from the content of the "
+        "inputs"
+    );
+
+    // the directory is emptied by a null disk budget
+
+    set_memo_cache_disk_budget(0);
+
+    source->set("offset", Size(2));
+
+    EXPECT_EQ(
+        execution_count + 1,
+        counting_filter->execution_count
+    ) << (
+        "An entry was read from a directory over its disk budget"
+    );
+
+    set_memo_cache_directory("");
+    set_memo_cache_byte_budget(DEFAULT_MEMO_CACHE_BYTE_BUDGET);
+    set_memo_cache_disk_budget(DEFAULT_MEMO_CACHE_DISK_BUDGET);
+
+    clear_memo_cache();
+
+    EXPECT_EQ(
+        0,
+        rmdir(directory)
+    ) << (
+        "Temporary files were left in the directory"
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    set_memo_cache_directory_collision
+)
+{
+    char directory[] = "/tmp/sb-memocache-XXXXXX";
+
+    ASSERT_NE(
+        SB_NULLPTR,
+        mkdtemp(directory)
+    );
+
+    clear_memo_cache();
+
+    set_memo_cache_directory(directory);
+    set_memo_cache_byte_budget(0);
+
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("CountingFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.PushExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    filter->set_memoized(true);
+
+    connect(source, 0, filter, 0);
+    connect(filter, sink);
+
+    auto counting_filter = static_cast<CountingFilter*>(filter.get());
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    source->set("offset", Size(1));
+
+    Size first_value = counting_sink->first_values.back();
+
+    source->set("offset", Size(2));
+
+    // swap the files of the two entries: each file name now stands for the
+    // hash of the other entry, as if their hashes collided
+
+    std::vector<std::string> paths;
+
+    DIR* dir = opendir(directory);
+
+    ASSERT_NE(
+        SB_NULLPTR,
+        dir
+    );
+
+    for(dirent* entry = readdir(dir); entry; entry = readdir(dir))
+    {
+        std::string name = entry->d_name;
+
+        if(name != "." && name != "..")
+        {
+            paths.push_back(std::string(directory) + "/" + name);
+        }
+    }
+
+    closedir(dir);
+
+    ASSERT_EQ(
+        Size(2),
+        paths.size()
+    );
+
+    std::string temporary_path = std::string(directory) + "/swap";
+
+    ASSERT_EQ(
+        0,
+        std::rename(paths[0].c_str(), temporary_path.c_str())
+    );
+    ASSERT_EQ(
+        0,
+        std::rename(paths[1].c_str(), paths[0].c_str())
+    );
+    ASSERT_EQ(
+        0,
+        std::rename(temporary_path.c_str(), paths[1].c_str())
+    );
+
+    Size execution_count = counting_filter->execution_count;
+
+    source->set("offset", Size(1));
+
+    EXPECT_EQ(
+        execution_count + 1,
+        counting_filter->execution_count
+    ) << (
+        "An entry written for another key was read from the directory"
+    );
+    EXPECT_EQ(
+        first_value,
+        counting_sink->first_values.back()
+    );
+
+    set_memo_cache_directory("");
+    set_memo_cache_byte_budget(DEFAULT_MEMO_CACHE_BYTE_BUDGET);
+
+    clear_memo_cache();
+
+    for(const auto& path : paths)
+    {
+        std::remove(path.c_str());
+    }
+
+    EXPECT_EQ(
+        0,
+        rmdir(directory)
+    );
+}
+
+#endif
+
+// push_output
+
+TEST_F(
+    Diamond,
+    push_output
+)
+{
+    SumFilter* sum_filter = static_cast<SumFilter*>(this->sum.get());
+    SplitSource* split_source = static_cast<SplitSource*>(
+        this->source.get()
+    );
+
+    split_source->execution_count = 0;
+
+    this->source->set("offset", Size(1));
+
+    EXPECT_EQ(
+        Size(1),
+        split_source->execution_count
+    ) << (
+        "A blok pulled by its visited followers was executed again"
+    );
+    EXPECT_EQ(
+        Size(1),
+        this->get_execution_count(this->left)
+    );
+    EXPECT_EQ(
+        Size(1),
+        this->get_execution_count(this->right)
+    );
+    EXPECT_EQ(
+        Size(1),
+        sum_filter->execution_count
+    ) << (
+        "A blok reached by two paths was executed once per path"
+    );
+
+    this->source->set("factor", Size(3));
+
+    EXPECT_EQ(
+        Size(2),
+        split_source->execution_count
+    );
+    EXPECT_EQ(
+        Size(1),
+        this->get_execution_count(this->left)
+    ) << (
+        "A blok fed by an unchanged output was executed"
+    );
+    EXPECT_EQ(
+        Size(2),
+        this->get_execution_count(this->right)
+    );
+    EXPECT_EQ(
+        Size(2),
+        sum_filter->execution_count
+    );
+
+    Values values = this->sum->get_output()->get<Values>("value");
+
+    ASSERT_EQ(
+        Size(2),
+        values.size()
+    );
+
+    EXPECT_EQ(
+        Size(1 + 3),
+        values[0]
+    );
+    EXPECT_EQ(
+        Size(2 + 6),
+        values[1]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    push_output_fan_out
+)
+{
+    register_data<Values>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+
+    // bloks keep their default push/pull executive: each follower pulls the
+    // source, which must not execute again
+
+    auto source = create_unique_source("SplitSource");
+    auto first = create_unique_filter("CountingFilter");
+    auto second = create_unique_filter("CountingFilter");
+
+    connect(source, 0, first, 0);
+    connect(source, 0, second, 0);
+
+    auto split_source = static_cast<SplitSource*>(source.get());
+
+    split_source->execution_count = 0;
+
+    source->set("offset", Size(3));
+
+    EXPECT_EQ(
+        Size(1),
+        split_source->execution_count
+    ) << (
+        "A blok pulled by its visited followers was executed again"
+    );
+    EXPECT_EQ(
+        Size(1),
+        static_cast<CountingFilter*>(first.get())->execution_count
+    );
+    EXPECT_EQ(
+        Size(1),
+        static_cast<CountingFilter*>(second.get())->execution_count
+    );
+    EXPECT_EQ(
+        Size(3),
+        second->get_output()->get<Values>("value")[0]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    push_output_through_chain
+)
+{
+    register_data<Values>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+
+    // bloks keep their default push/pull executive: a chained blok must not
+    // pull the input it was just pushed
+
+    auto source = create_unique_source("SplitSource");
+    auto first = create_unique_filter("CountingFilter");
+    auto second = create_unique_filter("CountingFilter");
+
+    connect(source, 0, first, 0);
+    connect(first, second);
+
+    source->set("offset", Size(3));
+
+    EXPECT_EQ(
+        Size(1),
+        static_cast<SplitSource*>(source.get())->execution_count
+    ) << (
+        "A chained blok executed its upstream blok again"
+    );
+    EXPECT_EQ(
+        Size(1),
+        static_cast<CountingFilter*>(first.get())->execution_count
+    );
+    EXPECT_EQ(
+        Size(1),
+        static_cast<CountingFilter*>(second.get())->execution_count
+    );
+
+    Values values = second->get_output()->get<Values>("value");
+
+    ASSERT_EQ(
+        Size(2),
+        values.size()
+    );
+
+    EXPECT_EQ(
+        Size(3),
+        values[0]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    push_output_through_fused_run
+)
+{
+    register_data<Values>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+
+    auto source = create_unique_source("SplitSource");
+
+    std::vector<UniqueFilter> filters;
+
+    for(Index i = 0; i < 3; ++i)
+    {
+        filters.push_back(create_unique_filter("CountingFilter"));
+    }
+
+    connect(source, 0, filters[0], 0);
+    connect(filters[0], filters[1]);
+    connect(filters[1], filters[2]);
+
+    for(Index i = 0; i < 3; ++i)
+    {
+        filters[i]->set("increment", Size(i + 1));
+    }
+
+    auto get_counts = [&]
+    (
+    )
+    {
+        Values counts;
+
+        for(const auto& filter : filters)
+        {
+            counts.push_back(
+                static_cast<CountingFilter*>(filter.get())->execution_count
+            );
+        }
+
+        return counts;
+    };
+
+    // the filters execute as a fused run, each right after its pusher
+
+    Values counts = get_counts();
+
+    source->set("offset", Size(3));
+
+    EXPECT_EQ(
+        Values({counts[0] + 1, counts[1] + 1, counts[2] + 1}),
+        get_counts()
+    ) << (
+        "A filter of a fused run was not executed once"
+    );
+
+    // a modification starts a fused run from the middle of the chain
+
+    counts = get_counts();
+
+    filters[1]->set("increment", Size(4));
+
+    EXPECT_EQ(
+        Values({counts[0], counts[1] + 1, counts[2] + 1}),
+        get_counts()
+    ) << (
+        "A fused run executed the filters before the modified one"
+    );
+
+    Values values = filters[2]->get_output()->get<Values>("value");
+
+    ASSERT_EQ(
+        Size(2),
+        values.size()
+    );
+
+    EXPECT_EQ(
+        Size(11),
+        values[0]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    push_output_from_another_thread
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+
+    register_object<SplitSource>();
+    register_object<GateFilter>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("GateFilter");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.PushExecutive");
+
+    connect(source, 0, filter, 0);
+
+    is_gate_open = false;
+    gate_started_count = 0;
+
+    // the first push executes the bloks in another thread, held by the gate
+
+    std::thread pusher(
+        [&source]()
+        {
+            source->set("offset", Size(1));
+        }
+    );
+
+    while(gate_started_count == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    source->set("offset", Size(7));
+
+    is_gate_open = true;
+
+    pusher.join();
+
+    EXPECT_EQ(
+        Size(2),
+        gate_started_count
+    ) << (
+        "A push made while the blok executed in another thread was lost"
+    );
+
+    Values values = filter->get_output()->get<Values>("value");
+
+    ASSERT_FALSE(
+        values.empty()
+    );
+
+    EXPECT_EQ(
+        Size(7),
+        values[0]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    push_output_unversioned
+)
+{
+    register_object<CountData>();
+
+    register_object<PushExecutive>();
+
+    register_object<CountSource>();
+    register_object<CountSink>();
+
+    auto source = create_unique_source("CountSource");
+    auto sink = create_unique_sink("CountSink");
+
+    source->use_executive("sb.PushExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    connect(source, sink);
+
+    source->update();
+    source->update();
+
+    Values counts = static_cast<CountSink*>(sink.get())->counts;
+
+    ASSERT_EQ(
+        Size(2),
+        counts.size()
+    ) << (
+        "A data that never updates its version was pushed once"
+    );
+
+    EXPECT_EQ(
+        Size(2),
+        counts[1]
+    );
+}
+
+// merge_identical_bloks
+
+TEST_F(
+    NoRegisteredObject,
+    merge_identical_bloks
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto first = create_unique_filter("CountingFilter");
+    auto second = create_unique_filter("CountingFilter");
+    auto first_sink = create_unique_sink("CountingSink");
+    auto second_sink = create_unique_sink("CountingSink");
+
+    for(
+        AbstractBlok* blok : {
+            static_cast<AbstractBlok*>(source.get()),
+            static_cast<AbstractBlok*>(first.get()),
+            static_cast<AbstractBlok*>(second.get()),
+            static_cast<AbstractBlok*>(first_sink.get()),
+            static_cast<AbstractBlok*>(second_sink.get())
+        }
+    )
+    {
+        blok->use_executive("sb.PushExecutive");
+    }
+
+    connect(source, 0, first, 0);
+    connect(source, 0, second, 0);
+    connect(first, first_sink);
+    connect(second, second_sink);
+
+    ASSERT_EQ(
+        Size(1),
+        merge_identical_bloks({first.get(), second.get(), source.get()})
+    );
+
+    EXPECT_FALSE(
+        first->is_merged()
+    );
+    EXPECT_TRUE(
+        second->is_merged()
+    );
+
+    source->set("offset", Size(5));
+
+    auto second_counter = static_cast<CountingFilter*>(second.get());
+
+    EXPECT_EQ(
+        Size(1),
+        static_cast<CountingFilter*>(first.get())->execution_count
+    );
+    EXPECT_EQ(
+        Size(0),
+        second_counter->execution_count
+    ) << (
+        "A merged blok was executed"
+    );
+    EXPECT_EQ(
+        Size(5),
+        second_sink->lock_input()->get<Values>("value")[0]
+    );
+
+    // same value: the bloks stay merged
+
+    second->set("increment", Size(0));
+
+    EXPECT_TRUE(
+        second->is_merged()
+    );
+
+    second->set("increment", Size(1));
+
+    EXPECT_FALSE(
+        second->is_merged()
+    ) << (
+        "Bloks with diverging properties were not split"
+    );
+    EXPECT_EQ(
+        Size(1),
+        second_counter->execution_count
+    );
+    EXPECT_EQ(
+        Size(6),
+        second_sink->lock_input()->get<Values>("value")[0]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    merge_identical_bloks_connect
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto other_source = create_unique_source("SplitSource");
+    auto first = create_unique_filter("CountingFilter");
+    auto second = create_unique_filter("CountingFilter");
+    auto first_sink = create_unique_sink("CountingSink");
+    auto second_sink = create_unique_sink("CountingSink");
+    auto late_sink = create_unique_sink("CountingSink");
+
+    for(
+        AbstractBlok* blok : {
+            static_cast<AbstractBlok*>(source.get()),
+            static_cast<AbstractBlok*>(other_source.get()),
+            static_cast<AbstractBlok*>(first.get()),
+            static_cast<AbstractBlok*>(second.get()),
+            static_cast<AbstractBlok*>(first_sink.get()),
+            static_cast<AbstractBlok*>(second_sink.get()),
+            static_cast<AbstractBlok*>(late_sink.get())
+        }
+    )
+    {
+        blok->use_executive("sb.PushExecutive");
+    }
+
+    connect(source, 0, first, 0);
+    connect(source, 0, second, 0);
+    connect(first, first_sink);
+    connect(second, second_sink);
+
+    ASSERT_EQ(
+        Size(1),
+        merge_identical_bloks({first.get(), second.get()})
+    );
+
+    // a follower connected to the merged blok reads the blok executing for
+    // it
+
+    connect(second, late_sink);
+
+    source->set("offset", Size(5));
+
+    auto late_counter = static_cast<CountingSink*>(late_sink.get());
+
+    ASSERT_FALSE(
+        late_counter->first_values.empty()
+    ) << (
+        "A follower connected to a merged blok was never reached"
+    );
+    EXPECT_EQ(
+        Size(5),
+        late_counter->first_values.back()
+    );
+
+    // the leader reads other data: the bloks aren't identical anymore
+
+    other_source->set("offset", Size(200));
+
+    connect(other_source, 0, first, 0);
+
+    EXPECT_FALSE(
+        second->is_merged()
+    ) << (
+        "Bloks reading different data were not split"
+    );
+
+    other_source->set("offset", Size(201));
+
+    EXPECT_EQ(
+        Size(201),
+        first_sink->lock_input()->get<Values>("value")[0]
+    );
+    EXPECT_EQ(
+        Size(5),
+        second_sink->lock_input()->get<Values>("value")[0]
+    ) << (
+        "The followers of a split blok still read the leader"
+    );
+    EXPECT_EQ(
+        Size(5),
+        late_counter->first_values.back()
+    );
+
+    // the merged blok reads other data
+
+    connect(source, 0, first, 0);
+
+    ASSERT_EQ(
+        Size(1),
+        merge_identical_bloks({first.get(), second.get()})
+    );
+
+    connect(other_source, 0, second, 0);
+
+    EXPECT_FALSE(
+        second->is_merged()
+    );
+    EXPECT_EQ(
+        Size(201),
+        second_sink->lock_input()->get<Values>("value")[0]
+    ) << (
+        "A split blok was not updated with its new input"
+    );
+}
+
+// process_batch
+
+TEST_F(
+    NoRegisteredObject,
+    process_batch
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<BatchingExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<BatchFilter>();
+
+    auto source = create_unique_source("SplitSource");
+    auto batch_filter = create_unique_filter("BatchFilter");
+    auto item_filter = create_unique_filter("CountingFilter");
+
+    source->use_executive("sb.PushExecutive");
+
+    for(
+        AbstractBlok* blok : {
+            static_cast<AbstractBlok*>(batch_filter.get()),
+            static_cast<AbstractBlok*>(item_filter.get())
+        }
+    )
+    {
+        blok->use_executive("sb.BatchingExecutive");
+
+        blok->get_executive()->set("batch_size", Size(3));
+        blok->get_executive()->set("max_delay", Size(60000));
+    }
+
+    connect(source, 0, batch_filter, 0);
+    connect(source, 0, item_filter, 0);
+
+    for(Size offset = 1; offset <= 7; ++offset)
+    {
+        source->set("offset", offset);
+    }
+
+    auto batcher = static_cast<BatchFilter*>(batch_filter.get());
+
+    EXPECT_EQ(
+        Size(2),
+        batcher->batch_count
+    );
+    EXPECT_EQ(
+        Size(1 + 2 + 3 + 4 + 5 + 6),
+        batcher->sum
+    ) << (
+        "The items of a batch don't hold snapshots of the input"
+    );
+
+    static_cast<BatchingExecutive*>(
+        batch_filter->get_executive()
+    )->flush();
+
+    EXPECT_EQ(
+        Size(3),
+        batcher->batch_count
+    );
+    EXPECT_EQ(
+        Size(28),
+        batcher->sum
+    );
+
+    // bloks without a batch implementation process each item
+
+    EXPECT_EQ(
+        Size(6),
+        static_cast<CountingFilter*>(item_filter.get())->execution_count
+    );
+    EXPECT_EQ(
+        Size(6),
+        item_filter->get_output()->get<Values>("value")[0]
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    process_batch_throwing
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<BatchingExecutive>();
+
+    register_object<SplitSource>();
+    register_object<BatchFilter>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("BatchFilter");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.BatchingExecutive");
+
+    filter->get_executive()->set("batch_size", Size(1));
+
+    connect(source, 0, filter, 0);
+
+    auto batcher = static_cast<BatchFilter*>(filter.get());
+
+    batcher->is_throwing = true;
+
+    EXPECT_THROW(
+        source->set("offset", Size(1)),
+        std::runtime_error
+    );
+
+    source->set("offset", Size(2));
+
+    EXPECT_EQ(
+        Size(1),
+        batcher->batch_count
+    ) << (
+        "A blok which threw from process_batch() was not executed again"
+    );
+}
+
+#if SB_OS_IS_LINUX
+
+TEST_F(
+    NoRegisteredObject,
+    process_batch_max_delay
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<BatchingExecutive>();
+
+    register_object<SplitSource>();
+    register_object<BatchFilter>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("BatchFilter");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.BatchingExecutive");
+
+    auto executive = static_cast<BatchingExecutive*>(
+        filter->get_executive()
+    );
+
+    executive->set("batch_size", Size(100));
+    executive->set("max_delay", Size(20));
+
+    EventLoop loop;
+
+    executive->attach(loop);
+
+    connect(source, 0, filter, 0);
+
+    source->set("offset", Size(1));
+    source->set("offset", Size(2));
+
+    auto batcher = static_cast<BatchFilter*>(filter.get());
+
+    EXPECT_EQ(
+        Size(0),
+        batcher->batch_count
+    );
+
+    // no other push comes: the loop processes the pending items
+
+    for(Size i = 0; i < 50 && batcher->batch_count == 0; ++i)
+    {
+        loop.run_once(100);
+    }
+
+    EXPECT_EQ(
+        Size(1),
+        batcher->batch_count
+    ) << (
+        "The pending items were not processed after max_delay"
+    );
+    EXPECT_EQ(
+        Size(0),
+        executive->get_pending_count()
+    );
+
+    executive->detach();
+}
+
+#endif
+
+// ReplicatedExecutive
+
+TEST_F(
+    NoRegisteredObject,
+    replicated_executive
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<ReplicatedExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("CountingFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.ReplicatedExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    auto executive = static_cast<ReplicatedExecutive*>(
+        filter->get_executive()
+    );
+
+    executive->set("replicas", Size(3));
+
+    filter->set("increment", Size(100));
+
+    connect(source, 0, filter, 0);
+    connect(filter, sink);
+
+    Values expected_values;
+
+    for(Size offset = 1; offset <= 20; ++offset)
+    {
+        source->set("offset", offset);
+
+        expected_values.push_back(offset + 100);
+
+        if(offset == 10)
+        {
+            // change the degree of replication while items are dispatched
+
+            executive->set("replicas", Size(2));
+            executive->set("dispatch", std::string("key_hash"));
+        }
+        else if(offset == 15)
+        {
+            executive->set("dispatch_key", std::string("value"));
+        }
+    }
+
+    executive->wait();
+
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    ASSERT_EQ(
+        Size(20),
+        counting_sink->first_values.size()
+    );
+
+    EXPECT_TRUE(
+        std::equal(
+            expected_values.begin(),
+            expected_values.end(),
+            counting_sink->first_values.begin()
+        )
+    ) << (
+        "The results of the copies were not pushed in order"
+    );
+
+    EXPECT_THROW(
+        executive->set("dispatch", std::string("foo")),
+        std::invalid_argument
+    );
+}
+
+#if SB_OS_IS_LINUX
+
+TEST_F(
+    NoRegisteredObject,
+    replicated_executive_attach
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<ReplicatedExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("CountingFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.ReplicatedExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    auto executive = static_cast<ReplicatedExecutive*>(
+        filter->get_executive()
+    );
+
+    executive->set("replicas", Size(2));
+
+    EventLoop loop;
+
+    executive->attach(loop);
+
+    connect(source, 0, filter, 0);
+    connect(filter, sink);
+
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    counting_sink->first_values.clear();
+
+    for(Size offset = 1; offset <= 5; ++offset)
+    {
+        source->set("offset", offset);
+    }
+
+    // nothing pulls nor pushes anymore: the loop pushes the last results
+
+    for(
+        Size i = 0;
+        i < 50 && counting_sink->first_values.size() < 5;
+        ++i
+    )
+    {
+        loop.run_once(100);
+    }
+
+    ASSERT_EQ(
+        Size(5),
+        counting_sink->first_values.size()
+    ) << (
+        "The results of the copies were not pushed from the loop"
+    );
+
+    EXPECT_EQ(
+        Size(5),
+        counting_sink->first_values.back()
+    );
+
+    executive->detach();
+}
+
+#endif
+
+TEST_F(
+    NoRegisteredObject,
+    set_input_policy
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<ReplicatedExecutive>();
+
+    register_object<SplitSource>();
+    register_object<GateFilter>();
+    register_object<CountingSink>();
+
+    // pushes item_count_ items while the copy is held by the gate
+
+    auto push_items = [](
+        const EdgePolicy& policy_,
+        Size item_count_,
+        Values& first_values_,
+        EdgeStatistics& statistics_
+    )
+    {
+        auto source = create_unique_source("SplitSource");
+        auto filter = create_unique_filter("GateFilter");
+        auto sink = create_unique_sink("CountingSink");
+
+        source->use_executive("sb.PushExecutive");
+        filter->use_executive("sb.ReplicatedExecutive");
+        sink->use_executive("sb.PushExecutive");
+
+        auto executive = static_cast<ReplicatedExecutive*>(
+            filter->get_executive()
+        );
+
+        executive->set("replicas", Size(1));
+
+        is_gate_open = false;
+        gate_started_count = 0;
+
+        connect(source, 0, filter, 0, policy_);
+        connect(filter, sink);
+
+        EXPECT_EQ(
+            policy_.capacity,
+            filter->get_input_policy(0).capacity
+        );
+
+        source->set("offset", Size(1));
+
+        // the first item is processed, not queued
+
+        while(gate_started_count == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::thread opener(
+            []()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+                is_gate_open = true;
+            }
+        );
+
+        for(Size offset = 2; offset <= item_count_; ++offset)
+        {
+            source->set("offset", offset);
+        }
+
+        opener.join();
+
+        executive->wait();
+
+        first_values_ = static_cast<CountingSink*>(sink.get())->first_values;
+        statistics_ = filter->get_input_statistics(0);
+    };
+
+    Values first_values;
+    EdgeStatistics statistics;
+
+    push_items(
+        {OverflowPolicy::DROP_NEWEST, 1},
+        5,
+        first_values,
+        statistics
+    );
+
+    EXPECT_EQ(
+        Values({1, 2}),
+        first_values
+    );
+    EXPECT_EQ(
+        Size(5),
+        statistics.pushed_count
+    );
+    EXPECT_EQ(
+        Size(3),
+        statistics.dropped_count
+    );
+
+    push_items(
+        {OverflowPolicy::DROP_OLDEST, 2},
+        6,
+        first_values,
+        statistics
+    );
+
+    EXPECT_EQ(
+        Values({1, 5, 6}),
+        first_values
+    );
+    EXPECT_EQ(
+        Size(3),
+        statistics.dropped_count
+    );
+
+    push_items(
+        {OverflowPolicy::KEEP_LATEST, 2},
+        6,
+        first_values,
+        statistics
+    );
+
+    EXPECT_EQ(
+        Values({1, 6}),
+        first_values
+    );
+    EXPECT_EQ(
+        Size(4),
+        statistics.dropped_count
+    );
+
+    // the pushes wait for the gate instead of dropping items; results
+    // delivered during a single push may reach the sink as one
+
+    push_items(
+        {OverflowPolicy::BLOCK, 1},
+        4,
+        first_values,
+        statistics
+    );
+
+    EXPECT_EQ(
+        Size(4),
+        gate_started_count
+    );
+    EXPECT_EQ(
+        Size(4),
+        first_values.back()
+    );
+    EXPECT_EQ(
+        Size(0),
+        statistics.dropped_count
+    );
+    EXPECT_LE(
+        Size(1),
+        statistics.blocked_count
+    );
+}
+
+// ThreadedExecutive
+
+TEST_F(
+    NoRegisteredObject,
+    threaded_executive
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<ThreadedExecutive>();
+
+    register_object<SplitSource>();
+    register_object<SlowFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("SlowFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.ThreadedExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    connect(source, 0, filter, 0);
+    connect(filter, sink);
+
+    auto executive = static_cast<ThreadedExecutive*>(
+        filter->get_executive()
+    );
+
+    // drag a slider: each value supersedes the previous one
+
+    for(Size offset = 1; offset <= 5; ++offset)
+    {
+        source->set("offset", offset);
+    }
+
+    executive->wait();
+
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    ASSERT_EQ(
+        Size(1),
+        counting_sink->first_values.size()
+    ) << (
+        "The results of superseded items were pushed"
+    );
+
+    EXPECT_EQ(
+        Size(5),
+        counting_sink->first_values[0]
+    );
+    EXPECT_EQ(
+        Size(4),
+        executive->get_cancelled_count()
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    threaded_executive_non_copyable_data
+)
+{
+    register_object<CountData>();
+
+    register_object<PushExecutive>();
+    register_object<ThreadedExecutive>();
+
+    register_object<CountSource>();
+    register_object<CountSink>();
+
+    // CountData doesn't support copy: the copies of the bloks can't be
+    // handed a snapshot of it
+
+    auto source = create_unique_source("CountSource");
+    auto sink = create_unique_sink("CountSink");
+
+    source->use_executive("sb.PushExecutive");
+    sink->use_executive("sb.ThreadedExecutive");
+
+    connect(source, sink);
+
+    EXPECT_THROW(
+        source->update(),
+        std::invalid_argument
+    ) << (
+        "The live input was shared with another thread"
+    );
+
+    // the outputs of the copy can't be restored into the blok
+
+    auto threaded_source = create_unique_source("CountSource");
+
+    threaded_source->use_executive("sb.ThreadedExecutive");
+
+    auto executive = static_cast<ThreadedExecutive*>(
+        threaded_source->get_executive()
+    );
+
+    // the error is raised by the first delivery of the result, which may
+    // happen before wait()
+
+    EXPECT_THROW(
+        {
+            threaded_source->update();
+
+            executive->wait();
+        },
+        std::invalid_argument
+    ) << (
+        "The outputs of the copy were published without their content"
+    );
+}
+
+TEST_F(
+    NoRegisteredObject,
+    set_scheduling_group
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<ThreadedExecutive>();
+
+    register_object<SplitSource>();
+    register_object<SlowFilter>();
+    register_object<CountingSink>();
+
+    EXPECT_LE(
+        Size(1),
+        get_scheduling_thread_count()
+    );
+
+    // groups keep their settings and statistics: each run of the test uses
+    // new ones
+
+    static Size run_count = 0;
+
+    ++run_count;
+
+    std::string weighted_group =
+        "weighted_graph_" + std::to_string(run_count);
+    std::string throttled_group =
+        "throttled_graph_" + std::to_string(run_count);
+
+    EXPECT_EQ(
+        DEFAULT_SCHEDULING_WEIGHT,
+        get_scheduling_weight(weighted_group)
+    );
+
+    set_scheduling_weight(weighted_group, 3);
+
+    EXPECT_EQ(
+        Size(3),
+        get_scheduling_weight(weighted_group)
+    );
+
+    // a millisecond per period: a single item exhausts the quota
+
+    set_scheduling_quota(throttled_group, 1);
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("SlowFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.ThreadedExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    filter->set_scheduling_group(throttled_group);
+
+    EXPECT_EQ(
+        throttled_group,
+        filter->get_scheduling_group()
+    );
+
+    connect(source, 0, filter, 0);
+    connect(filter, sink);
+
+    auto executive = static_cast<ThreadedExecutive*>(
+        filter->get_executive()
+    );
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    source->set("offset", Size(1));
+
+    executive->wait();
+
+    SchedulingStatistics statistics = get_scheduling_statistics(
+        throttled_group
+    );
+
+    EXPECT_LE(
+        Size(1),
+        statistics.task_count
+    );
+    EXPECT_LE(
+        Size(50000),
+        statistics.busy_time
+    );
+    EXPECT_EQ(
+        Size(1),
+        statistics.throttled_count
+    );
+
+    // the threads of the library leave the next item waiting
+
+    source->set("offset", Size(2));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    executive->poll();
+
+    EXPECT_EQ(
+        Size(1),
+        counting_sink->first_values.size()
+    ) << (
+        "A throttled group was served"
+    );
+    EXPECT_EQ(
+        Size(1),
+        get_scheduling_statistics(throttled_group).queued_count
+    );
+
+    // waiting runs it in the calling thread
+
+    executive->wait();
+
+    ASSERT_EQ(
+        Size(2),
+        counting_sink->first_values.size()
+    );
+    EXPECT_EQ(
+        Size(2),
+        counting_sink->first_values[1]
+    );
+    EXPECT_EQ(
+        Size(0),
+        get_scheduling_statistics(throttled_group).queued_count
+    );
+
+    set_scheduling_quota(throttled_group, NO_SCHEDULING_QUOTA);
+}
+
+// JoinExecutive
+
+TEST_F(
+    NoRegisteredObject,
+    join_executive
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<JoinExecutive>();
+
+    register_object<SplitSource>();
+    register_object<SumFilter>();
+    register_object<CountingSink>();
+
+    auto left = create_unique_source("SplitSource");
+    auto right = create_unique_source("SplitSource");
+    auto sum = create_unique_filter("SumFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    left->use_executive("sb.PushExecutive");
+    right->use_executive("sb.PushExecutive");
+    sum->use_executive("sb.JoinExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    connect(left, 0, sum, 0);
+    connect(right, 0, sum, 1);
+    connect(sum, sink);
+
+    auto executive = static_cast<JoinExecutive*>(sum->get_executive());
+    auto sum_filter = static_cast<SumFilter*>(sum.get());
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    sum_filter->execution_count = 0;
+    counting_sink->first_values.clear();
+
+    left->set("offset", Size(1));
+
+    EXPECT_EQ(
+        Size(0),
+        sum_filter->execution_count
+    ) << (
+        "The blok was processed before all its inputs arrived"
+    );
+    EXPECT_EQ(
+        Size(1),
+        executive->get_arrived_count()
+    );
+
+    right->set("offset", Size(10));
+
+    EXPECT_EQ(
+        Size(1),
+        sum_filter->execution_count
+    );
+    EXPECT_EQ(
+        Size(0),
+        executive->get_arrived_count()
+    );
+
+    ASSERT_EQ(
+        Size(1),
+        counting_sink->first_values.size()
+    );
+
+    EXPECT_EQ(
+        Size(11),
+        counting_sink->first_values[0]
+    );
+
+    // an optional input doesn't hold the blok back
+
+    executive->set_input_required(1, false);
+
+    left->set("offset", Size(2));
+
+    EXPECT_EQ(
+        Size(2),
+        sum_filter->execution_count
+    );
+
+    // the timeout releases a partial cycle
+
+    executive->set_input_required(1, true);
+    executive->set("timeout", Size(1));
+
+    left->set("offset", Size(3));
+
+    EXPECT_EQ(
+        Size(2),
+        sum_filter->execution_count
+    );
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    left->set("offset", Size(4));
+
+    EXPECT_EQ(
+        Size(3),
+        sum_filter->execution_count
+    );
+    EXPECT_EQ(
+        Size(14),
+        counting_sink->first_values.back()
+    );
+}
+
+#if SB_OS_IS_LINUX
+
+TEST_F(
+    NoRegisteredObject,
+    join_executive_timeout
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<JoinExecutive>();
+
+    register_object<SplitSource>();
+    register_object<SumFilter>();
+    register_object<CountingSink>();
+
+    auto left = create_unique_source("SplitSource");
+    auto right = create_unique_source("SplitSource");
+    auto sum = create_unique_filter("SumFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    left->use_executive("sb.PushExecutive");
+    right->use_executive("sb.PushExecutive");
+    sum->use_executive("sb.JoinExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    auto executive = static_cast<JoinExecutive*>(sum->get_executive());
+
+    executive->set("timeout", Size(20));
+
+    EventLoop loop;
+
+    executive->attach(loop);
+
+    connect(left, 0, sum, 0);
+    connect(right, 0, sum, 1);
+    connect(sum, sink);
+
+    auto sum_filter = static_cast<SumFilter*>(sum.get());
+    auto counting_sink = static_cast<CountingSink*>(sink.get());
+
+    sum_filter->execution_count = 0;
+    counting_sink->first_values.clear();
+
+    left->set("offset", Size(1));
+
+    EXPECT_EQ(
+        Size(0),
+        sum_filter->execution_count
+    );
+
+    // the right input never arrives: the loop releases the partial cycle
+
+    for(Size i = 0; i < 50 && sum_filter->execution_count == 0; ++i)
+    {
+        loop.run_once(100);
+    }
+
+    EXPECT_EQ(
+        Size(1),
+        sum_filter->execution_count
+    ) << (
+        "The timeout didn't process the blok without another arrival"
+    );
+    EXPECT_EQ(
+        Size(0),
+        executive->get_arrived_count()
+    );
+
+    ASSERT_FALSE(
+        counting_sink->first_values.empty()
+    );
+
+    EXPECT_EQ(
+        Size(1),
+        counting_sink->first_values.back()
+    );
+
+    executive->detach();
+}
+
+#endif
+
+// PrefetchExecutive
+
+TEST_F(
+    Pipeline,
+    prefetch_executive
+)
+{
+    register_object<PrefetchExecutive>();
+
+    this->filter->use_executive("sb.PrefetchExecutive");
+
+    auto executive = static_cast<PrefetchExecutive*>(
+        this->filter->get_executive()
+    );
+
+    Values gathered_values;
+
+    for(auto piece : split_extent(this->sink->get_input_extent(), 2))
+    {
+        Values values = this->sink->lock_input(
+            0,
+            piece
+        )->get<Values>("value");
+
+        gathered_values.insert(
+            gathered_values.end(),
+            values.begin(),
+            values.end()
+        );
+
+        executive->wait();
+    }
+
+    ASSERT_EQ(
+        Size(10),
+        gathered_values.size()
+    );
+
+    for(Index i = 0; i < gathered_values.size(); ++i)
+    {
+        EXPECT_EQ(
+            2 * i,
+            gathered_values[i]
+        );
+    }
+
+    // the first two pulls reveal the access pattern
+
+    EXPECT_EQ(
+        Size(3),
+        executive->get_hit_count()
+    );
+
+    // a pull going back breaks the pattern
+
+    Values values = this->sink->lock_input(
+        0,
+        Piece({2, 2})
+    )->get<Values>("value");
+
+    EXPECT_EQ(
+        Values({4, 6}),
+        values
+    );
+    EXPECT_EQ(
+        Size(3),
+        executive->get_hit_count()
+    );
+}
+
+// AdaptiveExecutive
+
+TEST_F(
+    NoRegisteredObject,
+    adaptive_executive
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+    register_object<PullExecutive>();
+    register_object<AdaptiveExecutive>();
+
+    register_object<SplitSource>();
+    register_object<CountingFilter>();
+    register_object<SlowFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto filter = create_unique_filter("CountingFilter");
+    auto sink = create_unique_sink("CountingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.AdaptiveExecutive");
+    sink->use_executive("sb.PullExecutive");
+
+    auto executive = static_cast<AdaptiveExecutive*>(
+        filter->get_executive()
+    );
+
+    executive->set("window", Size(5));
+    executive->set("hysteresis", Size(2));
+
+    connect(source, 0, filter, 0);
+    connect(filter, sink);
+
+    EXPECT_EQ(
+        "eager",
+        executive->get<std::string>("mode")
+    );
+
+    // the outputs are pulled once every three pushes
+
+    Size offset = 0;
+
+    for(Index i = 0; i < 100; ++i)
+    {
+        for(Index j = 0; j < 3; ++j)
+        {
+            source->set("offset", ++offset);
+        }
+
+        EXPECT_EQ(
+            offset,
+            sink->lock_input()->get<Values>("value")[0]
+        );
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(
+        "lazy",
+        executive->get_mode()
+    );
+
+    // without pushes, the blok is executed as they come again
+
+    for(Index i = 0; i < 100; ++i)
+    {
+        sink->lock_input();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(
+        "eager",
+        executive->get_mode()
+    );
+
+    // a blok slower than its pushes is executed in the background
+
+    auto slow_filter = create_unique_filter("SlowFilter");
+    auto counting_sink = create_unique_sink("CountingSink");
+
+    slow_filter->use_executive("sb.AdaptiveExecutive");
+    counting_sink->use_executive("sb.PushExecutive");
+
+    executive = static_cast<AdaptiveExecutive*>(
+        slow_filter->get_executive()
+    );
+
+    executive->set("window", Size(20));
+    executive->set("hysteresis", Size(1));
+
+    connect(source, 1, slow_filter, 0);
+    connect(slow_filter, counting_sink);
+
+    for(Index i = 0; i < 10; ++i)
+    {
+        source->set("offset", ++offset);
+    }
+
+    EXPECT_NE(
+        "eager",
+        executive->get_mode()
+    );
+    EXPECT_NE(
+        "lazy",
+        executive->get_mode()
+    );
+
+    executive->wait();
+
+    EXPECT_EQ(
+        offset,
+        static_cast<CountingSink*>(
+            counting_sink.get()
+        )->first_values.back()
+    );
+}
+
+// AbstractBlok::set_priority
+
+TEST_F(
+    NoRegisteredObject,
+    set_priority
+)
+{
+    register_data<Values>();
+
+    register_object<PushExecutive>();
+
+    register_object<SplitSource>();
+    register_object<LoggingFilter>();
+    register_object<CountingSink>();
+
+    auto source = create_unique_source("SplitSource");
+    auto archive = create_unique_filter("LoggingFilter");
+    auto display = create_unique_filter("LoggingFilter");
+    auto archive_sink = create_unique_sink("CountingSink");
+    auto display_sink = create_unique_sink("CountingSink");
+
+    for(AbstractBlok* blok : {
+        static_cast<AbstractBlok*>(source.get()),
+        static_cast<AbstractBlok*>(archive.get()),
+        static_cast<AbstractBlok*>(display.get()),
+        static_cast<AbstractBlok*>(archive_sink.get()),
+        static_cast<AbstractBlok*>(display_sink.get())
+    })
+    {
+        blok->use_executive("sb.PushExecutive");
+    }
+
+    connect(source, 0, archive, 0);
+    connect(source, 1, display, 0);
+    connect(archive, archive_sink);
+    connect(display, display_sink);
+
+    // the priority of a sink is carried by the path feeding it
+
+    display_sink->set_priority(10);
+
+    EXPECT_EQ(
+        DEFAULT_PRIORITY,
+        display->get_priority()
+    );
+
+    execution_log.clear();
+
+    source->set("offset", Size(1));
+
+    ASSERT_EQ(
+        Size(2),
+        execution_log.size()
+    );
+
+    EXPECT_EQ(
+        display.get(),
+        execution_log[0]
+    ) << (
+        "The branch of the prioritized sink was not serviced first"
+    );
+
+    display_sink->set_priority(DEFAULT_PRIORITY);
+    archive_sink->set_deadline(5);
+
+    execution_log.clear();
+
+    source->set("offset", Size(2));
+
+    ASSERT_EQ(
+        Size(2),
+        execution_log.size()
+    );
+
+    EXPECT_EQ(
+        archive.get(),
+        execution_log[0]
+    ) << (
+        "The branch with the shortest deadline was not serviced first"
+    );
+}
+
+// AbstractSink::set_active
+
+TEST_F(
+    Diamond,
+    set_active
+)
+{
+    CountingSink* counting_sink = static_cast<CountingSink*>(
+        this->sink.get()
+    );
+
+    this->sink->set_active(false);
+
+    this->source->set("offset", Size(1));
+    this->source->set("factor", Size(2));
+
+    EXPECT_EQ(
+        Size(0),
+        this->get_execution_count(this->left)
+    ) << (
+        "A blok leading to an inactive sink only was executed"
+    );
+    EXPECT_EQ(
+        Size(0),
+        this->get_execution_count(this->right)
+    );
+    EXPECT_EQ(
+        Size(0),
+        counting_sink->execution_count
+    );
+
+    this->sink->set_active(true);
+
+    EXPECT_EQ(
+        Size(1),
+        this->get_execution_count(this->left)
+    ) << (
+        "A stale blok did not catch up once"
+    );
+    EXPECT_EQ(
+        Size(1),
+        this->get_execution_count(this->right)
+    );
+    EXPECT_EQ(
+        Size(1),
+        counting_sink->execution_count
+    );
+
+    Values values = this->sum->get_output()->get<Values>("value");
+
+    ASSERT_EQ(
+        Size(2),
+        values.size()
+    );
+
+    EXPECT_EQ(
+        Size(1 + 2),
+        values[0]
+    );
+}
+
+}
+
+}
+
+#endif // SB_ABSTRACTBLOK_TEST_H
@@ -0,0 +1,187 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_ABSTRACTDATA_TEST_H
+#define SB_ABSTRACTDATA_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-data.h>
+
+#include <testing/sb-fixtures.h>
+
+namespace sb
+{
+
+namespace AbstractDataTest
+{
+
+// enable_data_pool
+
+TEST_F(
+    NoRegisteredObject,
+    enable_data_pool
+)
+{
+    EXPECT_FALSE(
+        enable_data_pool(
+            get_type_name<Data<int>>()
+        )
+    ) << (
+        "Enabled a pool for a non-registered data"
+    );
+
+    ASSERT_TRUE(
+        register_object<Data<int>>()
+    );
+
+    EXPECT_TRUE(
+        enable_data_pool(
+            get_type_name<Data<int>>()
+        )
+    ) << (
+        "Failed to enable a pool for a registered data"
+    );
+
+    EXPECT_FALSE(
+        enable_data_pool(
+            get_type_name<Data<int>>()
+        )
+    ) << (
+        "Enabled a pool twice for the same data"
+    );
+}
+
+// create_shared_data
+
+TEST_F(
+    NoRegisteredObject,
+    create_shared_data_reuses_released_data
+)
+{
+    ASSERT_TRUE(
+        register_data<std::vector<int>>()
+    );
+
+    std::string name = get_type_name<Data<std::vector<int>>>();
+
+    AbstractData* first_instance = SB_NULLPTR;
+
+    {
+        SharedData data = create_shared_data(name);
+
+        ASSERT_NE(
+            SB_NULLPTR,
+            data.get()
+        );
+
+        data->set("value", std::vector<int>(16, 42));
+
+        first_instance = data.get();
+    }
+
+    SharedData data = create_shared_data(name);
+
+    EXPECT_EQ(
+        first_instance,
+        data.get()
+    ) << (
+        "Released data was not handed out again"
+    );
+    EXPECT_TRUE(
+        data->get<std::vector<int>>("value").empty()
+    ) << (
+        "Recycled data was not cleared"
+    );
+
+    DataPoolStatistics statistics = get_data_pool_statistics(name);
+
+    EXPECT_EQ(Size(1), statistics.created);
+    EXPECT_EQ(Size(1), statistics.reused);
+    EXPECT_EQ(Size(1), statistics.recycled);
+    EXPECT_EQ(Size(0), statistics.available);
+}
+
+TEST_F(
+    NoRegisteredObject,
+    create_shared_data_resets_released_value
+)
+{
+    ASSERT_TRUE(
+        register_data<int>()
+    );
+
+    std::string name = get_type_name<Data<int>>();
+
+    AbstractData* first_instance = SB_NULLPTR;
+
+    {
+        SharedData data = create_shared_data(name);
+
+        data->set("value", 42);
+
+        first_instance = data.get();
+    }
+
+    SharedData data = create_shared_data(name);
+
+    ASSERT_EQ(
+        first_instance,
+        data.get()
+    );
+
+    EXPECT_EQ(
+        0,
+        data->get<int>("value")
+    ) << (
+        "Recycled data held the value of its previous user"
+    );
+}
+
+// set_data_pool_high_water_mark
+
+TEST_F(
+    NoRegisteredObject,
+    set_data_pool_high_water_mark
+)
+{
+    ASSERT_TRUE(
+        register_data<int>()
+    );
+
+    std::string name = get_type_name<Data<int>>();
+
+    set_data_pool_high_water_mark(name, 1);
+
+    {
+        SharedData first_data = create_shared_data(name);
+        SharedData second_data = create_shared_data(name);
+    }
+
+    DataPoolStatistics statistics = get_data_pool_statistics(name);
+
+    EXPECT_EQ(Size(2), statistics.created);
+    EXPECT_EQ(Size(1), statistics.recycled);
+    EXPECT_EQ(Size(1), statistics.discarded);
+    EXPECT_EQ(Size(1), statistics.available);
+}
+
+}
+
+}
+
+#endif // SB_ABSTRACTDATA_TEST_H
@@ -75,7 +75,7 @@ TEST_F(
     auto name_sequence = get_registered_object_names();
 
     EXPECT_EQ(
-        0,
+        Size(0),
         name_sequence.size()
     ) << (
         "Found registered names while no objects are registered"
@@ -169,6 +169,120 @@ TYPED_TEST(
     );
 }
 
+// get and set
+
+class Counter : public AbstractObject
+{
+
+    SB_SELF(Counter)
+
+    SB_NAME("Counter")
+
+    SB_PROPERTIES({
+        "count",
+        &Counter::get_count,
+        &Counter::set_count
+    }, {
+        "twice",
+        ObjectProperty::Get<Counter, int>(
+            [](const Counter& counter_)
+            {
+                return counter_.get_count() * 2;
+            }
+        )
+    })
+
+public:
+
+    Counter
+    (
+    ):
+        count(0)
+    {
+    }
+
+    int
+    get_count
+    (
+    )
+    const
+    {
+        return this->count;
+    }
+
+    void
+    set_count
+    (
+        const int& value_
+    )
+    {
+        this->count = value_;
+    }
+
+private:
+
+    int
+    count;
+
+};
+TEST_F(
+    NoRegisteredObject,
+    get_set
+)
+{
+    ASSERT_TRUE(
+        register_object<Counter>()
+    );
+
+    auto first = create_unique<Counter>("Counter");
+    auto second = create_unique<Counter>("Counter");
+
+    first->set("count", 21);
+
+    EXPECT_EQ(
+        21,
+        first->get<int>("count")
+    );
+    EXPECT_EQ(
+        42,
+        first->get<int>("twice")
+    );
+    EXPECT_EQ(
+        0,
+        second->get<int>("count")
+    ) << (
+        "Instances sharing their properties also shared their values"
+    );
+
+    // the statically typed accessors must agree with the dynamic ones
+
+    second->set_many({
+        {"count", Any(5)}
+    });
+
+    EXPECT_EQ(
+        10,
+        second->get<int>("twice")
+    );
+
+    EXPECT_THROW(
+        first->get<std::string>("count"),
+        std::exception
+    );
+    EXPECT_THROW(
+        first->set("count", std::string("foo")),
+        std::exception
+    );
+    EXPECT_THROW(
+        first->set("twice", 0),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        first->get<int>("foo"),
+        std::out_of_range
+    );
+}
+
 // get_object_format
 
 TEST_F(
@@ -15,7 +15,14 @@ GNU Lesser General Public License for more details.
 You should have received a copy of the GNU Lesser General Public License
 along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <testing/sb-abstractblok-test.h>
+#include <testing/sb-abstractdata-test.h>
 #include <testing/sb-abstractobject-test.h>
 #include <testing/sb-coredefine-test.h>
+#include <testing/sb-event-test.h>
+#include <testing/sb-eventloop-test.h>
 #include <testing/sb-objectformat-test.h>
 #include <testing/sb-propertyformat-test.h>
+#include <testing/sb-propertytransaction-test.h>
+#include <testing/sb-serialization-test.h>
+#include <testing/sb-sharedmemory-test.h>
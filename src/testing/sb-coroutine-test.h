@@ -0,0 +1,242 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_COROUTINE_TEST_H
+#define SB_COROUTINE_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-core.h>
+
+#include <testing/sb-fixtures.h>
+
+#include <vector>
+
+#if SB_OS_IS_LINUX
+#   include <unistd.h>
+#endif
+
+namespace sb
+{
+
+namespace CoroutineTest
+{
+
+// the awaitables are only declared to C++20 translation units
+
+#if SB_OS_IS_LINUX && defined(__cpp_impl_coroutine)
+
+// a source waiting for its loop before producing the byte read from fd
+
+class WaitingSource : public AbstractSource
+{
+
+    SB_NAME("WaitingSource")
+
+    SB_OUTPUTS_TYPES(
+        int
+    )
+
+public:
+
+    WaitingSource
+    (
+    ):
+        loop(SB_NULLPTR),
+        fd(-1),
+        step(0)
+    {
+    }
+
+    virtual
+    void
+    process_async
+    (
+        const AsyncCompletion& completion_
+    )
+    SB_OVERRIDE
+    {
+        this->step = 0;
+
+        this->read_input().start(completion_);
+    }
+
+    AsyncTask
+    read_input
+    (
+    )
+    {
+        co_await sleep_for(*this->loop, 0);
+
+        this->step = 1;
+
+        co_await sleep_for(*this->loop, 5);
+
+        this->step = 2;
+
+        co_await wait_readable(*this->loop, this->fd);
+
+        unsigned char byte = 0;
+
+        // assertions return from the function: a coroutine can't use them
+
+        EXPECT_EQ(
+            1,
+            read(this->fd, &byte, 1)
+        );
+
+        this->step = 3;
+
+        co_await resume_on(*this->loop);
+
+        this->step = 4;
+
+        this->get_output()->set("value", int(byte));
+    }
+
+    EventLoop*
+    loop;
+
+    int
+    fd;
+
+    Size
+    step;
+
+};
+
+// a sink recording its inputs
+
+class RecordingSink : public AbstractSink
+{
+
+    SB_NAME("RecordingSink")
+
+    SB_INPUTS_TYPES(
+        int
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        this->values.push_back(this->lock_input()->get<int>("value"));
+    }
+
+    std::vector<int>
+    values;
+
+};
+
+// process_async
+
+TEST_F(
+    NoRegisteredObject,
+    process_async_coroutine
+)
+{
+    register_data<int>();
+
+    register_object<PushExecutive>();
+    register_object<AsyncExecutive>();
+
+    register_object<WaitingSource>();
+    register_object<RecordingSink>();
+
+    int fds[2];
+
+    ASSERT_EQ(
+        0,
+        pipe(fds)
+    );
+
+    EventLoop loop;
+
+    auto source = create_unique_source("WaitingSource");
+    auto sink = create_unique_sink("RecordingSink");
+
+    source->use_executive("sb.AsyncExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    auto waiting_source = static_cast<WaitingSource*>(source.get());
+    auto recording_sink = static_cast<RecordingSink*>(sink.get());
+
+    waiting_source->loop = &loop;
+    waiting_source->fd = fds[0];
+
+    connect(source, sink);
+
+    auto executive = static_cast<AsyncExecutive*>(
+        source->get_executive()
+    );
+
+    recording_sink->values.clear();
+
+    source->update();
+
+    EXPECT_TRUE(
+        executive->is_running()
+    );
+    EXPECT_EQ(
+        Size(1),
+        waiting_source->step
+    ) << (
+        "A zero delay suspended the coroutine"
+    );
+
+    unsigned char byte = 42;
+
+    ASSERT_EQ(
+        1,
+        write(fds[1], &byte, 1)
+    );
+
+    while(executive->is_running())
+    {
+        ASSERT_NE(
+            Size(0),
+            loop.run_once(1000)
+        ) << (
+            "The coroutine didn't complete"
+        );
+    }
+
+    EXPECT_EQ(
+        Size(4),
+        waiting_source->step
+    );
+    EXPECT_EQ(
+        std::vector<int>({42}),
+        recording_sink->values
+    );
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+#endif
+
+}
+
+}
+
+#endif // SB_COROUTINE_TEST_H
@@ -0,0 +1,268 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EVENT_TEST_H
+#define SB_EVENT_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-core.h>
+
+#include <testing/sb-fixtures.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace sb
+{
+
+namespace EventTest
+{
+
+// an object with a single property
+
+class Counter : public AbstractObject
+{
+
+    SB_SELF(Counter)
+
+    SB_NAME("Counter")
+
+    SB_PROPERTIES({
+        "count",
+        &Counter::get_count,
+        &Counter::set_count
+    })
+
+public:
+
+    Counter
+    (
+    ):
+        count(0)
+    {
+    }
+
+    int
+    get_count
+    (
+    )
+    const
+    {
+        return this->count;
+    }
+
+    void
+    set_count
+    (
+        const int& value_
+    )
+    {
+        this->count = value_;
+    }
+
+private:
+
+    int
+    count;
+
+};
+
+// subscribe
+
+TEST_F(
+    NoRegisteredObject,
+    subscribe
+)
+{
+    ASSERT_TRUE(
+        register_object<Counter>()
+    );
+
+    UniqueObject counter = create_unique_object("Counter");
+
+    std::vector<Event> events;
+
+    Index id = counter->subscribe(
+        [&events]
+        (
+            const Event& event_
+        )
+        {
+            events.push_back(event_);
+        }
+    );
+
+    // set from another thread: observers must not be called there
+
+    std::thread producer(
+        [&counter]
+        (
+        )
+        {
+            for(int i = 1; i <= 10; ++i)
+            {
+                counter->set("count", i);
+            }
+        }
+    );
+
+    producer.join();
+
+    EXPECT_TRUE(
+        events.empty()
+    ) << (
+        "An observer was called by the producer thread"
+    );
+
+    EXPECT_EQ(
+        Size(1),
+        dispatch_events()
+    ) << (
+        "Repeated changes of a property were not coalesced"
+    );
+
+    ASSERT_EQ(
+        Size(1),
+        events.size()
+    );
+
+    EXPECT_TRUE(
+        events[0].type == Event::Type::PROPERTY_CHANGED
+    );
+    EXPECT_EQ(
+        counter.get(),
+        events[0].object
+    );
+    EXPECT_EQ(
+        "count",
+        events[0].name
+    );
+
+    EXPECT_TRUE(
+        counter->unsubscribe(id)
+    );
+    EXPECT_FALSE(
+        counter->unsubscribe(id)
+    );
+
+    counter->set("count", 0);
+
+    EXPECT_EQ(
+        Size(0),
+        dispatch_events()
+    ) << (
+        "An event was delivered after unsubscription"
+    );
+}
+
+// dispatch_events
+
+TEST_F(
+    NoRegisteredObject,
+    dispatch_events_concurrently
+)
+{
+    ASSERT_TRUE(
+        register_object<Counter>()
+    );
+
+    const Size counter_count = 64;
+
+    std::vector<UniqueObject> counters;
+    std::vector<std::atomic<Size>> delivered_counts(counter_count);
+
+    for(Index i = 0; i < counter_count; ++i)
+    {
+        counters.push_back(create_unique_object("Counter"));
+
+        std::atomic<Size>& delivered_count = delivered_counts[i];
+
+        delivered_count = 0;
+
+        counters[i]->subscribe(
+            [&delivered_count]
+            (
+                const Event& /*event_*/
+            )
+            {
+                ++delivered_count;
+            }
+        );
+    }
+
+    std::atomic<bool> is_producing(true);
+
+    // two threads dispatch while short-lived threads post events
+
+    std::vector<std::thread> dispatchers;
+
+    for(int i = 0; i < 2; ++i)
+    {
+        dispatchers.emplace_back(
+            [&is_producing]
+            (
+            )
+            {
+                while(is_producing)
+                {
+                    dispatch_events();
+                }
+            }
+        );
+    }
+
+    for(Index i = 0; i < counter_count; ++i)
+    {
+        std::thread producer(
+            [&counters, i]
+            (
+            )
+            {
+                counters[i]->set("count", 1);
+            }
+        );
+
+        producer.join();
+    }
+
+    is_producing = false;
+
+    for(auto& dispatcher : dispatchers)
+    {
+        dispatcher.join();
+    }
+
+    dispatch_events();
+
+    for(Index i = 0; i < counter_count; ++i)
+    {
+        EXPECT_EQ(
+            Size(1),
+            delivered_counts[i].load()
+        ) << (
+            "An event was lost or delivered twice"
+        );
+    }
+}
+
+}
+
+}
+
+#endif // SB_EVENT_TEST_H
@@ -0,0 +1,498 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_EVENTLOOP_TEST_H
+#define SB_EVENTLOOP_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-core.h>
+
+#include <testing/sb-fixtures.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if SB_OS_IS_LINUX
+#   include <unistd.h>
+#endif
+
+namespace sb
+{
+
+namespace EventLoopTest
+{
+
+#if SB_OS_IS_LINUX
+
+// a source counting its executions
+
+class TickSource : public AbstractSource
+{
+
+    SB_NAME("TickSource")
+
+    SB_OUTPUTS_TYPES(
+        int
+    )
+
+public:
+
+    TickSource
+    (
+    ):
+        execution_count(0)
+    {
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        ++this->execution_count;
+
+        this->get_output()->set("value", int(this->execution_count));
+
+        this->push_output();
+    }
+
+    Size
+    execution_count;
+
+};
+
+// a filter copying its input once a timer of its loop ticks
+
+class DelayFilter : public AbstractFilter
+{
+
+    SB_NAME("DelayFilter")
+
+    SB_INPUTS_TYPES(
+        int
+    )
+
+    SB_OUTPUTS_TYPES(
+        int
+    )
+
+public:
+
+    DelayFilter
+    (
+    ):
+        loop(SB_NULLPTR),
+        started_count(0)
+    {
+    }
+
+    virtual
+    void
+    process_async
+    (
+        const AsyncCompletion& completion_
+    )
+    SB_OVERRIDE
+    {
+        ++this->started_count;
+
+        int value = this->lock_input()->get<int>("value");
+
+        EventLoop* loop = this->loop;
+
+        auto id = std::make_shared<Size>(0);
+
+        *id = loop->add_timer(
+            5,
+            [this, loop, id, value, completion_]()
+            {
+                loop->remove(*id);
+
+                this->get_output()->set("value", value);
+
+                completion_(SB_NULLPTR);
+            }
+        );
+    }
+
+    EventLoop*
+    loop;
+
+    Size
+    started_count;
+
+};
+
+// a sink recording its inputs
+
+class RecordingSink : public AbstractSink
+{
+
+    SB_NAME("RecordingSink")
+
+    SB_INPUTS_TYPES(
+        int
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        this->values.push_back(this->lock_input()->get<int>("value"));
+    }
+
+    std::vector<int>
+    values;
+
+};
+
+// EventLoop::add_timer
+
+TEST(
+    EventLoopTest,
+    add_timer
+)
+{
+    EventLoop loop;
+
+    ASSERT_TRUE(
+        loop.is_valid()
+    );
+
+    Size tick_count = 0;
+
+    Size id = loop.add_timer(
+        1,
+        [&tick_count]()
+        {
+            ++tick_count;
+        }
+    );
+
+    ASSERT_NE(
+        Size(0),
+        id
+    );
+
+    while(tick_count < 3)
+    {
+        ASSERT_NE(
+            Size(0),
+            loop.run_once(1000)
+        ) << (
+            "The timer didn't tick"
+        );
+    }
+
+    loop.remove(id);
+
+    EXPECT_EQ(
+        Size(0),
+        loop.run_once(5)
+    ) << (
+        "A removed timer ticked"
+    );
+}
+
+// EventLoop::add_fd
+
+TEST(
+    EventLoopTest,
+    add_fd
+)
+{
+    EventLoop loop;
+
+    int fds[2];
+
+    ASSERT_EQ(
+        0,
+        pipe(fds)
+    );
+
+    std::string received;
+
+    loop.add_fd(
+        fds[0],
+        [&received, &fds]()
+        {
+            char buffer[16];
+
+            ssize_t size = read(fds[0], buffer, sizeof(buffer));
+
+            if(size > 0)
+            {
+                received.append(buffer, size);
+            }
+        }
+    );
+
+    EXPECT_EQ(
+        Size(0),
+        loop.run_once(0)
+    );
+
+    ASSERT_EQ(
+        3,
+        write(fds[1], "abc", 3)
+    );
+
+    EXPECT_EQ(
+        Size(1),
+        loop.run_once(1000)
+    );
+    EXPECT_EQ(
+        "abc",
+        received
+    );
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+// EventLoop::post
+
+TEST(
+    EventLoopTest,
+    post
+)
+{
+    EventLoop loop;
+
+    std::thread::id called_thread;
+
+    std::thread poster(
+        [&loop, &called_thread]()
+        {
+            loop.post(
+                [&called_thread]()
+                {
+                    called_thread = std::this_thread::get_id();
+                }
+            );
+        }
+    );
+
+    poster.join();
+
+    EXPECT_EQ(
+        Size(1),
+        loop.run_once(1000)
+    );
+    EXPECT_EQ(
+        std::this_thread::get_id(),
+        called_thread
+    ) << (
+        "The callback wasn't called from the loop"
+    );
+}
+
+// EventLoop::stop
+
+TEST(
+    EventLoopTest,
+    stop
+)
+{
+    EventLoop loop;
+
+    std::thread stopper(
+        [&loop]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            loop.stop();
+        }
+    );
+
+    // returns only once stopped from the other thread
+
+    loop.run();
+
+    stopper.join();
+}
+
+// EventLoopExecutive
+
+TEST_F(
+    NoRegisteredObject,
+    event_loop_executive
+)
+{
+    register_data<int>();
+
+    register_object<EventLoopExecutive>();
+
+    register_object<TickSource>();
+
+    EventLoop loop;
+
+    auto source = create_unique_source("TickSource");
+
+    source->use_executive("sb.EventLoopExecutive");
+
+    auto executive = static_cast<EventLoopExecutive*>(
+        source->get_executive()
+    );
+
+    executive->set("period", Size(1));
+
+    auto tick_source = static_cast<TickSource*>(source.get());
+
+    Size execution_count = tick_source->execution_count;
+
+    executive->attach(loop);
+
+    while(tick_source->execution_count < execution_count + 3)
+    {
+        ASSERT_NE(
+            Size(0),
+            loop.run_once(1000)
+        ) << (
+            "The source wasn't processed from the loop"
+        );
+    }
+
+    executive->detach();
+
+    EXPECT_EQ(
+        Size(0),
+        loop.run_once(5)
+    );
+}
+
+// AsyncExecutive
+
+TEST_F(
+    NoRegisteredObject,
+    async_executive
+)
+{
+    register_data<int>();
+
+    register_object<PushExecutive>();
+    register_object<AsyncExecutive>();
+
+    register_object<TickSource>();
+    register_object<DelayFilter>();
+    register_object<RecordingSink>();
+
+    EventLoop loop;
+
+    auto source = create_unique_source("TickSource");
+    auto filter = create_unique_filter("DelayFilter");
+    auto sink = create_unique_sink("RecordingSink");
+
+    source->use_executive("sb.PushExecutive");
+    filter->use_executive("sb.AsyncExecutive");
+    sink->use_executive("sb.PushExecutive");
+
+    auto tick_source = static_cast<TickSource*>(source.get());
+    auto delay_filter = static_cast<DelayFilter*>(filter.get());
+    auto recording_sink = static_cast<RecordingSink*>(sink.get());
+
+    delay_filter->loop = &loop;
+
+    connect(source, filter);
+    connect(filter, sink);
+
+    auto executive = static_cast<AsyncExecutive*>(
+        filter->get_executive()
+    );
+
+    source->update();
+
+    int first_value = int(tick_source->execution_count);
+
+    EXPECT_TRUE(
+        executive->is_running()
+    );
+    EXPECT_TRUE(
+        recording_sink->values.empty()
+    ) << (
+        "The push cascade waited for the filter"
+    );
+
+    // pushed while running: merged into a single execution
+
+    source->update();
+    source->update();
+
+    EXPECT_EQ(
+        Size(1),
+        delay_filter->started_count
+    );
+
+    while(executive->is_running())
+    {
+        ASSERT_NE(
+            Size(0),
+            loop.run_once(1000)
+        ) << (
+            "The filter didn't complete"
+        );
+    }
+
+    EXPECT_EQ(
+        Size(2),
+        delay_filter->started_count
+    );
+    EXPECT_EQ(
+        std::vector<int>({first_value, first_value + 2}),
+        recording_sink->values
+    );
+
+    // a synchronous blok completes at once
+
+    auto sync_sink = create_unique_sink("RecordingSink");
+
+    sync_sink->use_executive("sb.AsyncExecutive");
+
+    connect(source, sync_sink);
+
+    source->update();
+
+    EXPECT_FALSE(
+        static_cast<AsyncExecutive*>(sync_sink->get_executive())->is_running()
+    );
+    EXPECT_EQ(
+        int(tick_source->execution_count),
+        static_cast<RecordingSink*>(sync_sink.get())->values.back()
+    );
+
+    while(executive->is_running())
+    {
+        loop.run_once(1000);
+    }
+}
+
+#endif
+
+}
+
+}
+
+#endif // SB_EVENTLOOP_TEST_H
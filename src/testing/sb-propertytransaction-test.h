@@ -0,0 +1,357 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_PROPERTYTRANSACTION_TEST_H
+#define SB_PROPERTYTRANSACTION_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-core.h>
+
+#include <testing/sb-fixtures.h>
+
+namespace sb
+{
+
+namespace PropertyTransactionTest
+{
+
+// a source pushing its value
+
+class ValueSource : public AbstractSource
+{
+
+    SB_NAME("ValueSource")
+
+    SB_PROPERTIES({
+        "value",
+        &ValueSource::get_value,
+        &ValueSource::set_value
+    })
+
+    SB_OUTPUTS_TYPES(
+        int
+    )
+
+public:
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        this->push_output();
+    }
+
+    int
+    get_value
+    (
+    )
+    const
+    {
+        return this->get_output()->get<int>("value");
+    }
+
+    void
+    set_value
+    (
+        const int& value_
+    )
+    {
+        this->get_output()->set("value", value_);
+
+        this->update();
+    }
+
+};
+
+// a filter scaling its input and counting its executions
+
+class ScaleFilter : public AbstractFilter
+{
+
+    SB_NAME("ScaleFilter")
+
+    SB_PROPERTIES({
+        "factor",
+        &ScaleFilter::get_factor,
+        &ScaleFilter::set_factor
+    })
+
+    SB_INPUTS_TYPES(
+        int
+    )
+
+    SB_OUTPUTS_TYPES(
+        int
+    )
+
+public:
+
+    ScaleFilter
+    (
+    ):
+        factor(1),
+        execution_count(0)
+    {
+    }
+
+    virtual
+    void
+    process
+    (
+    )
+    SB_OVERRIDE
+    {
+        ++this->execution_count;
+
+        this->get_output()->set(
+            "value",
+            this->lock_input()->get<int>("value") * this->factor
+        );
+
+        this->push_output();
+    }
+
+    int
+    get_factor
+    (
+    )
+    const
+    {
+        return this->factor;
+    }
+
+    void
+    set_factor
+    (
+        const int& value_
+    )
+    {
+        this->factor = value_;
+
+        this->update();
+    }
+
+    int
+    factor;
+
+    Size
+    execution_count;
+
+};
+
+class TwoBloks : public ::testing::Test
+{
+
+public:
+
+    virtual
+    void
+    SetUp
+    (
+    )
+    SB_OVERRIDE
+    {
+        unregister_all_objects();
+
+        register_data<int>();
+
+        register_object<ValueSource>();
+        register_object<ScaleFilter>();
+
+        this->source = create_unique_source("ValueSource");
+        this->filter = create_unique_filter("ScaleFilter");
+
+        connect(this->source, this->filter);
+
+        this->source->set("value", 1);
+
+        this->scale_filter = static_cast<ScaleFilter*>(this->filter.get());
+        this->scale_filter->execution_count = 0;
+    }
+
+    //virtual
+    //void
+    //TearDown
+    //(
+    //)
+    //SB_OVERRIDE
+    //{
+    //}
+
+    UniqueSource
+    source;
+
+    UniqueFilter
+    filter;
+
+    ScaleFilter*
+    scale_filter;
+
+};
+
+// PropertyTransaction
+
+TEST_F(
+    TwoBloks,
+    without_transaction
+)
+{
+    this->source->set("value", 2);
+    this->filter->set("factor", 3);
+
+    EXPECT_EQ(
+        Size(2),
+        this->scale_filter->execution_count
+    );
+}
+TEST_F(
+    TwoBloks,
+    commit
+)
+{
+    {
+        PropertyTransaction transaction;
+
+        this->source->set("value", 2);
+        this->filter->set("factor", 3);
+
+        {
+            PropertyTransaction nested_transaction;
+
+            this->filter->set("factor", 4);
+        }
+
+        EXPECT_EQ(
+            Size(0),
+            this->scale_filter->execution_count
+        ) << (
+            "A blok was executed before the commit"
+        );
+    }
+
+    EXPECT_FALSE(
+        PropertyTransaction::is_open()
+    );
+    EXPECT_EQ(
+        Size(1),
+        this->scale_filter->execution_count
+    ) << (
+        "A transaction triggered several executions"
+    );
+    EXPECT_EQ(
+        8,
+        this->filter->get_output()->get<int>("value")
+    );
+}
+
+TEST_F(
+    TwoBloks,
+    destroyed_by_exception
+)
+{
+    try
+    {
+        PropertyTransaction transaction;
+
+        this->filter->set("factor", 3);
+
+        throw std::runtime_error("interrupted");
+    }
+    catch(const std::runtime_error&)
+    {
+    }
+
+    EXPECT_FALSE(
+        PropertyTransaction::is_open()
+    );
+    EXPECT_EQ(
+        Size(0),
+        this->scale_filter->execution_count
+    ) << (
+        "A transaction interrupted by an exception updated its bloks"
+    );
+
+    // the discarded bloks are not updated by the next transaction
+
+    {
+        PropertyTransaction transaction;
+    }
+
+    EXPECT_EQ(
+        Size(0),
+        this->scale_filter->execution_count
+    );
+}
+
+// AbstractObject::set_many
+
+TEST_F(
+    TwoBloks,
+    set_many
+)
+{
+    this->filter->set_many({
+        {"factor", Any(5)}
+    });
+
+    EXPECT_EQ(
+        Size(1),
+        this->scale_filter->execution_count
+    );
+    EXPECT_EQ(
+        5,
+        this->filter->get_output()->get<int>("value")
+    );
+
+    // a single invalid value sets none of them
+
+    EXPECT_THROW(
+        this->filter->set_many({
+            {"factor", Any(6)},
+            {"foo", Any(0)}
+        }),
+        std::out_of_range
+    );
+    EXPECT_THROW(
+        this->filter->set_many({
+            {"factor", Any(6)},
+            {"factor", Any(std::string("foo"))}
+        }),
+        std::exception
+    );
+
+    EXPECT_EQ(
+        5,
+        this->filter->get<int>("factor")
+    ) << (
+        "A property was set by a failed set_many()"
+    );
+    EXPECT_EQ(
+        Size(1),
+        this->scale_filter->execution_count
+    );
+}
+
+}
+
+}
+
+#endif // SB_PROPERTYTRANSACTION_TEST_H
@@ -0,0 +1,313 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_SERIALIZATION_TEST_H
+#define SB_SERIALIZATION_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-data.h>
+#include <sb-core/sb-serialization.h>
+
+#include <testing/sb-fixtures.h>
+
+namespace sb
+{
+
+namespace SerializationTest
+{
+
+// an object with properties in every access mode
+
+class Settings : public AbstractObject
+{
+
+    SB_SELF(Settings)
+
+    SB_NAME("Settings")
+
+    SB_PROPERTIES({
+        "count",
+        &Settings::get_count,
+        &Settings::set_count
+    }, {
+        "label",
+        &Settings::get_label,
+        &Settings::set_label
+    }, {
+        "id",
+        &Settings::get_id
+    })
+
+public:
+
+    Settings
+    (
+    ):
+        count(0)
+    {
+    }
+
+    int
+    get_count
+    (
+    )
+    const
+    {
+        return this->count;
+    }
+
+    void
+    set_count
+    (
+        const int& value_
+    )
+    {
+        this->count = value_;
+    }
+
+    std::string
+    get_label
+    (
+    )
+    const
+    {
+        return this->label;
+    }
+
+    void
+    set_label
+    (
+        const std::string& value_
+    )
+    {
+        this->label = value_;
+    }
+
+    int
+    get_id
+    (
+    )
+    const
+    {
+        return 42;
+    }
+
+private:
+
+    int
+    count;
+
+    std::string
+    label;
+
+};
+
+// serialize
+
+TEST_F(
+    NoRegisteredObject,
+    serialize_properties
+)
+{
+    ASSERT_TRUE(
+        register_object<Settings>()
+    );
+
+    UniqueObject settings = create_unique_object("Settings");
+
+    settings->set("count", 7);
+    settings->set("label", std::string("seven"));
+
+    Writer writer;
+
+    EXPECT_TRUE(
+        serialize(*settings, writer)
+    ) << (
+        "Failed to serialize properties of fundamental types"
+    );
+
+    UniqueObject copy = create_unique_object("Settings");
+
+    Reader reader(writer.get_buffer());
+
+    ASSERT_TRUE(
+        deserialize(*copy, reader)
+    );
+
+    EXPECT_EQ(
+        7,
+        copy->get<int>("count")
+    );
+    EXPECT_EQ(
+        "seven",
+        copy->get<std::string>("label")
+    );
+
+    // a truncated buffer must be rejected
+
+    Reader truncated_reader(
+        writer.get_buffer().data(),
+        writer.get_size() - 1
+    );
+
+    EXPECT_FALSE(
+        deserialize(*copy, truncated_reader)
+    ) << (
+        "Deserialized a truncated buffer"
+    );
+}
+TEST_F(
+    NoRegisteredObject,
+    serialize_data
+)
+{
+    using Values = std::vector<double>;
+
+    ASSERT_TRUE(
+        register_data<Values>()
+    );
+
+    SharedData data = create_shared_data(get_type_name<Data<Values>>());
+
+    data->set("value", Values({1.0, 2.0, 3.0}));
+
+    Writer writer;
+
+    ASSERT_TRUE(
+        serialize(*data, writer)
+    );
+
+    SharedData copy = create_shared_data(get_type_name<Data<Values>>());
+
+    Reader reader(writer.get_buffer());
+
+    ASSERT_TRUE(
+        deserialize(*copy, reader)
+    );
+
+    EXPECT_EQ(
+        data->get<Values>("value"),
+        copy->get<Values>("value")
+    );
+
+    // deserializing into another type must fail
+
+    Reader other_reader(writer.get_buffer());
+
+    ASSERT_TRUE(
+        register_data<int>()
+    );
+
+    SharedData other = create_shared_data(get_type_name<Data<int>>());
+
+    EXPECT_FALSE(
+        deserialize(*other, other_reader)
+    ) << (
+        "Deserialized a data of another type"
+    );
+}
+
+// Reader::view
+
+TEST(
+    ReaderTest,
+    view
+)
+{
+    std::vector<double> values = {1.0, 2.0, 3.0};
+
+    Writer writer;
+
+    writer.write_value('x');
+    writer.write(
+        values.data(),
+        values.size() * sizeof(double),
+        alignof(double)
+    );
+
+    Reader reader(writer.get_buffer());
+
+    char value = 0;
+
+    ASSERT_TRUE(
+        reader.read_value(value)
+    );
+
+    const double* view = reader.view<double>(values.size());
+
+    ASSERT_NE(
+        SB_NULLPTR,
+        view
+    );
+
+    EXPECT_EQ(
+        writer.get_buffer().data() + sizeof(double),
+        reinterpret_cast<const char*>(view)
+    ) << (
+        "The values were not viewed in place"
+    );
+    EXPECT_EQ(
+        3.0,
+        view[2]
+    );
+
+    EXPECT_EQ(
+        SB_NULLPTR,
+        reader.view<double>()
+    ) << (
+        "Viewed past the end of the buffer"
+    );
+    EXPECT_FALSE(
+        reader.is_valid()
+    );
+}
+TEST(
+    ReaderTest,
+    view_overflow
+)
+{
+    std::vector<double> values = {1.0, 2.0, 3.0};
+
+    Writer writer;
+
+    writer.write(
+        values.data(),
+        values.size() * sizeof(double),
+        alignof(double)
+    );
+
+    Reader reader(writer.get_buffer());
+
+    // the size of these values wraps around to 2 * sizeof(double)
+
+    EXPECT_EQ(
+        SB_NULLPTR,
+        reader.view<double>(MAX_SIZE / sizeof(double) + 3)
+    ) << (
+        "A count overflowing the size of the values was viewed"
+    );
+    EXPECT_FALSE(
+        reader.is_valid()
+    );
+}
+
+}
+
+}
+
+#endif // SB_SERIALIZATION_TEST_H
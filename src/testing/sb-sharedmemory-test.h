@@ -0,0 +1,217 @@
+/*
+Copyright (C) 2014-2015 Bastien Oudot and Romain Guillemot
+
+This file is part of Softbloks.
+Softbloks is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Softbloks is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with Softbloks.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SB_SHAREDMEMORY_TEST_H
+#define SB_SHAREDMEMORY_TEST_H
+
+#include <gtest/gtest.h>
+
+#include <sb-core/sb-sharedmemory.h>
+
+#include <testing/sb-fixtures.h>
+
+#include <memory>
+
+namespace sb
+{
+
+namespace SharedMemoryTest
+{
+
+// SharedMemoryRing
+
+TEST(
+    SharedMemoryRingTest,
+    push_and_pop
+)
+{
+    SharedMemoryRing producer("sb-test-ring", 64);
+    SharedMemoryRing consumer("sb-test-ring");
+
+    ASSERT_TRUE(
+        producer.is_attached() && consumer.is_attached()
+    ) << (
+        "Failed to attach to a shared memory segment"
+    );
+
+    EXPECT_EQ(
+        Size(64),
+        consumer.get_capacity()
+    );
+
+    const char* data = SB_NULLPTR;
+    Size size = 0;
+
+    EXPECT_FALSE(
+        consumer.try_peek(data, size)
+    );
+
+    // push more messages than the ring can hold at once, so that it wraps
+
+    for(int i = 0; i < 8; ++i)
+    {
+        std::string message(20, 'a' + i);
+
+        ASSERT_TRUE(
+            producer.try_push(message.data(), message.size())
+        );
+
+        ASSERT_TRUE(
+            consumer.try_peek(data, size)
+        );
+
+        EXPECT_EQ(
+            message,
+            std::string(data, size)
+        );
+        EXPECT_EQ(
+            Size(0),
+            reinterpret_cast<std::uintptr_t>(data) % 16
+        ) << (
+            "A message is not aligned"
+        );
+
+        consumer.pop();
+    }
+
+    std::string message(20, 'x');
+
+    EXPECT_TRUE(
+        producer.try_push(message.data(), message.size())
+    );
+    EXPECT_FALSE(
+        producer.try_push(message.data(), message.size())
+    ) << (
+        "Pushed into a full ring"
+    );
+}
+
+// SharedMemorySink and SharedMemorySource
+
+TEST_F(
+    NoRegisteredObject,
+    shared_memory_transport
+)
+{
+    using Values = std::vector<double>;
+
+    ASSERT_TRUE(
+        register_object<SharedMemorySink>()
+    );
+    ASSERT_TRUE(
+        register_shared_memory_source<Values>()
+    );
+
+    UniqueSink sink = create_unique_sink("sb.SharedMemorySink");
+
+    UniqueSource source = create_unique_source(
+        get_type_name<SharedMemorySource<Values>>()
+    );
+
+    ASSERT_TRUE(sink && source);
+
+    sink->set("segment", std::string("sb-test-transport"));
+    source->set("segment", std::string("sb-test-transport"));
+
+    SharedData data = create_shared_data(get_type_name<Data<Values>>());
+
+    data->set("value", Values({1.0, 2.0, 3.0}));
+
+    ASSERT_TRUE(
+        sink->set_input(0, data)
+    );
+
+    sink->process();
+
+    source->process();
+
+    EXPECT_EQ(
+        data->get<Values>("value"),
+        source->get_output()->get<Values>("value")
+    ) << (
+        "The data was not transported"
+    );
+}
+TEST_F(
+    NoRegisteredObject,
+    shared_memory_full
+)
+{
+    using Values = std::vector<double>;
+
+    ASSERT_TRUE(
+        register_object<SharedMemorySink>()
+    );
+
+    register_data<Values>();
+
+    UniqueSink sink = create_unique_sink("sb.SharedMemorySink");
+
+    ASSERT_TRUE(sink);
+
+    // a peer that never pops the messages
+
+    std::unique_ptr<SharedMemoryRing> peer(
+        new SharedMemoryRing("sb-test-full", 512)
+    );
+
+    sink->set("segment", std::string("sb-test-full"));
+    sink->set("timeout", Size(10));
+
+    SharedData data = create_shared_data(get_type_name<Data<Values>>());
+
+    data->set("value", Values(16, 1.0));
+
+    ASSERT_TRUE(
+        sink->set_input(0, data)
+    );
+
+    auto shared_memory_sink = static_cast<SharedMemorySink*>(sink.get());
+
+    for(int i = 0; i < 4; ++i)
+    {
+        sink->process();
+    }
+
+    Size dropped_count = shared_memory_sink->get_dropped_count();
+
+    EXPECT_LT(
+        Size(0),
+        dropped_count
+    ) << (
+        "A message was not dropped after the timeout"
+    );
+
+    // without peer, the sink doesn't wait
+
+    peer.reset();
+
+    sink->set("timeout", Size(60 * 60 * 1000));
+
+    sink->process();
+
+    EXPECT_EQ(
+        dropped_count + 1,
+        shared_memory_sink->get_dropped_count()
+    );
+}
+
+}
+
+}
+
+#endif // SB_SHAREDMEMORY_TEST_H